@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// DHash load distribution with ChordIpv4 load balancing mode
+//
+//       n0    n1   n2   n3                     nx
+//       |     |    |    |  . . . . . . . . . . |
+//       ========================================
+//                          LAN
+//
+// Every node runs --vnodes VirtualNodes placed by ChordIpv4 itself
+// (VirtualNodes attribute). Objects are inserted into DHash once the ring has
+// formed; afterwards the least loaded VirtualNode of every node is re-keyed
+// every --interval seconds. Prints max/mean load ratio per VirtualNode and per
+// node at the end of the simulation, together with ring maintenance messages
+// sent per node. --aggregate=0 sends one heartbeat per VirtualNode instead of
+// one per remote IP:port.
+//
+// Random placement baseline:
+// ./waf --run "chord-load-balance --choices=1 --interval=0"
+// Two choices placement with periodic re-keying:
+// ./waf --run "chord-load-balance --choices=2 --interval=20"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include <openssl/sha.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/chord-ipv4-helper.h"
+#include "ns3/chord-ipv4.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ChordLoadBalance");
+
+static uint32_t g_insertSuccess = 0;
+static uint32_t g_insertFailure = 0;
+
+static void
+InsertSuccess (uint8_t* key, uint8_t numBytes, uint8_t* object, uint32_t objectBytes)
+{
+  g_insertSuccess++;
+}
+
+static void
+InsertFailure (uint8_t* key, uint8_t numBytes, uint8_t* object, uint32_t objectBytes)
+{
+  g_insertFailure++;
+}
+
+static void
+RetrieveSuccess (uint8_t* key, uint8_t numBytes, uint8_t* object, uint32_t objectBytes)
+{
+}
+
+static void
+RetrieveFailure (uint8_t* key, uint8_t numBytes)
+{
+}
+
+static void
+Insert (Ptr<ChordIpv4> chordApplication, std::string resourceName)
+{
+  uint8_t md[SHA_DIGEST_LENGTH];
+  SHA1 ((const uint8_t*) resourceName.c_str (), resourceName.length (), md);
+  chordApplication->Insert (md, SHA_DIGEST_LENGTH, (uint8_t*) resourceName.c_str (), resourceName.length ());
+}
+
+static void
+PrintLoadRatio (std::string name, std::vector<uint32_t> &loads)
+{
+  if (loads.empty ())
+  {
+    return;
+  }
+  uint64_t total = 0;
+  for (std::vector<uint32_t>::iterator iter = loads.begin (); iter != loads.end (); iter++)
+  {
+    total += *iter;
+  }
+  double mean = (double) total / loads.size ();
+  uint32_t max = *std::max_element (loads.begin (), loads.end ());
+  std::cout << name << ": " << loads.size () << " owners, mean load " << mean << ", max load " << max
+            << ", max/mean " << (mean > 0 ? max / mean : 0.0) << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodes = 10;
+  uint32_t vNodes = 2;
+  uint32_t choices = 2;
+  uint32_t objects = 1000;
+  double interval = 20;
+  double simulationTime = 300;
+  bool aggregate = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes", nodes);
+  cmd.AddValue ("vnodes", "VirtualNodes per node", vNodes);
+  cmd.AddValue ("choices", "Identifiers probed per placement (1: random placement)", choices);
+  cmd.AddValue ("objects", "Number of DHash objects inserted", objects);
+  cmd.AddValue ("interval", "Re-keying interval in seconds (0: no re-keying)", interval);
+  cmd.AddValue ("time", "Simulation time in seconds", simulationTime);
+  cmd.AddValue ("aggregate", "Aggregate heartbeats per remote IP:port", aggregate);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodeContainer;
+  nodeContainer.Create (nodes);
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate (5000000)));
+  csma.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (2)));
+  NetDeviceContainer devices = csma.Install (nodeContainer);
+  InternetStackHelper internet;
+  internet.Install (nodeContainer);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  uint16_t port = 2000;
+  std::vector<Ptr<ChordIpv4> > chordApplications;
+  for (uint32_t j = 0; j < nodes; j++)
+  {
+    ChordIpv4Helper server (interfaces.GetAddress (0), port, interfaces.GetAddress (j), port, port+1, port+2);
+    server.SetAttribute ("VirtualNodes", UintegerValue (vNodes));
+    server.SetAttribute ("PlacementChoices", UintegerValue (choices));
+    server.SetAttribute ("LoadBalanceInterval", TimeValue (Seconds (interval)));
+    server.SetAttribute ("AggregateHeartbeats", BooleanValue (aggregate));
+    ApplicationContainer apps = server.Install (nodeContainer.Get (j));
+    //Bootstrap node first, so that it creates the ring
+    apps.Start (Seconds (0.1 * (j + 1)));
+    Ptr<ChordIpv4> chordApplication = apps.Get (0)->GetObject<ChordIpv4> ();
+    chordApplication->SetInsertSuccessCallback (MakeCallback (&InsertSuccess));
+    chordApplication->SetInsertFailureCallback (MakeCallback (&InsertFailure));
+    chordApplication->SetRetrieveSuccessCallback (MakeCallback (&RetrieveSuccess));
+    chordApplication->SetRetrieveFailureCallback (MakeCallback (&RetrieveFailure));
+    chordApplications.push_back (chordApplication);
+  }
+
+  //Objects are inserted from random nodes in the first third of the simulation
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Time insertStart = Seconds (simulationTime / 6);
+  Time insertSpacing = Seconds (simulationTime / 6) / (objects + 1);
+  for (uint32_t i = 0; i < objects; i++)
+  {
+    uint32_t node = random->GetInteger (0, nodes - 1);
+    Simulator::Schedule (insertStart + insertSpacing * (i + 1), &Insert, chordApplications[node], "object" + std::to_string (i));
+  }
+
+  Simulator::Stop (Seconds (simulationTime));
+  Simulator::Run ();
+
+  std::vector<uint32_t> vNodeLoads;
+  std::vector<uint32_t> nodeLoads;
+  uint32_t rekeys = 0;
+  ChordIpv4::MaintenanceStats maintenanceStats = ChordIpv4::MaintenanceStats ();
+  for (uint32_t j = 0; j < nodes; j++)
+  {
+    std::vector<uint32_t> loads;
+    chordApplications[j]->GetVNodeLoads (loads);
+    uint32_t nodeLoad = 0;
+    for (std::vector<uint32_t>::iterator iter = loads.begin (); iter != loads.end (); iter++)
+    {
+      nodeLoad += *iter;
+    }
+    vNodeLoads.insert (vNodeLoads.end (), loads.begin (), loads.end ());
+    nodeLoads.push_back (nodeLoad);
+    rekeys += chordApplications[j]->GetRekeyCount ();
+    ChordIpv4::MaintenanceStats &stats = chordApplications[j]->GetMaintenanceStats ();
+    maintenanceStats.heartbeatMessages += stats.heartbeatMessages;
+    maintenanceStats.aggregatedHeartbeats += stats.aggregatedHeartbeats;
+    maintenanceStats.stabilizeMessages += stats.stabilizeMessages;
+    maintenanceStats.fingerMessages += stats.fingerMessages;
+  }
+  std::cout << "Inserts: " << g_insertSuccess << " succeeded, " << g_insertFailure << " failed, re-keyed VirtualNodes: " << rekeys << "\n";
+  PrintLoadRatio ("VirtualNodes", vNodeLoads);
+  PrintLoadRatio ("Nodes", nodeLoads);
+  std::cout << "Maintenance messages per node: heartbeat " << (double) maintenanceStats.heartbeatMessages / nodes
+            << " (VirtualNode heartbeats aggregated: " << (double) maintenanceStats.aggregatedHeartbeats / nodes << ")"
+            << ", stabilize " << (double) maintenanceStats.stabilizeMessages / nodes
+            << ", finger " << (double) maintenanceStats.fingerMessages / nodes << "\n";
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,437 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Parameter sweep over Chord settings on the chord-run LAN topology
+//
+//       n0    n1   n2   n3                     nx
+//       |     |    |    |  . . . . . . . . . . |
+//       ========================================
+//                          LAN
+//
+// The topology is built once by the parent process. Every parameter point
+// (stabilize interval x successor list size x heartbeat interval x run) is
+// executed in a forked child which inherits the topology, installs ChordIpv4
+// with the point's attributes, runs its own copy of the simulator and reports
+// one CSV row back through a pipe. At most --jobs children run at a time.
+//
+// Each child selects the point's RngRun and re-assigns the random streams of
+// the inherited topology, so that they are drawn from that run as well.
+//
+// With --trace=<prefix> every point also writes a binary ChordTraceWriter trace
+// to <prefix>-<point>.bin, which can be summarized with chord-trace-analyze.
+//
+// ./waf --run "chord-sweep --stabilize=1000,2000 --successors=2,4,8 --jobs=4 --output=sweep.csv"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <openssl/sha.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/chord-ipv4-helper.h"
+#include "ns3/chord-ipv4.h"
+#include "ns3/chord-transport.h"
+#include "ns3/chord-trace-writer.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ChordSweep");
+
+struct SweepPoint
+{
+  uint32_t stabilizeInterval;
+  uint32_t successorListSize;
+  uint32_t heartbeatInterval;
+  uint32_t run;
+};
+
+class ChordSweepRun
+{
+  public:
+    ChordSweepRun (NodeContainer nodeContainer, NetDeviceContainer devices, Ipv4InterfaceContainer interfaces, uint16_t bootStrapNodeNum);
+
+    std::string Run (SweepPoint point, uint32_t lookups, Time simulationTime, std::string traceFile);
+
+    static std::string GetCsvHeader ();
+
+  private:
+    void InsertVNode (Ptr<ChordIpv4> chordApplication, std::string vNodeName);
+    void Lookup (Ptr<ChordIpv4> chordApplication, std::string resourceName);
+    void LookupSuccess (uint8_t* lookupKey, uint8_t lookupKeyBytes, Ipv4Address ipAddress, uint16_t port);
+    void LookupFailure (uint8_t* lookupKey, uint8_t lookupKeyBytes);
+
+    NodeContainer m_nodeContainer;
+    NetDeviceContainer m_devices;
+    Ipv4InterfaceContainer m_interfaces;
+    uint16_t m_bootStrapNodeNum;
+
+    std::multimap<std::string, Time> m_pendingLookups;
+    uint32_t m_lookupSuccess;
+    uint32_t m_lookupFailure;
+    Time m_totalLookupLatency;
+};
+
+ChordSweepRun::ChordSweepRun (NodeContainer nodeContainer, NetDeviceContainer devices, Ipv4InterfaceContainer interfaces, uint16_t bootStrapNodeNum)
+  : m_nodeContainer (nodeContainer),
+    m_devices (devices),
+    m_interfaces (interfaces),
+    m_bootStrapNodeNum (bootStrapNodeNum),
+    m_lookupSuccess (0),
+    m_lookupFailure (0)
+{
+}
+
+std::string
+ChordSweepRun::GetCsvHeader ()
+{
+  return "StabilizeInterval,SuccessorListSize,HeartbeatInterval,Run,Lookups,LookupSuccess,LookupFailure,"
+         "MeanLookupLatencyMs,TxMessages,TxBytes,WallClockSeconds";
+}
+
+void
+ChordSweepRun::InsertVNode (Ptr<ChordIpv4> chordApplication, std::string vNodeName)
+{
+  uint8_t md[SHA_DIGEST_LENGTH];
+  SHA1 ((const uint8_t*) vNodeName.c_str (), vNodeName.length (), md);
+  chordApplication->InsertVNode (vNodeName, md, SHA_DIGEST_LENGTH);
+}
+
+void
+ChordSweepRun::Lookup (Ptr<ChordIpv4> chordApplication, std::string resourceName)
+{
+  uint8_t md[SHA_DIGEST_LENGTH];
+  SHA1 ((const uint8_t*) resourceName.c_str (), resourceName.length (), md);
+  m_pendingLookups.insert (std::make_pair (std::string ((char*) md, SHA_DIGEST_LENGTH), Simulator::Now ()));
+  chordApplication->LookupKey (md, SHA_DIGEST_LENGTH);
+}
+
+void
+ChordSweepRun::LookupSuccess (uint8_t* lookupKey, uint8_t lookupKeyBytes, Ipv4Address ipAddress, uint16_t port)
+{
+  std::multimap<std::string, Time>::iterator iterator = m_pendingLookups.find (std::string ((char*) lookupKey, lookupKeyBytes));
+  if (iterator == m_pendingLookups.end ())
+  {
+    return;
+  }
+  m_lookupSuccess++;
+  m_totalLookupLatency += Simulator::Now () - iterator->second;
+  m_pendingLookups.erase (iterator);
+}
+
+void
+ChordSweepRun::LookupFailure (uint8_t* lookupKey, uint8_t lookupKeyBytes)
+{
+  std::multimap<std::string, Time>::iterator iterator = m_pendingLookups.find (std::string ((char*) lookupKey, lookupKeyBytes));
+  if (iterator == m_pendingLookups.end ())
+  {
+    return;
+  }
+  m_lookupFailure++;
+  m_pendingLookups.erase (iterator);
+}
+
+std::string
+ChordSweepRun::Run (SweepPoint point, uint32_t lookups, Time simulationTime, std::string traceFile)
+{
+  struct timeval start, end;
+  gettimeofday (&start, 0);
+
+  //Streams of the inherited topology were created with the parent's run; assigning
+  //stream numbers re-creates them with the run selected here
+  RngSeedManager::SetRun (point.run);
+  int64_t stream = 0;
+  stream += InternetStackHelper ().AssignStreams (m_nodeContainer, stream);
+  stream += CsmaHelper ().AssignStreams (m_devices, stream);
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+
+  uint16_t port = 2000;
+  uint32_t nodes = m_nodeContainer.GetN ();
+  std::vector<Ptr<ChordIpv4> > chordApplications;
+  Ptr<ChordTraceWriter> traceWriter;
+  if (!traceFile.empty ())
+  {
+    traceWriter = CreateObject<ChordTraceWriter> ();
+    traceWriter->Open (traceFile);
+  }
+  for (uint32_t j = 0; j < nodes; j++)
+  {
+    ChordIpv4Helper server (m_interfaces.GetAddress (m_bootStrapNodeNum), port, m_interfaces.GetAddress (j), port, port+1, port+2);
+    server.SetAttribute ("StabilizeInterval", TimeValue (MilliSeconds (point.stabilizeInterval)));
+    server.SetAttribute ("HeartbeatInterval", TimeValue (MilliSeconds (point.heartbeatInterval)));
+    server.SetAttribute ("MaxVNodeSuccessorListSize", UintegerValue (point.successorListSize));
+    ApplicationContainer apps = server.Install (m_nodeContainer.Get (j));
+    apps.Start (Seconds (0.0));
+    Ptr<ChordIpv4> chordApplication = apps.Get (0)->GetObject<ChordIpv4> ();
+    chordApplication->SetLookupSuccessCallback (MakeCallback (&ChordSweepRun::LookupSuccess, this));
+    chordApplication->SetLookupFailureCallback (MakeCallback (&ChordSweepRun::LookupFailure, this));
+    chordApplications.push_back (chordApplication);
+    if (traceWriter != 0)
+    {
+      traceWriter->Connect (chordApplication);
+    }
+  }
+
+  //Bootstrap node first, then one join every 100 ms
+  Simulator::Schedule (MilliSeconds (100), &ChordSweepRun::InsertVNode, this, chordApplications[m_bootStrapNodeNum], "node" + std::to_string (m_bootStrapNodeNum));
+  Time time = MilliSeconds (100);
+  for (uint32_t j = 0; j < nodes; j++)
+  {
+    if (j == m_bootStrapNodeNum)
+    {
+      continue;
+    }
+    time += MilliSeconds (100);
+    Simulator::Schedule (time, &ChordSweepRun::InsertVNode, this, chordApplications[j], "node" + std::to_string (j));
+  }
+
+  //Lookups are spread over the second half of the simulation
+  Time lookupStart = std::max (time, simulationTime / 2);
+  Time lookupSpacing = (simulationTime - lookupStart) / (lookups + 1);
+  for (uint32_t i = 0; i < lookups; i++)
+  {
+    uint32_t node = random->GetInteger (0, nodes - 1);
+    Simulator::Schedule (lookupStart + lookupSpacing * (i + 1), &ChordSweepRun::Lookup, this, chordApplications[node], "resource" + std::to_string (i));
+  }
+
+  Simulator::Stop (simulationTime);
+  Simulator::Run ();
+
+  uint64_t txMessages = 0;
+  uint64_t txBytes = 0;
+  for (uint32_t j = 0; j < nodes; j++)
+  {
+    ChordTransport::TransportStats& stats = chordApplications[j]->GetTransport ()->GetStats ();
+    txMessages += stats.txMessages;
+    txBytes += stats.txBytes;
+  }
+  if (traceWriter != 0)
+  {
+    traceWriter->Close ();
+  }
+  Simulator::Destroy ();
+
+  gettimeofday (&end, 0);
+
+  std::ostringstream os;
+  os << point.stabilizeInterval << "," << point.successorListSize << "," << point.heartbeatInterval << "," << point.run
+     << "," << lookups << "," << m_lookupSuccess << "," << m_lookupFailure
+     << "," << (m_lookupSuccess > 0 ? m_totalLookupLatency.ToDouble (Time::MS) / m_lookupSuccess : 0.0)
+     << "," << txMessages << "," << txBytes
+     << "," << (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+  return os.str ();
+}
+
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream sin (list);
+  std::string token;
+  while (std::getline (sin, token, ','))
+  {
+    if (token.size () > 0)
+    {
+      values.push_back (atoi (token.c_str ()));
+    }
+  }
+  return values;
+}
+
+struct Worker
+{
+  pid_t pid;
+  int fd;
+  uint32_t index;
+};
+
+static std::string
+ReadAll (int fd)
+{
+  std::string result;
+  char buffer[512];
+  ssize_t bytes;
+  while ((bytes = read (fd, buffer, sizeof (buffer))) > 0)
+  {
+    result.append (buffer, bytes);
+  }
+  close (fd);
+  while (result.size () > 0 && result[result.size () - 1] == '\n')
+  {
+    result.erase (result.size () - 1);
+  }
+  return result;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodes = 20;
+  uint32_t bootStrapNodeNum = 0;
+  uint32_t lookups = 100;
+  uint32_t runs = 1;
+  double simulationTime = 60.0;
+  uint32_t jobs = sysconf (_SC_NPROCESSORS_ONLN);
+  std::string stabilizeIntervals = "1000,2000,5000";
+  std::string successorListSizes = "2,4,8";
+  std::string heartbeatIntervals = "1000";
+  std::string output = "chord-sweep.csv";
+  std::string trace = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes on the LAN", nodes);
+  cmd.AddValue ("bootStrapNode", "Index of bootstrap node", bootStrapNodeNum);
+  cmd.AddValue ("lookups", "Number of lookups per run", lookups);
+  cmd.AddValue ("runs", "Number of runs (RngRun values) per parameter point", runs);
+  cmd.AddValue ("time", "Simulation time in seconds", simulationTime);
+  cmd.AddValue ("jobs", "Number of parallel worker processes", jobs);
+  cmd.AddValue ("stabilize", "Comma separated stabilize intervals in milli seconds", stabilizeIntervals);
+  cmd.AddValue ("successors", "Comma separated successor list sizes", successorListSizes);
+  cmd.AddValue ("heartbeat", "Comma separated heartbeat intervals in milli seconds", heartbeatIntervals);
+  cmd.AddValue ("output", "CSV output file", output);
+  cmd.AddValue ("trace", "Prefix of binary trace files (one per point), empty to disable", trace);
+  cmd.Parse (argc, argv);
+
+  if (jobs == 0)
+  {
+    jobs = 1;
+  }
+  if (bootStrapNodeNum >= nodes)
+  {
+    std::cerr << "Bootstrap node number must be smaller than number of nodes\n";
+    return 1;
+  }
+
+  std::vector<SweepPoint> points;
+  std::vector<uint32_t> stabilize = ParseList (stabilizeIntervals);
+  std::vector<uint32_t> successors = ParseList (successorListSizes);
+  std::vector<uint32_t> heartbeat = ParseList (heartbeatIntervals);
+  for (uint32_t s = 0; s < stabilize.size (); s++)
+    for (uint32_t l = 0; l < successors.size (); l++)
+      for (uint32_t h = 0; h < heartbeat.size (); h++)
+        for (uint32_t r = 1; r <= runs; r++)
+        {
+          SweepPoint point = {stabilize[s], successors[l], heartbeat[h], r};
+          points.push_back (point);
+        }
+
+  //Topology is created once and shared (copy-on-write) by all workers
+  NodeContainer nodeContainer;
+  nodeContainer.Create (nodes);
+
+  InternetStackHelper internet;
+  internet.Install (nodeContainer);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("100Mbps"));
+  csma.SetChannelAttribute ("Delay", TimeValue (NanoSeconds (6560)));
+  csma.SetDeviceAttribute ("Mtu", UintegerValue (1400));
+  NetDeviceContainer d = csma.Install (nodeContainer);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (d);
+
+  NS_LOG_INFO ("Running " << points.size () << " parameter points on " << jobs << " workers");
+
+  std::vector<std::string> results (points.size ());
+  std::vector<Worker> workers;
+  uint32_t next = 0;
+  uint32_t failed = 0;
+  while (next < points.size () || workers.size () > 0)
+  {
+    while (next < points.size () && workers.size () < jobs)
+    {
+      int fds[2];
+      if (pipe (fds) != 0)
+      {
+        perror ("pipe");
+        return 1;
+      }
+      std::cout.flush ();
+      pid_t pid = fork ();
+      if (pid < 0)
+      {
+        perror ("fork");
+        return 1;
+      }
+      if (pid == 0)
+      {
+        close (fds[0]);
+        ChordSweepRun run (nodeContainer, d, interfaces, bootStrapNodeNum);
+        std::string traceFile = trace.empty () ? "" : trace + "-" + std::to_string (next) + ".bin";
+        std::string row = run.Run (points[next], lookups, Seconds (simulationTime), traceFile) + "\n";
+        if (write (fds[1], row.c_str (), row.size ()) != (ssize_t) row.size ())
+        {
+          _exit (1);
+        }
+        close (fds[1]);
+        _exit (0);
+      }
+      close (fds[1]);
+      Worker worker = {pid, fds[0], next};
+      workers.push_back (worker);
+      next++;
+    }
+
+    //Collect any finished worker
+    int status;
+    pid_t pid = wait (&status);
+    for (std::vector<Worker>::iterator iterator = workers.begin (); iterator != workers.end (); iterator++)
+    {
+      if (iterator->pid != pid)
+      {
+        continue;
+      }
+      results[iterator->index] = ReadAll (iterator->fd);
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0 || results[iterator->index].empty ())
+      {
+        std::cerr << "Worker for parameter point " << iterator->index << " failed\n";
+        failed++;
+      }
+      else
+      {
+        std::cout << "[" << iterator->index + 1 << "/" << points.size () << "] " << results[iterator->index] << std::endl;
+      }
+      workers.erase (iterator);
+      break;
+    }
+  }
+
+  std::ofstream file (output.c_str ());
+  file << ChordSweepRun::GetCsvHeader () << "\n";
+  for (uint32_t i = 0; i < results.size (); i++)
+  {
+    if (!results[i].empty ())
+    {
+      file << results[i] << "\n";
+    }
+  }
+  file.close ();
+
+  Simulator::Destroy ();
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Offline summary of a binary ChordTraceWriter trace
+//
+// Prints lookup statistics, the hop count distribution of successful lookups
+// and, per Chord message type, number of sent messages, bytes and average
+// bandwidth over the traced interval.
+//
+// ./waf --run "chord-trace-analyze --input=sweep-0.bin"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <stdint.h>
+#include "ns3/core-module.h"
+#include "ns3/chord-message.h"
+#include "ns3/chord-trace-writer.h"
+
+using namespace ns3;
+
+static std::string
+GetMessageTypeName (uint8_t messageType)
+{
+  switch (messageType)
+  {
+    case ChordMessage::JOIN_REQ:
+      return "JOIN_REQ";
+    case ChordMessage::JOIN_RSP:
+      return "JOIN_RSP";
+    case ChordMessage::STABILIZE_REQ:
+      return "STABILIZE_REQ";
+    case ChordMessage::STABILIZE_RSP:
+      return "STABILIZE_RSP";
+    case ChordMessage::FINGER_REQ:
+      return "FINGER_REQ";
+    case ChordMessage::FINGER_RSP:
+      return "FINGER_RSP";
+    case ChordMessage::HEARTBEAT_REQ:
+      return "HEARTBEAT_REQ";
+    case ChordMessage::HEARTBEAT_RSP:
+      return "HEARTBEAT_RSP";
+    case ChordMessage::LOOKUP_REQ:
+      return "LOOKUP_REQ";
+    case ChordMessage::LOOKUP_RSP:
+      return "LOOKUP_RSP";
+    case ChordMessage::LEAVE_REQ:
+      return "LEAVE_REQ";
+    case ChordMessage::LEAVE_RSP:
+      return "LEAVE_RSP";
+    case ChordMessage::HEARTBEAT_AGG_REQ:
+      return "HEARTBEAT_AGG_REQ";
+    case ChordMessage::HEARTBEAT_AGG_RSP:
+      return "HEARTBEAT_AGG_RSP";
+    case ChordMessage::TRACE_RING:
+      return "TRACE_RING";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+struct MessageCounters
+{
+  uint64_t messages;
+  uint64_t bytes;
+  uint64_t timeouts;
+};
+
+int
+main (int argc, char *argv[])
+{
+  std::string input = "chord-trace.bin";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace written by ChordTraceWriter", input);
+  cmd.Parse (argc, argv);
+
+  std::ifstream file (input.c_str (), std::ios::in | std::ios::binary);
+  if (!file.is_open ())
+  {
+    std::cerr << "Can not open " << input << "\n";
+    return 1;
+  }
+  if (!ChordTraceWriter::ReadHeader (file))
+  {
+    std::cerr << input << " is not a Chord trace of a supported version\n";
+    return 1;
+  }
+
+  std::map<uint8_t, MessageCounters> messageCounters;
+  std::map<uint8_t, uint64_t> hopCounts;
+  uint64_t records = 0;
+  uint64_t lookupsStarted = 0;
+  uint64_t lookupsSucceeded = 0;
+  uint64_t lookupsFailed = 0;
+  uint64_t totalLatencyUs = 0;
+  uint64_t firstTime = 0;
+  uint64_t lastTime = 0;
+
+  ChordTraceWriter::Record record;
+  while (file.read ((char*) &record, sizeof (record)))
+  {
+    if (records++ == 0)
+    {
+      firstTime = record.time;
+    }
+    lastTime = record.time;
+    switch (record.event)
+    {
+      case ChordTraceWriter::TX:
+        {
+          MessageCounters &counters = messageCounters[record.messageType];
+          counters.messages++;
+          counters.bytes += record.value;
+          break;
+        }
+      case ChordTraceWriter::LOOKUP_START:
+        lookupsStarted++;
+        break;
+      case ChordTraceWriter::LOOKUP_FINISH:
+        if (record.flags)
+        {
+          lookupsSucceeded++;
+          totalLatencyUs += record.value;
+          hopCounts[record.hopCount]++;
+        }
+        else
+        {
+          lookupsFailed++;
+        }
+        break;
+      case ChordTraceWriter::REQUEST_TIMEOUT:
+        messageCounters[record.messageType].timeouts++;
+        break;
+      default:
+        break;
+    }
+  }
+
+  double duration = (lastTime - firstTime) / 1e9;
+  std::cout << "Records: " << records << ", traced interval: " << duration << " s\n\n";
+
+  std::cout << "Lookups: " << lookupsStarted << " started, " << lookupsSucceeded << " succeeded, " << lookupsFailed << " failed";
+  if (lookupsSucceeded > 0)
+  {
+    std::cout << ", mean latency " << totalLatencyUs / 1000.0 / lookupsSucceeded << " ms";
+  }
+  std::cout << "\n\n";
+
+  std::cout << std::setw (6) << "Hops" << std::setw (12) << "Lookups" << std::setw (12) << "Fraction" << std::setw (12) << "CDF" << "\n";
+  uint64_t cumulative = 0;
+  for (std::map<uint8_t, uint64_t>::iterator iterator = hopCounts.begin (); iterator != hopCounts.end (); iterator++)
+  {
+    cumulative += iterator->second;
+    std::cout << std::setw (6) << (uint32_t) iterator->first << std::setw (12) << iterator->second
+              << std::setw (12) << std::fixed << std::setprecision (4) << (double) iterator->second / lookupsSucceeded
+              << std::setw (12) << (double) cumulative / lookupsSucceeded << "\n";
+  }
+  std::cout << "\n";
+
+  std::cout << std::setw (16) << "MessageType" << std::setw (12) << "Messages" << std::setw (14) << "Bytes"
+            << std::setw (14) << "Bytes/s" << std::setw (10) << "Timeouts" << "\n";
+  for (std::map<uint8_t, MessageCounters>::iterator iterator = messageCounters.begin (); iterator != messageCounters.end (); iterator++)
+  {
+    std::cout << std::setw (16) << GetMessageTypeName (iterator->first) << std::setw (12) << iterator->second.messages
+              << std::setw (14) << iterator->second.bytes
+              << std::setw (14) << std::setprecision (1) << (duration > 0 ? iterator->second.bytes / duration : 0.0)
+              << std::setw (10) << iterator->second.timeouts << "\n";
+  }
+  return 0;
+}
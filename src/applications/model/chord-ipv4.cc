@@ -18,6 +18,9 @@
 
 #include "stdint.h"
 #include "stdlib.h"
+#include <string.h>
+#include <sstream>
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/nstime.h"
@@ -34,6 +37,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
 #include "chord-ipv4.h"
+#include "chord-udp-transport.h"
 #include "ns3/double.h"
 
 namespace ns3 {
@@ -72,6 +76,11 @@ ChordIpv4::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&ChordIpv4::m_applicationPort),
                    MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("Transport",
+                   "TypeId of ChordTransport carrying Chord protocol messages",
+                   TypeIdValue (ChordUdpTransport::GetTypeId ()),
+                   MakeTypeIdAccessor (&ChordIpv4::m_transportTid),
+                   MakeTypeIdChecker ())
     .AddAttribute ("DHashEnable",
                    "DHash layer enable flag",
                    BooleanValue (false),
@@ -102,6 +111,11 @@ ChordIpv4::GetTypeId (void)
                    TimeValue (MilliSeconds (DEFAULT_HEARTBEAT_INTERVAL)),
                    MakeTimeAccessor (&ChordIpv4::m_heartbeatInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("AggregateHeartbeats",
+                   "Send one heartbeat per remote IP:port for all VirtualNodes whose predecessors live there",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&ChordIpv4::m_aggregateHeartbeats),
+                   MakeBooleanChecker ())
     .AddAttribute ("MaxMissedKeepAlives",
                    "Number of missed Heartbeats and Stabilize requests before declaring node dead",
                    UintegerValue (DEFAULT_MAX_MISSED_KEEP_ALIVES),
@@ -132,6 +146,50 @@ ChordIpv4::GetTypeId (void)
                    TimeValue (MilliSeconds (DEFAULT_FIX_FINGER_INTERVAL)),
                    MakeTimeAccessor (&ChordIpv4::m_fixFingerInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("VirtualNodes",
+                   "Number of VirtualNodes inserted and placed by ChordIpv4 itself (load balancing mode), 0 disables",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ChordIpv4::m_virtualNodes),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("PlacementChoices",
+                   "Number of random identifiers probed when placing a VirtualNode; the range of the most loaded owner is split",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&ChordIpv4::m_placementChoices),
+                   MakeUintegerChecker<uint8_t> (1))
+    .AddAttribute ("LoadBalanceInterval",
+                   "Interval for re-keying the least loaded VirtualNode in load balancing mode, 0 disables",
+                   TimeValue (Seconds (30)),
+                   MakeTimeAccessor (&ChordIpv4::m_loadBalanceInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("LoadImbalanceThreshold",
+                   "VirtualNode is re-keyed if probed load exceeds its own load by this factor",
+                   DoubleValue (4.0),
+                   MakeDoubleAccessor (&ChordIpv4::m_loadImbalanceThreshold),
+                   MakeDoubleChecker<double> (1.0))
+    .AddTraceSource ("Tx",
+                     "A Chord message is sent",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_txTrace),
+                     "ns3::ChordIpv4::MessageTracedCallback")
+    .AddTraceSource ("Rx",
+                     "A Chord message is received",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_rxTrace),
+                     "ns3::ChordIpv4::MessageTracedCallback")
+    .AddTraceSource ("LookupStart",
+                     "A lookup is started",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_lookupStartTrace),
+                     "ns3::ChordIpv4::LookupStartTracedCallback")
+    .AddTraceSource ("LookupFinish",
+                     "A lookup succeeded or failed",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_lookupFinishTrace),
+                     "ns3::ChordIpv4::LookupFinishTracedCallback")
+    .AddTraceSource ("RequestTimeout",
+                     "A request timed out (retransmitted or given up)",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_requestTimeoutTrace),
+                     "ns3::ChordIpv4::RequestTimeoutTracedCallback")
+    .AddTraceSource ("VNodeRekey",
+                     "A VirtualNode is moved to split the range of a more loaded one",
+                     MakeTraceSourceAccessor (&ChordIpv4::m_vNodeRekeyTrace),
+                     "ns3::ChordIpv4::VNodeRekeyTracedCallback")
 
      ;
   return tid;
@@ -141,24 +199,33 @@ ChordIpv4::GetTypeId (void)
 ChordIpv4::ChordIpv4 ()
   :m_stabilizeTimer (Timer::CANCEL_ON_DESTROY),
   m_heartbeatTimer (Timer::CANCEL_ON_DESTROY),
-  m_fixFingerTimer (Timer::CANCEL_ON_DESTROY)
+  m_fixFingerTimer (Timer::CANCEL_ON_DESTROY),
+  m_loadBalanceTimer (Timer::CANCEL_ON_DESTROY)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_socket = 0;
+  m_transport = 0;
   isBootStrapNode = false;
+  m_rekeys = 0;
+  memset (&m_maintenanceStats, 0, sizeof (m_maintenanceStats));
   //Timer configuration
 }
 
 ChordIpv4::~ChordIpv4 ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_socket = 0;
+  m_transport = 0;
 }
 
 void
 ChordIpv4::DoDispose (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  //Release transport first, lower layers of the node may already be disposed
+  if (m_transport != 0)
+  {
+    m_transport->Dispose ();
+    m_transport = 0;
+  }
   StopApplication();
   Application::DoDispose ();
 }
@@ -179,18 +246,14 @@ ChordIpv4::StartApplication (void)
     isBootStrapNode = true; 
   }
 
-  if (m_socket == 0)
+  if (m_transport == 0)
   {
-    TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
-    m_socket = Socket::CreateSocket (GetNode(), tid);
-    InetSocketAddress local = InetSocketAddress (m_localIpAddress, m_listeningPort);
-    m_socket->Bind (local);
-    m_socket->SetRecvCallback(MakeCallback(&ChordIpv4::ProcessUdpPacket, this));
-  }
-  else
-  {
-    m_socket->SetRecvCallback(MakeCallback(&ChordIpv4::ProcessUdpPacket, this));
+    ObjectFactory transportFactory;
+    transportFactory.SetTypeId (m_transportTid);
+    m_transport = transportFactory.Create<ChordTransport> ();
   }
+  m_transport->SetRecvCallback (MakeCallback(&ChordIpv4::ProcessPacket, this));
+  m_transport->Start (GetNode(), m_localIpAddress, m_listeningPort);
 
   //Start DHash layer
   if (m_dHashEnable == true)
@@ -220,23 +283,37 @@ ChordIpv4::StartApplication (void)
   m_stabilizeTimer.Schedule(m_stabilizeInterval);
   m_heartbeatTimer.Schedule(m_heartbeatInterval);
   m_fixFingerTimer.Schedule(m_fixFingerInterval);
+
+  //Load balancing mode: insert VirtualNodes one after another, next one on join success
+  if (m_virtualNodes > 0)
+  {
+    m_placementRandom = CreateObject<UniformRandomVariable> ();
+    m_loadBalanceTimer.SetFunction(&ChordIpv4::DoPeriodicLoadBalance, this);
+    if (!m_loadBalanceInterval.IsZero ())
+    {
+      m_loadBalanceTimer.Schedule(m_loadBalanceInterval);
+    }
+    PlaceNextVNode ();
+  }
 }
 
 void
 ChordIpv4::StopApplication ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  if (m_socket != 0)
+  if (m_transport != 0)
+  {
+    m_transport->Stop ();
+  }
+  if (m_dHashIpv4 != 0)
   {
-    //m_socket->Close ();
-    m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> > ());
-    //m_socket = 0;
+    m_dHashIpv4 -> DoDispose();
   }
-  m_dHashIpv4 -> DoDispose();
   //Cancel Timers
   m_stabilizeTimer.Cancel();
   m_heartbeatTimer.Cancel();
   m_fixFingerTimer.Cancel();
+  m_loadBalanceTimer.Cancel();
   //Delete vNodes
   m_vNodeMap.Clear();
 }
@@ -256,6 +333,13 @@ ChordIpv4::SetLookupSuccessCallback (Callback<void, uint8_t*, uint8_t, Ipv4Addre
   m_lookupSuccessFn = lookupSuccessFn;
 }
 
+void
+ChordIpv4::SetLookupOwnerCallback (Callback<void, uint8_t*, uint8_t, uint8_t*, uint8_t, Ipv4Address, uint16_t> lookupOwnerFn)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_lookupOwnerFn = lookupOwnerFn;
+}
+
 void
 ChordIpv4::SetLookupFailureCallback (Callback<void, uint8_t*, uint8_t> lookupFailureFn)
 {
@@ -336,20 +420,36 @@ ChordIpv4::NotifyJoinSuccess (std::string vNodeName, Ptr<ChordIdentifier> chordI
   {
     m_joinSuccessFn (vNodeName ,chordIdentifier->GetKey (), chordIdentifier->GetNumBytes());
   }
+  if (m_virtualNodes > 0)
+  {
+    PlaceNextVNode ();
+  }
 }
 
 void
-ChordIpv4::NotifyLookupSuccess (Ptr<ChordIdentifier> lookupIdentifier, Ptr<ChordNode> resolvedNode, ChordTransaction::Originator originator)
+ChordIpv4::NotifyLookupSuccess (Ptr<ChordIdentifier> lookupIdentifier, Ptr<ChordNode> resolvedNode, ChordTransaction::Originator originator, uint32_t load)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  if (!m_lookupSuccessFn.IsNull() && originator == ChordTransaction::APPLICATION)
+  if (originator == ChordTransaction::APPLICATION)
   {
-    m_lookupSuccessFn (lookupIdentifier->GetKey(), lookupIdentifier->GetNumBytes(), resolvedNode->GetIpAddress(), resolvedNode->GetApplicationPort());
+    if (!m_lookupSuccessFn.IsNull ())
+    {
+      m_lookupSuccessFn (lookupIdentifier->GetKey(), lookupIdentifier->GetNumBytes(), resolvedNode->GetIpAddress(), resolvedNode->GetApplicationPort());
+    }
+    if (!m_lookupOwnerFn.IsNull ())
+    {
+      Ptr<ChordIdentifier> ownerIdentifier = resolvedNode->GetChordIdentifier ();
+      m_lookupOwnerFn (lookupIdentifier->GetKey(), lookupIdentifier->GetNumBytes(), ownerIdentifier->GetKey(), ownerIdentifier->GetNumBytes(), resolvedNode->GetIpAddress(), resolvedNode->GetApplicationPort());
+    }
   }
   else if (originator == ChordTransaction::DHASH)
   {
     NotifyDHashLookupSuccess (lookupIdentifier, resolvedNode->GetIpAddress(), resolvedNode->GetDHashPort());
   }
+  else if (originator == ChordTransaction::LOAD_BALANCER)
+  {
+    HandlePlacementProbe (lookupIdentifier, true, load);
+  }
 }
 
 void
@@ -364,6 +464,10 @@ ChordIpv4::NotifyLookupFailure (Ptr<ChordIdentifier> chordIdentifier, ChordTrans
   {
     NotifyDHashLookupFailure (chordIdentifier);
   }
+  else if (originator == ChordTransaction::LOAD_BALANCER)
+  {
+    HandlePlacementProbe (chordIdentifier, false, 0);
+  }
 }
 void
 ChordIpv4::NotifyDHashLookupSuccess (Ptr<ChordIdentifier> lookupIdentifier, Ipv4Address ipAddress, uint16_t port)
@@ -417,6 +521,11 @@ ChordIpv4::NotifyVNodeFailure (std::string vNodeName, Ptr<ChordIdentifier> chord
   {
     m_vNodeFailureFn (vNodeName, chordIdentifier->GetKey (), chordIdentifier->GetNumBytes());
   }
+  if (m_virtualNodes > 0)
+  {
+    //Failed vNode is deleted after notification, place it again afterwards
+    Simulator::ScheduleNow (&ChordIpv4::PlaceNextVNode, this);
+  }
 }
 
 void
@@ -578,7 +687,9 @@ ChordIpv4::DoLookup (Ptr<ChordIdentifier> requestedIdentifier, ChordTransaction:
   if (ret == true)
   {
     //We are owner, report success
-    NotifyLookupSuccess(requestedIdentifier, virtualNode, originator);
+    m_lookupStartTrace (0, originator);
+    m_lookupFinishTrace (0, 0, Seconds (0), true);
+    NotifyLookupSuccess(requestedIdentifier, virtualNode, originator, GetVNodeLoad (virtualNode));
     return;
   } 
   //Initiate lookup request
@@ -594,6 +705,7 @@ ChordIpv4::DoLookup (Ptr<ChordIdentifier> requestedIdentifier, ChordTransaction:
     chordTransaction->SetRequestedIdentifier (requestedIdentifier);
     //Add to vNode
     virtualNode -> AddTransaction (chordMessage.GetTransactionId(), chordTransaction);
+    m_lookupStartTrace (chordMessage.GetTransactionId(), originator);
 
     //Start transaction timer
     EventId requestTimeoutId = Simulator::Schedule (chordTransaction->GetRequestTimeout(), &ChordIpv4::HandleRequestTimeout, this, virtualNode, chordMessage.GetTransactionId());
@@ -607,6 +719,8 @@ ChordIpv4::DoLookup (Ptr<ChordIdentifier> requestedIdentifier, ChordTransaction:
   }  
   else
   {
+    m_lookupStartTrace (0, originator);
+    m_lookupFinishTrace (0, 0, Seconds (0), false);
     NotifyLookupFailure (requestedIdentifier, originator);
     return;
   }
@@ -614,69 +728,66 @@ ChordIpv4::DoLookup (Ptr<ChordIdentifier> requestedIdentifier, ChordTransaction:
 
 
 void
-ChordIpv4::ProcessUdpPacket (Ptr<Socket> socket)
+ChordIpv4::ProcessPacket (Ptr<Packet> packet, Ipv4Address fromIpAddress, uint16_t fromPort)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Ptr<Packet> packet;
-  Address from;
-  while (packet = socket->RecvFrom(from))
-  {
-    if (InetSocketAddress::IsMatchingType (from))
-    {
-      InetSocketAddress address = InetSocketAddress::ConvertFrom (from);
-      NS_LOG_INFO ("ChordIpv4: Received " << packet->GetSize() << " bytes packet from " <<  address.GetIpv4());
-      Ipv4Address fromIpAddress = address.GetIpv4();
-
-      ChordMessage chordMessage = ChordMessage ();
-      //Retrieve and Deserialize chord message
-      packet->RemoveHeader(chordMessage);
-      NS_LOG_INFO ("ChordMessage: " << chordMessage);
-      switch (chordMessage.GetMessageType ())
-      {
-       case ChordMessage::JOIN_REQ:
-         ProcessJoinReq (chordMessage);
-         break;
-       case ChordMessage::JOIN_RSP:
-         ProcessJoinRsp (chordMessage);
-         break;
-       case ChordMessage::LEAVE_REQ:
-         ProcessLeaveReq (chordMessage);
-         break;
-       case ChordMessage::LEAVE_RSP:
-         ProcessLeaveRsp (chordMessage);
-         break;
-       case ChordMessage::LOOKUP_REQ:
-         ProcessLookupReq (chordMessage);
-         break;
-       case ChordMessage::LOOKUP_RSP:
-         ProcessLookupRsp (chordMessage);
-         break;
-       case ChordMessage::STABILIZE_REQ:
-         ProcessStabilizeReq (chordMessage);
-         break;
-       case ChordMessage::STABILIZE_RSP:
-         ProcessStabilizeRsp (chordMessage);
-         break;
-       case ChordMessage::HEARTBEAT_REQ:
-         ProcessHeartbeatReq (chordMessage);
-         break;
-       case ChordMessage::HEARTBEAT_RSP:
-         ProcessHeartbeatRsp (chordMessage);
-         break;
-       case ChordMessage::FINGER_REQ:
-         ProcessFingerReq (chordMessage);
-         break;
-       case ChordMessage::FINGER_RSP:
-         ProcessFingerRsp (chordMessage);
-         break;
-       case ChordMessage::TRACE_RING:
-         ProcessTraceRing (chordMessage);
-         break;
-       default:
-         break;
+  NS_LOG_INFO ("ChordIpv4: Received " << packet->GetSize() << " bytes packet from " <<  fromIpAddress);
 
-      }
-    }
+  ChordMessage chordMessage = ChordMessage ();
+  uint32_t packetSize = packet->GetSize ();
+  //Retrieve and Deserialize chord message
+  packet->RemoveHeader(chordMessage);
+  NS_LOG_INFO ("ChordMessage: " << chordMessage);
+  m_rxTrace (chordMessage.GetMessageType (), packetSize, chordMessage.GetTransactionId (), chordMessage.GetHopCount (), fromIpAddress);
+  switch (chordMessage.GetMessageType ())
+  {
+   case ChordMessage::JOIN_REQ:
+     ProcessJoinReq (chordMessage);
+     break;
+   case ChordMessage::JOIN_RSP:
+     ProcessJoinRsp (chordMessage);
+     break;
+   case ChordMessage::LEAVE_REQ:
+     ProcessLeaveReq (chordMessage);
+     break;
+   case ChordMessage::LEAVE_RSP:
+     ProcessLeaveRsp (chordMessage);
+     break;
+   case ChordMessage::LOOKUP_REQ:
+     ProcessLookupReq (chordMessage);
+     break;
+   case ChordMessage::LOOKUP_RSP:
+     ProcessLookupRsp (chordMessage);
+     break;
+   case ChordMessage::STABILIZE_REQ:
+     ProcessStabilizeReq (chordMessage);
+     break;
+   case ChordMessage::STABILIZE_RSP:
+     ProcessStabilizeRsp (chordMessage);
+     break;
+   case ChordMessage::HEARTBEAT_REQ:
+     ProcessHeartbeatReq (chordMessage);
+     break;
+   case ChordMessage::HEARTBEAT_RSP:
+     ProcessHeartbeatRsp (chordMessage);
+     break;
+   case ChordMessage::HEARTBEAT_AGG_REQ:
+     ProcessHeartbeatAggReq (chordMessage);
+     break;
+   case ChordMessage::HEARTBEAT_AGG_RSP:
+     ProcessHeartbeatAggRsp (chordMessage);
+     break;
+   case ChordMessage::FINGER_REQ:
+     ProcessFingerReq (chordMessage);
+     break;
+   case ChordMessage::FINGER_RSP:
+     ProcessFingerRsp (chordMessage);
+     break;
+   case ChordMessage::TRACE_RING:
+     ProcessTraceRing (chordMessage);
+     break;
+   default:
+     break;
   }
 }
 
@@ -709,6 +820,11 @@ ChordIpv4::ProcessJoinReq (ChordMessage chordMessage)
     return;
   }
   //Could not resolve join request, forward to nearest successor
+  if (!chordMessage.IncrementHopCount ())
+  {
+    NS_LOG_WARN ("Dropping JoinReq, hop count exceeded");
+    return;
+  }
   packet->AddHeader(chordMessage);
   if (packet->GetSize())
   {
@@ -768,6 +884,10 @@ ChordIpv4::ProcessLookupReq (ChordMessage chordMessage)
   {
     ChordMessage chordMessageRsp = ChordMessage ();
     virtualNode->PackLookupRsp (requestorNode,  transactionId, chordMessageRsp);
+    //Report hops taken by request (including the one which reached us)
+    chordMessageRsp.SetHopCount (chordMessage.GetHopCount ());
+    chordMessageRsp.IncrementHopCount ();
+    chordMessageRsp.GetLookupRsp().load = GetVNodeLoad (virtualNode);
     packet-> AddHeader (chordMessageRsp);
     //Send packet
     if (packet->GetSize())
@@ -778,6 +898,11 @@ ChordIpv4::ProcessLookupReq (ChordMessage chordMessage)
     return;
   }
   //Could not resolve lookup request, forward to nearest successor
+  if (!chordMessage.IncrementHopCount ())
+  {
+    NS_LOG_WARN ("Dropping LookupReq, hop count exceeded");
+    return;
+  }
   packet->AddHeader(chordMessage);
   RoutePacket (requestedIdentifier, packet);
 }
@@ -866,10 +991,11 @@ ChordIpv4::ProcessLookupRsp (ChordMessage chordMessage)
     }
     Ptr<ChordIdentifier> requestedIdentifier = chordTransaction->GetRequestedIdentifier ();
     ChordTransaction::Originator originator = chordTransaction->GetOriginator();
+    m_lookupFinishTrace (chordTransaction->GetTransactionId(), chordMessage.GetHopCount (), Simulator::Now () - chordTransaction->GetStartTime (), true);
     //cancel transaction
     virtualNode->RemoveTransaction (chordTransaction->GetTransactionId());
     //notify application about lookup success
-    NotifyLookupSuccess(requestedIdentifier, resolvedNode, originator);
+    NotifyLookupSuccess(requestedIdentifier, resolvedNode, originator, chordMessage.GetLookupRsp().load);
   }
 }
 
@@ -1042,6 +1168,11 @@ ChordIpv4::ProcessFingerReq (ChordMessage chordMessage)
     return;
   }
   //Could not resolve finger request, forward to successor
+  if (!chordMessage.IncrementHopCount ())
+  {
+    NS_LOG_WARN ("Dropping FingerReq, hop count exceeded");
+    return;
+  }
   packet->AddHeader(chordMessage);
   Ptr<ChordVNode> vNode;
   if (FindNearestVNode (requestedIdentifier, vNode) == true)
@@ -1083,6 +1214,7 @@ ChordIpv4::HandleRequestTimeout (Ptr<ChordVNode> vNode, uint32_t transactionId)
     //Transaction does not exist
     return;
   }
+  m_requestTimeoutTrace (chordTransaction->GetChordMessage().GetMessageType(), transactionId, chordTransaction->GetRetries());
   //Retransmit and reschedule if needed
   if (chordTransaction->GetRetries() > chordTransaction->GetMaxRetries())
   {
@@ -1097,6 +1229,7 @@ ChordIpv4::HandleRequestTimeout (Ptr<ChordVNode> vNode, uint32_t transactionId)
     else if (chordTransaction->GetChordMessage().GetMessageType() == ChordMessage::LOOKUP_REQ)
     {
       NS_LOG_ERROR ("Lookup Request failed!");
+      m_lookupFinishTrace (transactionId, 0, Simulator::Now () - chordTransaction->GetStartTime (), false);
       NotifyLookupFailure (chordTransaction->GetChordMessage().GetLookupReq().requestedIdentifier, chordTransaction->GetOriginator());
       //cancel transaction
       vNode->RemoveTransaction (chordTransaction->GetTransactionId());
@@ -1200,7 +1333,33 @@ void
 ChordIpv4::SendPacket (Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_socket->SendTo (packet, 0, InetSocketAddress (destinationIp, destinationPort));
+  //Fixed part of ChordMessage header: messageType, hopCount, transactionId
+  uint8_t header[6];
+  if (packet->CopyData (header, sizeof (header)) == sizeof (header))
+  {
+    uint32_t transactionId = (header[2] << 24) | (header[3] << 16) | (header[4] << 8) | header[5];
+    m_txTrace (header[0], packet->GetSize (), transactionId, header[1], destinationIp);
+    switch (header[0])
+    {
+      case ChordMessage::HEARTBEAT_REQ:
+      case ChordMessage::HEARTBEAT_RSP:
+      case ChordMessage::HEARTBEAT_AGG_REQ:
+      case ChordMessage::HEARTBEAT_AGG_RSP:
+        m_maintenanceStats.heartbeatMessages++;
+        break;
+      case ChordMessage::STABILIZE_REQ:
+      case ChordMessage::STABILIZE_RSP:
+        m_maintenanceStats.stabilizeMessages++;
+        break;
+      case ChordMessage::FINGER_REQ:
+      case ChordMessage::FINGER_RSP:
+        m_maintenanceStats.fingerMessages++;
+        break;
+      default:
+        break;
+    }
+  }
+  m_transport->Send (packet, destinationIp, destinationPort);
 }
 
 /*  Logic: We need to send packet via virtual node whose key is nearest to the requested key. Our aim is to minimize lookup hops.
@@ -1266,6 +1425,18 @@ ChordIpv4::RouteViaFinger (Ptr<ChordIdentifier> targetIdentifier, Ptr<ChordVNode
   if (packet->GetSize())
   {
     Ptr<ChordNode> remoteNode;
+    Ptr<ChordNode> ownerNode;
+    //Deliver directly if owner is in successor or predecessor list
+    if (vNode->FindNeighborOwner (targetIdentifier, ownerNode) == true)
+    {
+      vNode->GetStats().neighborRoutes++;
+      if (vNode->GetFingerTable().FindNearestNode(targetIdentifier, remoteNode) == false || !remoteNode->GetChordIdentifier()->IsEqual(ownerNode->GetChordIdentifier()))
+      {
+        vNode->GetStats().hopsSaved++;
+      }
+      SendPacket (packet, ownerNode->GetIpAddress(), ownerNode->GetPort());
+      return true;
+    }
     //Choose nearest finger
     if (vNode->GetFingerTable().FindNearestNode(targetIdentifier, remoteNode) == true)
     {
@@ -1287,10 +1458,10 @@ ChordIpv4::RouteViaFinger (Ptr<ChordIdentifier> targetIdentifier, Ptr<ChordVNode
 void
 ChordIpv4::DoPeriodicStabilize()
 {
-  //Loop for all v-nodes
-  for(ChordNodeMap::iterator vNodeIter = m_vNodeMap.GetMap().begin(); vNodeIter != m_vNodeMap.GetMap().end(); vNodeIter++)
+  //Loop for all v-nodes (advance iterator before vNode may be deleted)
+  for(ChordNodeMap::iterator vNodeIter = m_vNodeMap.GetMap().begin(); vNodeIter != m_vNodeMap.GetMap().end();)
   {
-    Ptr<ChordVNode> vNode = DynamicCast<ChordVNode>((*vNodeIter).second);
+    Ptr<ChordVNode> vNode = DynamicCast<ChordVNode>((*vNodeIter++).second);
     //Check if successor is alive. Shift successor if necessary. If all else fails, send CHORD_FAILURE to user and remove vNode
     //Compare timestamp and check if current successor has died
     if (vNode->GetSuccessor()->GetTimestamp().GetMilliSeconds() + m_stabilizeInterval.GetMilliSeconds() * m_maxMissedKeepAlives < Simulator::Now().GetMilliSeconds ())
@@ -1330,6 +1501,8 @@ ChordIpv4::DoPeriodicStabilize()
 void
 ChordIpv4::DoPeriodicHeartbeat()
 {
+  //VirtualNodes grouped by IP:port of their predecessor
+  std::map<std::pair<Ipv4Address, uint16_t>, std::vector<Ptr<ChordVNode> > > heartbeatGroups;
   //Loop for all v-nodes
   for(ChordNodeMap::iterator vNodeIter = m_vNodeMap.GetMap().begin(); vNodeIter != m_vNodeMap.GetMap().end(); vNodeIter++)
   {
@@ -1353,7 +1526,24 @@ ChordIpv4::DoPeriodicHeartbeat()
       }
     }
     //Fire stablize req
-    DoHeartbeat (vNode);
+    if (!m_aggregateHeartbeats || vNode->GetPredecessor()->GetChordIdentifier()->IsEqual(vNode->GetChordIdentifier()))
+    {
+      DoHeartbeat (vNode);
+      continue;
+    }
+    heartbeatGroups[std::make_pair (vNode->GetPredecessor()->GetIpAddress(), vNode->GetPredecessor()->GetPort())].push_back (vNode);
+  }
+  //One heartbeat per remote IP:port (per 255 vNodes)
+  for (std::map<std::pair<Ipv4Address, uint16_t>, std::vector<Ptr<ChordVNode> > >::iterator groupIter = heartbeatGroups.begin(); groupIter != heartbeatGroups.end(); groupIter++)
+  {
+    if (groupIter->second.size() == 1)
+    {
+      DoHeartbeat (groupIter->second.front());
+    }
+    else
+    {
+      DoAggregatedHeartbeat (groupIter->second);
+    }
   }
   //RescheduleTimer
   m_heartbeatTimer.Schedule (m_heartbeatInterval);
@@ -1504,6 +1694,9 @@ ChordIpv4::DumpVNodeInfo(std::string vNodeName, std::ostream &os)
     virtualNode -> PrintFingerTable (os);
     //virtualNode -> PrintFingerIdentifierList (os);
     os << "Fingers actually looked up: " << virtualNode->GetStats().fingersLookedUp << "\n";
+    os << "Requests routed via successor/predecessor list: " << virtualNode->GetStats().neighborRoutes << "\n";
+    os << "Hops saved by successor/predecessor list routing: " << virtualNode->GetStats().hopsSaved << "\n";
+    os << "DHash objects owned: " << GetVNodeLoad (virtualNode) << "\n";
   }
   else
   {
@@ -1511,12 +1704,274 @@ ChordIpv4::DumpVNodeInfo(std::string vNodeName, std::ostream &os)
   }
 }
 
+void
+ChordIpv4::DoAggregatedHeartbeat (std::vector<Ptr<ChordVNode> > &virtualNodes)
+{
+  //heartbeatCount is a single byte, larger groups are split over several messages
+  for (size_t first = 0; first < virtualNodes.size(); first += 255)
+  {
+    Ptr<Packet> packet = Create<Packet> ();
+    ChordMessage chordMessage = ChordMessage ();
+    chordMessage.SetMessageType (ChordMessage::HEARTBEAT_AGG_REQ);
+    //Response is sent to IP:port of requestor, which is shared by all local vNodes
+    chordMessage.SetRequestorNode (virtualNodes[first]);
+    ChordMessage::HeartbeatAggReq &heartbeatAggReq = chordMessage.GetHeartbeatAggReq();
+    heartbeatAggReq.heartbeatCount = std::min (virtualNodes.size() - first, (size_t) 255);
+    for (uint8_t i = 0; i < heartbeatAggReq.heartbeatCount; i++)
+    {
+      heartbeatAggReq.requestorIdentifiers.push_back (virtualNodes[first + i]->GetChordIdentifier());
+      heartbeatAggReq.predecessorIdentifiers.push_back (virtualNodes[first + i]->GetPredecessor()->GetChordIdentifier());
+    }
+    m_maintenanceStats.aggregatedHeartbeats += heartbeatAggReq.heartbeatCount;
+    packet->AddHeader (chordMessage);
+    if (packet->GetSize())
+    {
+      NS_LOG_INFO ("Sending HeartbeatAggReq: " << chordMessage);
+      SendPacket(packet, virtualNodes[first]->GetPredecessor()->GetIpAddress(), virtualNodes[first]->GetPredecessor()->GetPort());
+    }
+  }
+}
+
+void
+ChordIpv4::ProcessHeartbeatAggReq (ChordMessage chordMessage)
+{
+  Ptr<ChordNode> requestorNode = chordMessage.GetRequestorNode();
+  ChordMessage::HeartbeatAggReq &heartbeatAggReq = chordMessage.GetHeartbeatAggReq();
+
+  ChordMessage chordMessageRsp = ChordMessage ();
+  chordMessageRsp.SetMessageType (ChordMessage::HEARTBEAT_AGG_RSP);
+  chordMessageRsp.SetRequestorNode (requestorNode);
+  ChordMessage::HeartbeatAggRsp &heartbeatAggRsp = chordMessageRsp.GetHeartbeatAggRsp();
+  heartbeatAggRsp.heartbeatCount = 0;
+  for (uint8_t i = 0; i < heartbeatAggReq.heartbeatCount; i++)
+  {
+    //Answer for every vNode which still exists here, missing answers count as missed heartbeats
+    Ptr<ChordVNode> virtualNode;
+    if (FindVNode(heartbeatAggReq.predecessorIdentifiers[i], virtualNode) == false)
+    {
+      continue;
+    }
+    ChordMessage heartbeatRsp = ChordMessage ();
+    virtualNode->PackHeartbeatRsp(requestorNode, heartbeatRsp);
+    heartbeatAggRsp.requestorIdentifiers.push_back (heartbeatAggReq.requestorIdentifiers[i]);
+    heartbeatAggRsp.heartbeatRsps.push_back (heartbeatRsp.GetHeartbeatRsp());
+    heartbeatAggRsp.heartbeatCount++;
+  }
+  if (heartbeatAggRsp.heartbeatCount == 0)
+  {
+    return;
+  }
+  Ptr<Packet> packet = Create<Packet> ();
+  packet-> AddHeader (chordMessageRsp);
+  if (packet->GetSize())
+  {
+    NS_LOG_INFO ("Sending HeartbeatAggRsp: "<<chordMessageRsp);
+    SendPacket(packet, requestorNode->GetIpAddress(), requestorNode->GetPort());
+  }
+}
+
+void
+ChordIpv4::ProcessHeartbeatAggRsp (ChordMessage chordMessage)
+{
+  ChordMessage::HeartbeatAggRsp &heartbeatAggRsp = chordMessage.GetHeartbeatAggRsp();
+  //Fan out to local vNodes
+  for (uint8_t i = 0; i < heartbeatAggRsp.heartbeatCount; i++)
+  {
+    Ptr<ChordVNode> virtualNode;
+    if (FindVNode(heartbeatAggRsp.requestorIdentifiers[i], virtualNode) == false)
+    {
+      continue;
+    }
+    //Reset timestamp
+    virtualNode->GetPredecessor()->SetTimestamp(Simulator::Now());
+    //Synch predecessor list
+    virtualNode->SynchPredecessorList (heartbeatAggRsp.heartbeatRsps[i].predecessorList);
+  }
+}
+
 void
 ChordIpv4::DumpDHashInfo (std::ostream &os)
 {
   m_dHashIpv4->DumpDHashInfo(os);
 }
 
+void
+ChordIpv4::GetVNodeLoads (std::vector<uint32_t> &loads)
+{
+  for(ChordNodeMap::iterator vNodeIter = m_vNodeMap.GetMap().begin(); vNodeIter != m_vNodeMap.GetMap().end(); vNodeIter++)
+  {
+    loads.push_back (GetVNodeLoad (DynamicCast<ChordVNode>((*vNodeIter).second)));
+  }
+}
+
+uint32_t
+ChordIpv4::GetRekeyCount (void)
+{
+  return m_rekeys;
+}
+
+ChordIpv4::MaintenanceStats&
+ChordIpv4::GetMaintenanceStats (void)
+{
+  return m_maintenanceStats;
+}
+
+Ptr<ChordTransport>
+ChordIpv4::GetTransport (void)
+{
+  return m_transport;
+}
+
+void
+ChordIpv4::PlaceNextVNode ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  //Place one vNode at a time, so that probes see the ring including our previous vNodes
+  if (!m_vNodePlacements.empty ())
+  {
+    return;
+  }
+  for (uint16_t i = 0; i < m_virtualNodes; i++)
+  {
+    std::ostringstream os;
+    os << "vnode" << i;
+    std::string vNodeName = os.str ();
+    Ptr<ChordNode> chordNode;
+    if (m_vNodeMap.FindNode (vNodeName, chordNode) == false)
+    {
+      PlaceVNode (vNodeName, false, 0);
+      return;
+    }
+  }
+}
+
+void
+ChordIpv4::PlaceVNode (std::string vNodeName, bool rekey, uint32_t currentLoad)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  VNodePlacement &placement = m_vNodePlacements[vNodeName];
+  placement.pendingProbes = m_placementChoices;
+  placement.bestIdentifier = 0;
+  placement.bestLoad = 0;
+  placement.rekey = rekey;
+  placement.currentLoad = currentLoad;
+
+  //Register all probes first, lookups may complete synchronously
+  std::vector<Ptr<ChordIdentifier> > probes;
+  for (uint8_t i = 0; i < m_placementChoices; i++)
+  {
+    uint8_t key[20];
+    for (uint8_t j = 0; j < sizeof (key); j++)
+    {
+      key[j] = m_placementRandom->GetInteger (0, 255);
+    }
+    Ptr<ChordIdentifier> probeIdentifier = Create<ChordIdentifier> (key, sizeof (key));
+    m_placementProbes[*probeIdentifier] = vNodeName;
+    probes.push_back (probeIdentifier);
+  }
+  placement.candidateIdentifier = probes[0];
+  for (std::vector<Ptr<ChordIdentifier> >::iterator iter = probes.begin (); iter != probes.end (); iter++)
+  {
+    DoLookup (*iter, ChordTransaction::LOAD_BALANCER);
+  }
+}
+
+void
+ChordIpv4::HandlePlacementProbe (Ptr<ChordIdentifier> probeIdentifier, bool success, uint32_t load)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::map<ChordIdentifier, std::string>::iterator probeIter = m_placementProbes.find (*probeIdentifier);
+  if (probeIter == m_placementProbes.end ())
+  {
+    return;
+  }
+  std::string vNodeName = probeIter->second;
+  m_placementProbes.erase (probeIter);
+  std::map<std::string, VNodePlacement>::iterator placementIter = m_vNodePlacements.find (vNodeName);
+  if (placementIter == m_vNodePlacements.end ())
+  {
+    return;
+  }
+  VNodePlacement &placement = placementIter->second;
+  //Split range of most loaded owner
+  if (success && (placement.bestIdentifier == 0 || load > placement.bestLoad))
+  {
+    placement.bestIdentifier = probeIdentifier;
+    placement.bestLoad = load;
+  }
+  if (--placement.pendingProbes == 0)
+  {
+    FinishPlacement (vNodeName);
+  }
+}
+
+void
+ChordIpv4::FinishPlacement (std::string vNodeName)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  VNodePlacement placement = m_vNodePlacements[vNodeName];
+  m_vNodePlacements.erase (vNodeName);
+  if (!placement.rekey)
+  {
+    //No probe succeeded (e.g. first vNode): join at random identifier
+    Ptr<ChordIdentifier> identifier = placement.bestIdentifier != 0 ? placement.bestIdentifier : placement.candidateIdentifier;
+    NS_LOG_INFO ("Placing " << vNodeName << " at " << identifier << " (owner load: " << placement.bestLoad << ")");
+    InsertVNode (vNodeName, identifier->GetKey (), identifier->GetNumBytes ());
+    return;
+  }
+  if (placement.bestIdentifier == 0 || placement.bestLoad <= m_loadImbalanceThreshold * std::max (placement.currentLoad, (uint32_t) 1))
+  {
+    return;
+  }
+  //Last vNode of bootstrap node would create a new ring on re-insert
+  if (isBootStrapNode && m_vNodeMap.GetSize () == 1)
+  {
+    return;
+  }
+  NS_LOG_INFO ("Re-keying " << vNodeName << " (load: " << placement.currentLoad << ") to " << placement.bestIdentifier << " (owner load: " << placement.bestLoad << ")");
+  RemoveVNode (vNodeName);
+  InsertVNode (vNodeName, placement.bestIdentifier->GetKey (), placement.bestIdentifier->GetNumBytes ());
+  m_rekeys++;
+  m_vNodeRekeyTrace (vNodeName, placement.currentLoad, placement.bestLoad);
+}
+
+void
+ChordIpv4::DoPeriodicLoadBalance ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  //Karger-Ruhl style: least loaded vNode moves into range of a heavily loaded node
+  if (m_vNodePlacements.empty () && m_vNodeMap.GetSize () == m_virtualNodes)
+  {
+    Ptr<ChordVNode> lightestVNode;
+    uint32_t lightestLoad = 0;
+    for (ChordNodeMap::iterator vNodeIter = m_vNodeMap.GetMap().begin(); vNodeIter != m_vNodeMap.GetMap().end(); vNodeIter++)
+    {
+      Ptr<ChordVNode> virtualNode = DynamicCast<ChordVNode>((*vNodeIter).second);
+      uint32_t load = GetVNodeLoad (virtualNode);
+      if (lightestVNode == 0 || load < lightestLoad)
+      {
+        lightestVNode = virtualNode;
+        lightestLoad = load;
+      }
+    }
+    if (lightestVNode != 0)
+    {
+      PlaceVNode (lightestVNode->GetVNodeName (), true, lightestLoad);
+    }
+  }
+  m_loadBalanceTimer.Schedule (m_loadBalanceInterval);
+}
+
+uint32_t
+ChordIpv4::GetVNodeLoad (Ptr<ChordVNode> virtualNode)
+{
+  if (!m_dHashEnable || virtualNode->GetPredecessor () == 0)
+  {
+    return 0;
+  }
+  return m_dHashIpv4->GetObjectCount (virtualNode->GetPredecessor ()->GetChordIdentifier (), virtualNode->GetChordIdentifier ());
+}
+
 void
 ChordIpv4::FixFingers (std::string vNodeName)
 {
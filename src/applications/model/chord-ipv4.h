@@ -25,11 +25,13 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/traced-callback.h"
 #include "ns3/timer.h"
+#include "ns3/random-variable-stream.h"
 #include "chord-identifier.h"
 #include "chord-node.h"
 #include "chord-vnode.h"
 #include "chord-message.h"
 #include "chord-node-table.h"
+#include "chord-transport.h"
 #include "dhash-ipv4.h"
 
 /* Static defines */
@@ -80,6 +82,54 @@ class ChordIpv4 : public Application
 
     virtual ~ChordIpv4 ();
 
+    /**
+     *  \brief Counters of sent ring maintenance messages
+     */
+    struct MaintenanceStats {
+    uint64_t heartbeatMessages;         //HEARTBEAT_REQ/RSP and HEARTBEAT_AGG_REQ/RSP
+    uint64_t aggregatedHeartbeats;      //VirtualNode heartbeats carried in HEARTBEAT_AGG_REQ
+    uint64_t stabilizeMessages;
+    uint64_t fingerMessages;
+    };
+
+    /**
+     *  \brief TracedCallback signature of Tx and Rx trace sources
+     *  \param messageType ChordMessage::MessageType
+     *  \param size Packet size in bytes
+     *  \param transactionId Transaction Id of message
+     *  \param hopCount Hop count carried in message
+     *  \param peer IP address of remote node
+     */
+    typedef void (* MessageTracedCallback) (uint8_t messageType, uint32_t size, uint32_t transactionId, uint8_t hopCount, Ipv4Address peer);
+    /**
+     *  \brief TracedCallback signature of LookupStart trace source
+     *  \param transactionId Transaction Id of lookup request (0 if resolved locally)
+     *  \param originator ChordTransaction::Originator
+     */
+    typedef void (* LookupStartTracedCallback) (uint32_t transactionId, uint8_t originator);
+    /**
+     *  \brief TracedCallback signature of LookupFinish trace source
+     *  \param transactionId Transaction Id of lookup request (0 if resolved locally)
+     *  \param hopCount Overlay hops taken by lookup request
+     *  \param latency Time elapsed since LookupStart
+     *  \param success Lookup result
+     */
+    typedef void (* LookupFinishTracedCallback) (uint32_t transactionId, uint8_t hopCount, Time latency, bool success);
+    /**
+     *  \brief TracedCallback signature of RequestTimeout trace source
+     *  \param messageType ChordMessage::MessageType of request
+     *  \param transactionId Transaction Id of request
+     *  \param retries Retransmissions done so far
+     */
+    typedef void (* RequestTimeoutTracedCallback) (uint8_t messageType, uint32_t transactionId, uint8_t retries);
+    /**
+     *  \brief TracedCallback signature of VNodeRekey trace source
+     *  \param vNodeName VirtualNode(ChordVNode) name
+     *  \param load Load of VirtualNode(ChordVNode) before re-keying
+     *  \param targetLoad Load of VirtualNode(ChordVNode) whose range is split
+     */
+    typedef void (* VNodeRekeyTracedCallback) (std::string vNodeName, uint32_t load, uint32_t targetLoad);
+
 
 
     /* Application interface (ChordIpv4 Service User) */
@@ -143,6 +193,13 @@ class ChordIpv4 : public Application
      *  \param lookupSuccessFn This Callback is passed vNodeName, key and numBytes of key as parameters.
      */
     void SetLookupSuccessCallback (Callback <void, uint8_t*, uint8_t, Ipv4Address, uint16_t> lookupSuccessFn);
+    /**
+     *  \brief Registers Callback function for Lookup Success Notifications carrying identifier of the owner.
+     *  \param lookupOwnerFn This Callback is passed lookup key, numBytes of lookup key, identifier of owner VirtualNode(ChordVNode), numBytes of owner identifier, resolved IP and resolved port as parameters.
+     *
+     *  Owner is the successor of the requested identifier, which equals the identifier only if some VirtualNode(ChordVNode) was inserted with it.
+     */
+    void SetLookupOwnerCallback (Callback <void, uint8_t*, uint8_t, uint8_t*, uint8_t, Ipv4Address, uint16_t> lookupOwnerFn);
     /**
      *  \brief Registers Callback function for Lookup Failure Notifications.
      *  \param lookupFailureFn This Callback is passed lookup key, numBytes of lookup key, resolved IP and resolved port as parameters.
@@ -268,6 +325,26 @@ class ChordIpv4 : public Application
      *  Dumps information regarding stored DHashObject (s), active transactions and number of active TCP connections
      */
     void DumpDHashInfo (std::ostream &os);
+    /**
+     *  \brief Appends load of every local VirtualNode(ChordVNode) to given vector
+     *  \param loads Vector of loads
+     *
+     *  Load of a VirtualNode(ChordVNode) is the number of stored DHashObject (s) with identifier in range (predecessor, VirtualNode]. Collecting loads of all ChordIpv4
+     *  instances gives max/mean load ratio of the network.
+     */
+    void GetVNodeLoads (std::vector<uint32_t> &loads);
+    /**
+     *  \returns Number of VirtualNode(ChordVNode) re-keys done by load balancing
+     */
+    uint32_t GetRekeyCount (void);
+    /**
+     *  \returns Counters of ring maintenance messages sent by this node
+     */
+    MaintenanceStats& GetMaintenanceStats (void);
+    /**
+     *  \returns ChordTransport used to carry Chord protocol messages (null before application start)
+     */
+    Ptr<ChordTransport> GetTransport (void);
 
   protected:
     virtual void DoDispose (void);
@@ -280,7 +357,8 @@ class ChordIpv4 : public Application
      */
     bool m_dHashEnable;
 
-    Ptr<Socket> m_socket;
+    TypeId m_transportTid;
+    Ptr<ChordTransport> m_transport;
     Ipv4Address m_bootStrapIp;
     uint16_t m_bootStrapPort;
     Ipv4Address m_localIpAddress;
@@ -301,6 +379,8 @@ class ChordIpv4 : public Application
     Time m_stabilizeInterval;
     Timer m_heartbeatTimer;
     Time m_heartbeatInterval;
+    bool m_aggregateHeartbeats;
+    MaintenanceStats m_maintenanceStats;
     Timer m_fixFingerTimer;
     Time m_fixFingerInterval;
   
@@ -323,6 +403,7 @@ class ChordIpv4 : public Application
     //Callbacks
     Callback<void, std::string, uint8_t*, uint8_t> m_joinSuccessFn;
     Callback<void, uint8_t*, uint8_t, Ipv4Address, uint16_t> m_lookupSuccessFn;
+    Callback<void, uint8_t*, uint8_t, uint8_t*, uint8_t, Ipv4Address, uint16_t> m_lookupOwnerFn;
     Callback<void, uint8_t*, uint8_t> m_lookupFailureFn;
     Callback<void, std::string, uint8_t*, uint8_t, uint8_t*, uint8_t, uint8_t*, uint8_t, Ipv4Address, uint16_t> m_vNodeKeyOwnershipFn;
     Callback<void, std::string, uint8_t*, uint8_t> m_traceRingFn;
@@ -340,7 +421,7 @@ class ChordIpv4 : public Application
 
     //Upcall (notify) methods
     void NotifyJoinSuccess (std::string vNodeName, Ptr<ChordIdentifier> chordIdentifier);
-    void NotifyLookupSuccess (Ptr<ChordIdentifier> lookupIdentifier, Ptr<ChordNode> resolvedNode, ChordTransaction::Originator originator);
+    void NotifyLookupSuccess (Ptr<ChordIdentifier> lookupIdentifier, Ptr<ChordNode> resolvedNode, ChordTransaction::Originator originator, uint32_t load);
     void NotifyLookupFailure (Ptr<ChordIdentifier> chordIdentifier, ChordTransaction::Originator originator);
     void NotifyVNodeKeyOwnership (std::string vNodeName, Ptr<ChordIdentifier> chordIdentifier, Ptr<ChordNode> predecessorNode, Ptr<ChordIdentifier> oldPredecessorIdentifier);
     void NotifyTraceRing (std::string vNodeName, Ptr<ChordIdentifier> chordIdentifier);
@@ -355,7 +436,7 @@ class ChordIpv4 : public Application
     void NotifyRetrieveFailure (uint8_t* key, uint8_t keyBytes);
 
     //Message processing methods
-    void ProcessUdpPacket (Ptr<Socket> socket);
+    void ProcessPacket (Ptr<Packet> packet, Ipv4Address fromIpAddress, uint16_t fromPort);
     void ProcessJoinReq (ChordMessage chordMessage);
     void ProcessJoinRsp (ChordMessage chordMessage);
     void ProcessLeaveReq (ChordMessage chordMessage);
@@ -366,6 +447,8 @@ class ChordIpv4 : public Application
     void ProcessStabilizeRsp (ChordMessage chordMessage);
     void ProcessHeartbeatReq (ChordMessage chordMessage);
     void ProcessHeartbeatRsp (ChordMessage chordMessage);
+    void ProcessHeartbeatAggReq (ChordMessage chordMessage);
+    void ProcessHeartbeatAggRsp (ChordMessage chordMessage);
     void ProcessFingerReq (ChordMessage chordMessage);
     void ProcessFingerRsp (ChordMessage chordMessage);
     void ProcessTraceRing (ChordMessage chordMessage);
@@ -374,6 +457,7 @@ class ChordIpv4 : public Application
     void DoLookup (Ptr<ChordIdentifier> requestedIdentifier, ChordTransaction::Originator orginator);
     void DoStabilize (Ptr<ChordVNode> virtualNode);
     void DoHeartbeat (Ptr<ChordVNode> virtualNode);
+    void DoAggregatedHeartbeat (std::vector<Ptr<ChordVNode> > &virtualNodes);
     void DoFixFinger (Ptr<ChordVNode> virtualNode);
 
     bool FindVNode (Ptr<ChordIdentifier> chordIdentifier, Ptr<ChordVNode>& virtualNode);
@@ -392,7 +476,39 @@ class ChordIpv4 : public Application
     //Timeouts
     void HandleRequestTimeout (Ptr<ChordVNode> chordVNode, uint32_t transactionId);
 
-    //TODO: Trace call back(s)
+    //Load balancing
+    struct VNodePlacement {
+    uint8_t pendingProbes;
+    Ptr<ChordIdentifier> candidateIdentifier;
+    Ptr<ChordIdentifier> bestIdentifier;
+    uint32_t bestLoad;
+    bool rekey;
+    uint32_t currentLoad;
+    };
+    uint16_t m_virtualNodes;
+    uint8_t m_placementChoices;
+    Time m_loadBalanceInterval;
+    double m_loadImbalanceThreshold;
+    Timer m_loadBalanceTimer;
+    Ptr<UniformRandomVariable> m_placementRandom;
+    uint32_t m_rekeys;
+    std::map<std::string, VNodePlacement> m_vNodePlacements;
+    std::map<ChordIdentifier, std::string> m_placementProbes;
+
+    void PlaceNextVNode ();
+    void PlaceVNode (std::string vNodeName, bool rekey, uint32_t currentLoad);
+    void HandlePlacementProbe (Ptr<ChordIdentifier> probeIdentifier, bool success, uint32_t load);
+    void FinishPlacement (std::string vNodeName);
+    void DoPeriodicLoadBalance ();
+    uint32_t GetVNodeLoad (Ptr<ChordVNode> virtualNode);
+
+    //Trace callbacks
+    TracedCallback<uint8_t, uint32_t, uint32_t, uint8_t, Ipv4Address> m_txTrace;
+    TracedCallback<uint8_t, uint32_t, uint32_t, uint8_t, Ipv4Address> m_rxTrace;
+    TracedCallback<uint32_t, uint8_t> m_lookupStartTrace;
+    TracedCallback<uint32_t, uint8_t, Time, bool> m_lookupFinishTrace;
+    TracedCallback<uint8_t, uint32_t, uint8_t> m_requestTimeoutTrace;
+    TracedCallback<std::string, uint32_t, uint32_t> m_vNodeRekeyTrace;
     /**
      *  \endcond
      */
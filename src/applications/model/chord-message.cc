@@ -29,6 +29,7 @@ NS_OBJECT_ENSURE_REGISTERED (ChordMessage);
 ChordMessage::ChordMessage ()
 {
   m_transactionId = 0;
+  m_hopCount = 0;
 }
 
 ChordMessage::~ChordMessage ()
@@ -87,6 +88,12 @@ ChordMessage::GetSerializedSize (void) const
     case HEARTBEAT_RSP:
       size += m_message.heartbeatRsp.GetSerializedSize ();
       break;
+    case HEARTBEAT_AGG_REQ:
+      size += m_message.heartbeatAggReq.GetSerializedSize ();
+      break;
+    case HEARTBEAT_AGG_RSP:
+      size += m_message.heartbeatAggRsp.GetSerializedSize ();
+      break;
     case LOOKUP_REQ:
       size += m_message.lookupReq.GetSerializedSize ();
       break;
@@ -111,7 +118,7 @@ ChordMessage::Print (std::ostream &os) const
   os << "TransactionId: " << m_transactionId<<"\n";
   os << "Requestor Node: " << "\n";
   m_chordNode->Print (os);
-  os << "TTL : " << m_ttl << "\n";
+  os << "HopCount: " << (uint16_t) m_hopCount << "\n";
   os << "Payload:: \n";
   switch (m_messageType)
   {
@@ -145,6 +152,12 @@ ChordMessage::Print (std::ostream &os) const
     case HEARTBEAT_RSP:
       m_message.heartbeatRsp.Print (os);
       break;
+    case HEARTBEAT_AGG_REQ:
+      m_message.heartbeatAggReq.Print (os);
+      break;
+    case HEARTBEAT_AGG_RSP:
+      m_message.heartbeatAggRsp.Print (os);
+      break;
     case LOOKUP_REQ:
       m_message.lookupReq.Print (os);
       break;
@@ -165,7 +178,7 @@ ChordMessage::Serialize (Buffer::Iterator start) const
 {
   Buffer::Iterator i = start;  
   i.WriteU8 (m_messageType);
-  i.WriteU8  (m_ttl);
+  i.WriteU8 (m_hopCount);
   i.WriteHtonU32 (m_transactionId);
   m_chordNode->Serialize(i);
   switch (m_messageType)
@@ -200,6 +213,12 @@ ChordMessage::Serialize (Buffer::Iterator start) const
     case HEARTBEAT_RSP:
       m_message.heartbeatRsp.Serialize (i);
       break;
+    case HEARTBEAT_AGG_REQ:
+      m_message.heartbeatAggReq.Serialize (i);
+      break;
+    case HEARTBEAT_AGG_RSP:
+      m_message.heartbeatAggRsp.Serialize (i);
+      break;
     case LOOKUP_REQ:
       m_message.lookupReq.Serialize (i);
       break;
@@ -220,7 +239,7 @@ ChordMessage::Deserialize (Buffer::Iterator start)
   uint32_t size;
   Buffer::Iterator i = start;
   m_messageType = (MessageType) i.ReadU8 ();
-  m_ttl = i.ReadU8 ();
+  m_hopCount = i.ReadU8 ();
   m_transactionId = i.ReadNtohU32 ();
   m_chordNode = Create<ChordNode> ();
   m_chordNode->Deserialize (i);
@@ -258,6 +277,12 @@ ChordMessage::Deserialize (Buffer::Iterator start)
     case HEARTBEAT_RSP:
       size += m_message.heartbeatRsp.Deserialize (i);
       break;
+    case HEARTBEAT_AGG_REQ:
+      size += m_message.heartbeatAggReq.Deserialize (i);
+      break;
+    case HEARTBEAT_AGG_RSP:
+      size += m_message.heartbeatAggRsp.Deserialize (i);
+      break;
     case LOOKUP_REQ:
       size += m_message.lookupReq.Deserialize (i);
       break;
@@ -645,6 +670,107 @@ ChordMessage::HeartbeatRsp::Deserialize (Buffer::Iterator &start)
   return GetSerializedSize ();
 }
 
+/* HEARTBEAT_AGG_REQ */
+uint32_t
+ChordMessage::HeartbeatAggReq::GetSerializedSize (void) const
+{
+  uint32_t size;
+  size = sizeof(uint8_t);
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    size = size + requestorIdentifiers[i]->GetSerializedSize() + predecessorIdentifiers[i]->GetSerializedSize();
+  }
+  return size; 
+}
+
+void
+ChordMessage::HeartbeatAggReq::Print (std::ostream &os) const
+{
+  os << "HeartbeatAggReq: \n";
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    os << "requestorIdentifier: " << requestorIdentifiers[i] << "\n";
+    os << "predecessorIdentifier: " << predecessorIdentifiers[i] << "\n";
+  }
+}
+
+void
+ChordMessage::HeartbeatAggReq::Serialize (Buffer::Iterator &start) const
+{
+  start.WriteU8 (heartbeatCount);
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    requestorIdentifiers[i]->Serialize(start);
+    predecessorIdentifiers[i]->Serialize(start);
+  }
+}
+
+uint32_t
+ChordMessage::HeartbeatAggReq::Deserialize (Buffer::Iterator &start)
+{
+  heartbeatCount = start.ReadU8 ();
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    Ptr<ChordIdentifier> requestorIdentifier = Create<ChordIdentifier> ();
+    requestorIdentifier->Deserialize(start);
+    requestorIdentifiers.push_back (requestorIdentifier);
+    Ptr<ChordIdentifier> predecessorIdentifier = Create<ChordIdentifier> ();
+    predecessorIdentifier->Deserialize(start);
+    predecessorIdentifiers.push_back (predecessorIdentifier);
+  }
+  return GetSerializedSize ();
+}
+
+/* HEARTBEAT_AGG_RSP */
+uint32_t
+ChordMessage::HeartbeatAggRsp::GetSerializedSize (void) const
+{
+  uint32_t size;
+  size = sizeof(uint8_t);
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    size = size + requestorIdentifiers[i]->GetSerializedSize() + heartbeatRsps[i].GetSerializedSize();
+  }
+  return size; 
+}
+
+void
+ChordMessage::HeartbeatAggRsp::Print (std::ostream &os) const
+{
+  os << "HeartbeatAggRsp: \n";
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    os << "requestorIdentifier: " << requestorIdentifiers[i] << "\n";
+    heartbeatRsps[i].Print (os);
+  }
+}
+
+void
+ChordMessage::HeartbeatAggRsp::Serialize (Buffer::Iterator &start) const
+{
+  start.WriteU8 (heartbeatCount);
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    requestorIdentifiers[i]->Serialize(start);
+    heartbeatRsps[i].Serialize(start);
+  }
+}
+
+uint32_t
+ChordMessage::HeartbeatAggRsp::Deserialize (Buffer::Iterator &start)
+{
+  heartbeatCount = start.ReadU8 ();
+  heartbeatRsps.resize (heartbeatCount);
+  for (uint8_t i = 0; i < heartbeatCount; i++)
+  {
+    Ptr<ChordIdentifier> requestorIdentifier = Create<ChordIdentifier> ();
+    requestorIdentifier->Deserialize(start);
+    requestorIdentifiers.push_back (requestorIdentifier);
+    heartbeatRsps[i].Deserialize(start);
+  }
+  return GetSerializedSize ();
+}
+
 /* LOOKUP_REQ */
 uint32_t
 ChordMessage::LookupReq::GetSerializedSize (void) const
@@ -679,7 +805,7 @@ uint32_t
 ChordMessage::LookupRsp::GetSerializedSize (void) const
 {
   uint32_t size;
-  size = resolvedNode->GetSerializedSize();
+  size = resolvedNode->GetSerializedSize() + sizeof (uint32_t);
   return size; 
 }
 
@@ -689,12 +815,14 @@ ChordMessage::LookupRsp::Print (std::ostream &os) const
   os << "LookupRsp: \n";
   os << "Resolved Node: " << "\n";
   resolvedNode->Print (os);
+  os << "Load: " << load << "\n";
 }
 
 void
 ChordMessage::LookupRsp::Serialize (Buffer::Iterator &start) const
 {
   resolvedNode->Serialize (start);
+  start.WriteHtonU32 (load);
 }
 
 uint32_t
@@ -702,6 +830,7 @@ ChordMessage::LookupRsp::Deserialize (Buffer::Iterator &start)
 {
   resolvedNode = Create<ChordNode> ();
   resolvedNode->Deserialize (start);
+  load = start.ReadNtohU32 ();
   return GetSerializedSize ();
 }
 
@@ -50,6 +50,8 @@ class ChordMessage : public Header
       LOOKUP_RSP = 10,
       LEAVE_REQ = 11,
       LEAVE_RSP = 12,
+      HEARTBEAT_AGG_REQ = 13,
+      HEARTBEAT_AGG_RSP = 14,
       TRACE_RING = 20,
     };
 
@@ -74,14 +76,26 @@ class ChordMessage : public Header
       m_transactionId = transactionId;
     }
     /**
-     *  \brief Sets TTL
-     *  \param ttl time to live before request is dropped
-     *  Coming Soon!
+     *  \brief Sets hop count
+     *  \param hopCount number of times request has been forwarded in overlay
      */
-    void SetTTL(uint8_t ttl)
+    void SetHopCount (uint8_t hopCount)
     {
-      m_ttl = ttl;
-    } 
+      m_hopCount = hopCount;
+    }
+    /**
+     *  \brief Increments hop count, saturating at 255
+     *  \returns false if hop count had already saturated; forwarded requests are dropped then, as they are looping
+     */
+    bool IncrementHopCount ()
+    {
+      if (m_hopCount < 255)
+      {
+        m_hopCount++;
+        return true;
+      }
+      return false;
+    }
     /**
      *  \returns message type
      */
@@ -115,12 +129,12 @@ class ChordMessage : public Header
       return m_chordNode;
     }
     /**
-     *  \returns ttl of request
+     *  \returns hop count of request (for responses, hops taken by corresponding request)
      */
-    uint8_t GetTTL()
+    uint8_t GetHopCount ()
     {
-      return m_ttl;
-    } 
+      return m_hopCount;
+    }
 
   private:
     /**
@@ -129,7 +143,7 @@ class ChordMessage : public Header
     MessageType m_messageType;
     uint32_t m_transactionId;
     Ptr<ChordNode> m_chordNode;
-    uint8_t m_ttl ;
+    uint8_t m_hopCount;
     /**
      *  \endcond
      */
@@ -159,7 +173,7 @@ class ChordMessage : public Header
         +-+-+-+-+-+-+-+-+
         |  messageType  |
         +-+-+-+-+-+-+-+-+
-        |     ttl       |
+        |   hopCount    |
         +-+-+-+-+-+-+-+-+
         |               |
         |               |
@@ -379,6 +393,36 @@ class ChordMessage : public Header
       uint32_t Deserialize (Buffer::Iterator &start);
     };
 
+    /**
+     *  \brief Heartbeats of several VirtualNodes whose predecessors share one IP:port
+     *
+     *  Entry i checks predecessorIdentifiers[i] on behalf of local VirtualNode requestorIdentifiers[i]
+     */
+    struct HeartbeatAggReq
+    {
+      uint8_t heartbeatCount;
+      std::vector<Ptr<ChordIdentifier> > requestorIdentifiers;
+      std::vector<Ptr<ChordIdentifier> > predecessorIdentifiers;
+      void Print (std::ostream &os) const; 
+      uint32_t GetSerializedSize (void) const;
+      void Serialize (Buffer::Iterator &start) const;
+      uint32_t Deserialize (Buffer::Iterator &start);
+    };
+
+    /**
+     *  \brief Answers to HeartbeatAggReq, one entry per VirtualNode found at responder
+     */
+    struct HeartbeatAggRsp
+    {
+      uint8_t heartbeatCount;
+      std::vector<Ptr<ChordIdentifier> > requestorIdentifiers;
+      std::vector<HeartbeatRsp> heartbeatRsps;
+      void Print (std::ostream &os) const; 
+      uint32_t GetSerializedSize (void) const;
+      void Serialize (Buffer::Iterator &start) const;
+      uint32_t Deserialize (Buffer::Iterator &start);
+    };
+
     struct LookupReq
     {
       Ptr<ChordIdentifier> requestedIdentifier;
@@ -391,6 +435,7 @@ class ChordMessage : public Header
     struct LookupRsp
     {
       Ptr<ChordNode> resolvedNode;
+      uint32_t load;            //DHash objects owned by resolvedNode
       void Print (std::ostream &os) const; 
       uint32_t GetSerializedSize (void) const;
       void Serialize (Buffer::Iterator &start) const;
@@ -442,6 +487,8 @@ class ChordMessage : public Header
       FingerRsp fingerRsp;
       HeartbeatReq heartbeatReq;
       HeartbeatRsp heartbeatRsp;
+      HeartbeatAggReq heartbeatAggReq;
+      HeartbeatAggRsp heartbeatAggRsp;
       LookupReq lookupReq;
       LookupRsp lookupRsp;
       TraceRing traceRing;
@@ -612,6 +659,38 @@ class ChordMessage : public Header
       return m_message.heartbeatRsp;
     }
 
+    /**
+     *  \returns HeartbeatAggReq structure
+     */    
+    HeartbeatAggReq& GetHeartbeatAggReq ()
+    {
+      if (m_messageType == 0)
+      {
+        m_messageType = HEARTBEAT_AGG_REQ;
+      }
+      else
+      {
+        NS_ASSERT (m_messageType == HEARTBEAT_AGG_REQ);
+      }
+      return m_message.heartbeatAggReq;
+    }
+
+    /**
+     *  \returns HeartbeatAggRsp structure
+     */    
+    HeartbeatAggRsp& GetHeartbeatAggRsp ()
+    {
+      if (m_messageType == 0)
+      {
+        m_messageType = HEARTBEAT_AGG_RSP;
+      }
+      else
+      {
+        NS_ASSERT (m_messageType == HEARTBEAT_AGG_RSP);
+      }
+      return m_message.heartbeatAggRsp;
+    }
+
     /**
      *  \returns LookupReq structure
      */    
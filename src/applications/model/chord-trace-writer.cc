@@ -0,0 +1,204 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string.h>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
+#include "chord-trace-writer.h"
+#include "chord-ipv4.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ChordTraceWriter");
+NS_OBJECT_ENSURE_REGISTERED (ChordTraceWriter);
+
+//Version of on-disk format
+static const uint32_t CHORD_TRACE_VERSION = 1;
+
+TypeId
+ChordTraceWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ChordTraceWriter")
+    .SetParent<Object> ()
+    .AddConstructor<ChordTraceWriter> ()
+    .AddAttribute ("BufferSize",
+                   "Number of records buffered in memory before writing to file",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&ChordTraceWriter::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    ;
+  return tid;
+}
+
+ChordTraceWriter::ChordTraceWriter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_bufferSize = 4096;
+  m_records = 0;
+}
+
+ChordTraceWriter::~ChordTraceWriter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+ChordTraceWriter::DoDispose (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Close ();
+  Object::DoDispose ();
+}
+
+bool
+ChordTraceWriter::Open (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  Close ();
+  m_file.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open ())
+  {
+    NS_LOG_ERROR ("Can not open trace file " << fileName);
+    return false;
+  }
+  FileHeader header;
+  memcpy (header.magic, "CHTR", sizeof (header.magic));
+  header.version = CHORD_TRACE_VERSION;
+  header.recordSize = sizeof (Record);
+  m_file.write ((const char*) &header, sizeof (header));
+  m_buffer.reserve (m_bufferSize);
+  return true;
+}
+
+void
+ChordTraceWriter::Connect (Ptr<ChordIpv4> chordIpv4)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  uint32_t nodeId = chordIpv4->GetNode ()->GetId ();
+  //Bind node id, so that events of all nodes can share one writer
+  chordIpv4->TraceConnectWithoutContext ("Tx", MakeCallback (&ChordTraceWriter::TraceTx, this).Bind (nodeId));
+  chordIpv4->TraceConnectWithoutContext ("Rx", MakeCallback (&ChordTraceWriter::TraceRx, this).Bind (nodeId));
+  chordIpv4->TraceConnectWithoutContext ("LookupStart", MakeCallback (&ChordTraceWriter::TraceLookupStart, this).Bind (nodeId));
+  chordIpv4->TraceConnectWithoutContext ("LookupFinish", MakeCallback (&ChordTraceWriter::TraceLookupFinish, this).Bind (nodeId));
+  chordIpv4->TraceConnectWithoutContext ("RequestTimeout", MakeCallback (&ChordTraceWriter::TraceRequestTimeout, this).Bind (nodeId));
+}
+
+void
+ChordTraceWriter::Flush (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_file.is_open () && m_buffer.size ())
+  {
+    m_file.write ((const char*) &m_buffer[0], m_buffer.size () * sizeof (Record));
+  }
+  m_buffer.clear ();
+}
+
+void
+ChordTraceWriter::Close (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_file.is_open ())
+  {
+    Flush ();
+    m_file.close ();
+  }
+}
+
+uint64_t
+ChordTraceWriter::GetRecordCount (void)
+{
+  return m_records;
+}
+
+bool
+ChordTraceWriter::ReadHeader (std::istream &is)
+{
+  FileHeader header;
+  if (!is.read ((char*) &header, sizeof (header)))
+  {
+    return false;
+  }
+  return memcmp (header.magic, "CHTR", sizeof (header.magic)) == 0 && header.version == CHORD_TRACE_VERSION && header.recordSize == sizeof (Record);
+}
+
+ChordTraceWriter::Record&
+ChordTraceWriter::NewRecord (uint8_t event, uint32_t nodeId, uint32_t transactionId)
+{
+  if (m_buffer.size () >= m_bufferSize)
+  {
+    Flush ();
+  }
+  m_buffer.push_back (Record ());
+  m_records++;
+  Record &record = m_buffer.back ();
+  memset (&record, 0, sizeof (record));
+  record.time = Simulator::Now ().GetNanoSeconds ();
+  record.event = event;
+  record.nodeId = nodeId;
+  record.transactionId = transactionId;
+  return record;
+}
+
+void
+ChordTraceWriter::TraceTx (uint32_t nodeId, uint8_t messageType, uint32_t size, uint32_t transactionId, uint8_t hopCount, Ipv4Address peer)
+{
+  Record &record = NewRecord (TX, nodeId, transactionId);
+  record.messageType = messageType;
+  record.value = size;
+  record.hopCount = hopCount;
+  record.peer = peer.Get ();
+}
+
+void
+ChordTraceWriter::TraceRx (uint32_t nodeId, uint8_t messageType, uint32_t size, uint32_t transactionId, uint8_t hopCount, Ipv4Address peer)
+{
+  Record &record = NewRecord (RX, nodeId, transactionId);
+  record.messageType = messageType;
+  record.value = size;
+  record.hopCount = hopCount;
+  record.peer = peer.Get ();
+}
+
+void
+ChordTraceWriter::TraceLookupStart (uint32_t nodeId, uint32_t transactionId, uint8_t originator)
+{
+  Record &record = NewRecord (LOOKUP_START, nodeId, transactionId);
+  record.value = originator;
+}
+
+void
+ChordTraceWriter::TraceLookupFinish (uint32_t nodeId, uint32_t transactionId, uint8_t hopCount, Time latency, bool success)
+{
+  Record &record = NewRecord (LOOKUP_FINISH, nodeId, transactionId);
+  record.value = latency.GetMicroSeconds ();
+  record.hopCount = hopCount;
+  record.flags = success;
+}
+
+void
+ChordTraceWriter::TraceRequestTimeout (uint32_t nodeId, uint8_t messageType, uint32_t transactionId, uint8_t retries)
+{
+  Record &record = NewRecord (REQUEST_TIMEOUT, nodeId, transactionId);
+  record.messageType = messageType;
+  record.value = retries;
+}
+
+} //namespace ns3
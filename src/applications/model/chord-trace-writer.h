@@ -0,0 +1,146 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHORD_TRACE_WRITER_H
+#define CHORD_TRACE_WRITER_H
+
+#include <stdint.h>
+#include <fstream>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+class ChordIpv4;
+
+/**
+ *  \ingroup chordipv4
+ *  \class ChordTraceWriter
+ *  \brief Writes ChordIpv4 trace sources to a binary file
+ *
+ *  Every trace event (Tx, Rx, LookupStart, LookupFinish, RequestTimeout) becomes one fixed-size ChordTraceWriter::Record.
+ *  Records are collected in memory and written in blocks of BufferSize records, so tracing costs one copy per event. The
+ *  file starts with a ChordTraceWriter::FileHeader; all fields are stored in host byte order.
+ *
+ *  The writer must stay alive until the simulation is over. Remaining records are written on Close () (or on dispose).
+ *  See examples/chord-run/chord-trace-analyze.cc for an offline reader.
+ */
+class ChordTraceWriter : public Object
+{
+  public:
+    enum Event {
+      TX = 1,
+      RX = 2,
+      LOOKUP_START = 3,
+      LOOKUP_FINISH = 4,
+      REQUEST_TIMEOUT = 5,
+    };
+
+    /**
+     *  \brief Header at start of trace file
+     */
+    struct FileHeader {
+    char magic[4];              //"CHTR"
+    uint32_t version;
+    uint32_t recordSize;
+    };
+
+    /**
+     *  \brief Trace record
+     *
+     *  Meaning of value depends on event: packet size in bytes (TX/RX), originator (LOOKUP_START), latency in
+     *  microseconds (LOOKUP_FINISH) or retries done (REQUEST_TIMEOUT). flags is 1 for successful lookups.
+     */
+    struct Record {
+    uint64_t time;              //Simulation time in nanoseconds
+    uint32_t nodeId;
+    uint32_t transactionId;
+    uint32_t value;
+    uint32_t peer;              //Remote Ipv4Address (TX/RX)
+    uint8_t event;
+    uint8_t messageType;
+    uint8_t hopCount;
+    uint8_t flags;
+    uint32_t reserved;
+    };
+
+    static TypeId GetTypeId (void);
+
+    ChordTraceWriter ();
+    virtual ~ChordTraceWriter ();
+
+    /**
+     *  \brief Opens (truncates) trace file and writes FileHeader
+     *  \param fileName Name of trace file
+     *  \returns false if file can not be opened
+     */
+    bool Open (std::string fileName);
+    /**
+     *  \brief Connects writer to all trace sources of a ChordIpv4 application
+     *  \param chordIpv4 Ptr to ChordIpv4 installed on a Node
+     */
+    void Connect (Ptr<ChordIpv4> chordIpv4);
+    /**
+     *  \brief Writes buffered records to file
+     */
+    void Flush (void);
+    /**
+     *  \brief Flushes and closes trace file
+     */
+    void Close (void);
+    /**
+     *  \returns Number of records traced so far
+     */
+    uint64_t GetRecordCount (void);
+
+    /**
+     *  \brief Reads and checks FileHeader of a trace file
+     *  \param is Input stream positioned at start of file
+     *  \returns false if stream does not hold a trace of this version
+     */
+    static bool ReadHeader (std::istream &is);
+
+  protected:
+    virtual void DoDispose (void);
+
+  private:
+    /**
+     *  \cond
+     */
+    void TraceTx (uint32_t nodeId, uint8_t messageType, uint32_t size, uint32_t transactionId, uint8_t hopCount, Ipv4Address peer);
+    void TraceRx (uint32_t nodeId, uint8_t messageType, uint32_t size, uint32_t transactionId, uint8_t hopCount, Ipv4Address peer);
+    void TraceLookupStart (uint32_t nodeId, uint32_t transactionId, uint8_t originator);
+    void TraceLookupFinish (uint32_t nodeId, uint32_t transactionId, uint8_t hopCount, Time latency, bool success);
+    void TraceRequestTimeout (uint32_t nodeId, uint8_t messageType, uint32_t transactionId, uint8_t retries);
+    Record& NewRecord (uint8_t event, uint32_t nodeId, uint32_t transactionId);
+
+    std::ofstream m_file;
+    std::vector<Record> m_buffer;
+    uint32_t m_bufferSize;
+    uint64_t m_records;
+    /**
+     *  \endcond
+     */
+};
+
+} //namespace ns3
+
+#endif //CHORD_TRACE_WRITER_H
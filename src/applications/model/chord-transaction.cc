@@ -31,7 +31,9 @@ ChordTransaction::ChordTransaction (uint32_t transactionId, ChordMessage chordMe
   m_chordMessage = chordMessage;
   m_requestTimeout = requestTimeout;
   m_maxRetries = maxRequestRetries;
+  m_retries = 0;
   m_requestTimeoutEventId = EventId ();
+  m_startTime = Simulator::Now ();
 }
 
 ChordTransaction::~ChordTransaction ()
@@ -129,6 +131,12 @@ ChordTransaction::GetRequestedIdentifier ()
   return m_requestedIdentifier;
 }
 
+Time
+ChordTransaction::GetStartTime ()
+{
+  return m_startTime;
+}
+
 void
 ChordTransaction::SetRequestedIdentifier (Ptr<ChordIdentifier> requestedIdentifier)
 {
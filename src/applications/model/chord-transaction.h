@@ -41,6 +41,7 @@ class ChordTransaction : public Object
     enum Originator {
       APPLICATION = 1,
       DHASH = 2,
+      LOAD_BALANCER = 3,
     };
 
     /**
@@ -115,6 +116,10 @@ class ChordTransaction : public Object
      *  \return Ptr to requested ChordIdentifier
      */
     Ptr<ChordIdentifier> GetRequestedIdentifier ();
+    /**
+     *  \returns Simulation time at which transaction was created
+     */
+    Time GetStartTime ();
 
   private:
     /**
@@ -122,6 +127,7 @@ class ChordTransaction : public Object
      */ 
     Ptr<ChordIdentifier> m_requestedIdentifier;
     Time  m_requestTimeout;
+    Time m_startTime;
     EventId m_requestTimeoutEventId;
     uint32_t m_transactionId;
     uint8_t m_retries;
@@ -0,0 +1,91 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "chord-transport.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ChordTransport");
+NS_OBJECT_ENSURE_REGISTERED (ChordTransport);
+
+TypeId
+ChordTransport::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ChordTransport")
+    .SetParent<Object> ()
+    ;
+  return tid;
+}
+
+ChordTransport::ChordTransport ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_stats.txMessages = 0;
+  m_stats.txBytes = 0;
+  m_stats.rxMessages = 0;
+  m_stats.rxBytes = 0;
+}
+
+ChordTransport::~ChordTransport ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+ChordTransport::DoDispose (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_recvFn = MakeNullCallback<void, Ptr<Packet>, Ipv4Address, uint16_t> ();
+  Object::DoDispose ();
+}
+
+void
+ChordTransport::SetRecvCallback (Callback<void, Ptr<Packet>, Ipv4Address, uint16_t> recvFn)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_recvFn = recvFn;
+}
+
+ChordTransport::TransportStats&
+ChordTransport::GetStats ()
+{
+  return m_stats;
+}
+
+void
+ChordTransport::NotifyRecv (Ptr<Packet> packet, Ipv4Address fromIp, uint16_t fromPort)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_stats.rxMessages++;
+  m_stats.rxBytes += packet->GetSize ();
+  if (!m_recvFn.IsNull ())
+  {
+    m_recvFn (packet, fromIp, fromPort);
+  }
+}
+
+void
+ChordTransport::NotifySend (uint32_t bytes)
+{
+  m_stats.txMessages++;
+  m_stats.txBytes += bytes;
+}
+
+} //namespace ns3
@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHORD_TRANSPORT_H
+#define CHORD_TRANSPORT_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/callback.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+class Node;
+class Packet;
+
+/**
+ *  \ingroup chordipv4
+ *  \class ChordTransport
+ *  \brief Carrier of ChordMessage packets between ChordIpv4 instances
+ *
+ *  ChordIpv4 never touches sockets directly; every Chord protocol message is handed to a ChordTransport together with the
+ *  (Ipv4Address, port) locator of the remote ChordNode. Concrete transports decide how the locator is reached (UDP socket,
+ *  NDN Interest/Data exchange, ...). Received messages are delivered back via the receive callback along with the locator
+ *  of the sender.
+ */
+class ChordTransport : public Object
+{
+  public:
+    static TypeId GetTypeId (void);
+
+    ChordTransport ();
+    virtual ~ChordTransport ();
+
+    /**
+     *  \brief Start transport
+     *  \param node Node on which ChordIpv4 is running
+     *  \param localIpAddress Local Ipv4Address of ChordIpv4 (locator of local ChordNode(s))
+     *  \param listeningPort Chord protocol port of ChordIpv4
+     */
+    virtual void Start (Ptr<Node> node, Ipv4Address localIpAddress, uint16_t listeningPort) = 0;
+    /**
+     *  \brief Stop transport. No more packets are delivered after this call.
+     */
+    virtual void Stop (void) = 0;
+    /**
+     *  \brief Send packed ChordMessage to remote ChordIpv4
+     *  \param packet Packet carrying ChordMessage
+     *  \param destinationIp Ipv4Address of remote ChordNode
+     *  \param destinationPort Chord protocol port of remote ChordNode
+     */
+    virtual void Send (Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort) = 0;
+
+    /**
+     *  \brief Registers Callback function for received packets
+     *  \param recvFn This Callback is passed packet, Ipv4Address and port of sender as parameters.
+     */
+    void SetRecvCallback (Callback<void, Ptr<Packet>, Ipv4Address, uint16_t> recvFn);
+
+    //Counters
+    struct TransportStats {
+    uint32_t txMessages;
+    uint64_t txBytes;
+    uint32_t rxMessages;
+    uint64_t rxBytes;
+    };
+    /**
+     *  \returns ChordTransport::TransportStats
+     */
+    TransportStats& GetStats ();
+
+  protected:
+    virtual void DoDispose (void);
+    /**
+     *  \brief Deliver received packet to ChordIpv4 and update counters
+     */
+    void NotifyRecv (Ptr<Packet> packet, Ipv4Address fromIp, uint16_t fromPort);
+    /**
+     *  \brief Account for transmitted packet
+     */
+    void NotifySend (uint32_t bytes);
+
+  private:
+    /**
+     *  \cond
+     */
+    Callback<void, Ptr<Packet>, Ipv4Address, uint16_t> m_recvFn;
+    TransportStats m_stats;
+    /**
+     *  \endcond
+     */
+
+}; //class ChordTransport
+
+} //namespace ns3
+
+#endif //CHORD_TRANSPORT_H
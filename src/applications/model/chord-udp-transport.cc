@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "chord-udp-transport.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/socket.h"
+#include "ns3/socket-factory.h"
+#include "ns3/inet-socket-address.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ChordUdpTransport");
+NS_OBJECT_ENSURE_REGISTERED (ChordUdpTransport);
+
+TypeId
+ChordUdpTransport::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ChordUdpTransport")
+    .SetParent<ChordTransport> ()
+    .AddConstructor<ChordUdpTransport> ()
+    ;
+  return tid;
+}
+
+ChordUdpTransport::ChordUdpTransport ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_socket = 0;
+}
+
+ChordUdpTransport::~ChordUdpTransport ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_socket = 0;
+}
+
+void
+ChordUdpTransport::DoDispose (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_socket = 0;
+  ChordTransport::DoDispose ();
+}
+
+void
+ChordUdpTransport::Start (Ptr<Node> node, Ipv4Address localIpAddress, uint16_t listeningPort)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_socket == 0)
+  {
+    TypeId tid = TypeId::LookupByName ("ns3::UdpSocketFactory");
+    m_socket = Socket::CreateSocket (node, tid);
+    InetSocketAddress local = InetSocketAddress (localIpAddress, listeningPort);
+    m_socket->Bind (local);
+  }
+  m_socket->SetRecvCallback (MakeCallback (&ChordUdpTransport::ProcessUdpPacket, this));
+}
+
+void
+ChordUdpTransport::Stop (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_socket != 0)
+  {
+    //m_socket->Close ();
+    m_socket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
+  }
+}
+
+void
+ChordUdpTransport::Send (Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  NotifySend (packet->GetSize ());
+  m_socket->SendTo (packet, 0, InetSocketAddress (destinationIp, destinationPort));
+}
+
+void
+ChordUdpTransport::ProcessUdpPacket (Ptr<Socket> socket)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Ptr<Packet> packet;
+  Address from;
+  while ((packet = socket->RecvFrom (from)))
+  {
+    if (InetSocketAddress::IsMatchingType (from))
+    {
+      InetSocketAddress address = InetSocketAddress::ConvertFrom (from);
+      NS_LOG_INFO ("ChordUdpTransport: Received " << packet->GetSize() << " bytes packet from " <<  address.GetIpv4());
+      NotifyRecv (packet, address.GetIpv4 (), address.GetPort ());
+    }
+  }
+}
+
+} //namespace ns3
@@ -0,0 +1,63 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHORD_UDP_TRANSPORT_H
+#define CHORD_UDP_TRANSPORT_H
+
+#include "chord-transport.h"
+
+namespace ns3 {
+
+class Socket;
+
+/**
+ *  \ingroup chordipv4
+ *  \class ChordUdpTransport
+ *  \brief ChordTransport over a single UDP socket bound to (LocalIpAddress, ListeningPort). Default transport of ChordIpv4.
+ */
+class ChordUdpTransport : public ChordTransport
+{
+  public:
+    static TypeId GetTypeId (void);
+
+    ChordUdpTransport ();
+    virtual ~ChordUdpTransport ();
+
+    virtual void Start (Ptr<Node> node, Ipv4Address localIpAddress, uint16_t listeningPort);
+    virtual void Stop (void);
+    virtual void Send (Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort);
+
+  protected:
+    virtual void DoDispose (void);
+
+  private:
+    /**
+     *  \cond
+     */
+    void ProcessUdpPacket (Ptr<Socket> socket);
+
+    Ptr<Socket> m_socket;
+    /**
+     *  \endcond
+     */
+
+}; //class ChordUdpTransport
+
+} //namespace ns3
+
+#endif //CHORD_UDP_TRANSPORT_H
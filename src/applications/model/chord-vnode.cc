@@ -34,6 +34,9 @@ ChordVNode::ChordVNode (Ptr<ChordNode> node, uint8_t maxSuccessorListSize, uint8
   m_predecessor = 0;
   m_maxSuccessorListSize = maxSuccessorListSize;
   m_maxPredecessorListSize = maxPredecessorListSize;
+  m_stats.fingersLookedUp = 0;
+  m_stats.neighborRoutes = 0;
+  m_stats.hopsSaved = 0;
   PopulateFingerIdentifierList ();
 }
 
@@ -256,6 +259,7 @@ ChordVNode::PackLookupRsp(Ptr<ChordNode> requestorNode, uint32_t transactionId,
   chordMessage.SetRequestorNode (requestorNode);
   chordMessage.SetTransactionId (transactionId);
   chordMessage.GetLookupRsp().resolvedNode = this;
+  chordMessage.GetLookupRsp().load = 0;
 }
 
 void
@@ -367,6 +371,40 @@ ChordVNode::ShiftPredecessor ()
     return false;
 }
 
+bool
+ChordVNode::FindNeighborOwner (Ptr<ChordIdentifier> targetIdentifier, Ptr<ChordNode> &ownerNode)
+{
+  //Walk successor list clockwise
+  Ptr<ChordIdentifier> lowIdentifier = GetChordIdentifier ();
+  for (uint32_t i = 0; i < m_successorList.size () && i < m_maxSuccessorListSize; i++)
+  {
+    Ptr<ChordNode> successor = m_successorList[i];
+    //Stop if list wraps around the ring
+    if (successor->GetChordIdentifier ()->IsEqual (GetChordIdentifier ()))
+      break;
+    if (targetIdentifier->IsInBetween (lowIdentifier, successor->GetChordIdentifier ()))
+    {
+      ownerNode = successor;
+      return true;
+    }
+    lowIdentifier = successor->GetChordIdentifier ();
+  }
+  //Walk predecessor list anti-clockwise
+  for (uint32_t i = 0; i + 1 < m_predecessorList.size () && i + 1 < m_maxPredecessorListSize; i++)
+  {
+    Ptr<ChordNode> predecessor = m_predecessorList[i];
+    Ptr<ChordNode> nextPredecessor = m_predecessorList[i + 1];
+    if (predecessor->GetChordIdentifier ()->IsEqual (GetChordIdentifier ()) || nextPredecessor->GetChordIdentifier ()->IsEqual (GetChordIdentifier ()))
+      break;
+    if (targetIdentifier->IsInBetween (nextPredecessor->GetChordIdentifier (), predecessor->GetChordIdentifier ()))
+    {
+      ownerNode = predecessor;
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 ChordVNode::SynchSuccessorList (std::vector<Ptr<ChordNode> > &successorList)
 {
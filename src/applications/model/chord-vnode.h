@@ -202,6 +202,15 @@ class ChordVNode : public ChordNode
      *
      */
     bool ShiftPredecessor ();
+    /**
+     *  \brief Find owner of identifier among successor and predecessor lists
+     *  \param targetIdentifier ChordIdentifier
+     *  \param ownerNode ChordNode owning targetIdentifier (return result)
+     *  \returns true if targetIdentifier falls in range covered by successor or predecessor list
+     *
+     *  Owner of identifier in (successor[i-1], successor[i]] is successor[i]; owner of identifier in (predecessor[i+1], predecessor[i]] is predecessor[i].
+     */
+    bool FindNeighborOwner (Ptr<ChordIdentifier> targetIdentifier, Ptr<ChordNode> &ownerNode);
 
     //Transactions
     /**
@@ -256,6 +265,8 @@ class ChordVNode : public ChordNode
     //Counters
     struct VNodeStats {
     uint32_t fingersLookedUp;
+    uint32_t neighborRoutes;    //Requests sent directly to owner found in successor/predecessor list
+    uint32_t hopsSaved;         //Neighbor routes where finger table would have chosen a node other than owner
     };
     /**
      *  \returns ChordVNode::VNodeStats
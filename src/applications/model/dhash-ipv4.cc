@@ -748,4 +748,18 @@ DHashIpv4::DumpDHashInfo (std::ostream &os)
   os << "Pending Transactions: " << m_dHashTransactionTable.size() << "\n";
 }
 
+uint32_t
+DHashIpv4::GetObjectCount (Ptr<ChordIdentifier> lowIdentifier, Ptr<ChordIdentifier> highIdentifier)
+{
+  uint32_t count = 0;
+  for (DHashObjectMap::iterator iterator = m_dHashObjectTable.begin(); iterator != m_dHashObjectTable.end(); iterator++)
+  {
+    if ((*iterator).second->GetObjectIdentifier()->IsInBetween (lowIdentifier, highIdentifier))
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
 } //namespace ns3
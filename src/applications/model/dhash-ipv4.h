@@ -109,6 +109,13 @@ class DHashIpv4 : public Object
      *  \brief See ChordIpv4::DumpDHashInfo
      */
     void DumpDHashInfo (std::ostream &os);
+    /**
+     *  \brief Counts stored DHashObject (s) with identifier in range (lowIdentifier, highIdentifier]
+     *  \param lowIdentifier ChordIdentifier
+     *  \param highIdentifier ChordIdentifier
+     *  \returns Number of objects
+     */
+    uint32_t GetObjectCount (Ptr<ChordIdentifier> lowIdentifier, Ptr<ChordIdentifier> highIdentifier);
     /**
      *  \cond
      */
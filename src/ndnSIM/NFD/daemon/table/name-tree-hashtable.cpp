@@ -247,6 +247,16 @@ Hashtable::erase(Node* node)
   }
 }
 
+void
+Hashtable::reserve(size_t nNodes)
+{
+  size_t newNBuckets = this->getNBuckets();
+  while (static_cast<size_t>(m_options.expandLoadFactor * newNBuckets) < nNodes) {
+    newNBuckets = static_cast<size_t>(m_options.expandFactor * newNBuckets);
+  }
+  this->resize(newNBuckets);
+}
+
 void
 Hashtable::computeThresholds()
 {
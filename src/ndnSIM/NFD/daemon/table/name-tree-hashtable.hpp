@@ -218,6 +218,11 @@ public:
   void
   erase(Node* node);
 
+  /** \brief expand hashtable so that \p nNodes nodes can be stored without further expansion
+   */
+  void
+  reserve(size_t nNodes);
+
 private:
   /** \brief attach node to bucket
    */
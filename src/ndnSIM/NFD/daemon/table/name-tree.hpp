@@ -71,6 +71,14 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \brief expand hashtable so that \p nEntries entries can be stored without further expansion
+   */
+  void
+  reserve(size_t nEntries)
+  {
+    m_ht.reserve(nEntries);
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
+#include "ns3/boolean.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-app-link-service.hpp"
@@ -41,6 +42,13 @@ App::GetTypeId(void)
                         .SetParent<Application>()
                         .AddConstructor<App>()
 
+                        .AddAttribute("DirectDispatch",
+                                      "Deliver packets from NFD by calling the application "
+                                      "directly instead of in a separate event",
+                                      BooleanValue(false),
+                                      MakeBooleanAccessor(&App::m_isDirectDispatch),
+                                      MakeBooleanChecker())
+
                         .AddTraceSource("ReceivedInterests", "ReceivedInterests",
                                         MakeTraceSourceAccessor(&App::m_receivedInterests),
                                         "ns3::ndn::App::InterestTraceCallback")
@@ -69,6 +77,7 @@ App::GetTypeId(void)
 
 App::App()
   : m_active(false)
+  , m_isDirectDispatch(false)
   , m_face(0)
   , m_appId(std::numeric_limits<uint32_t>::max())
 {
@@ -146,7 +155,7 @@ App::StartApplication() // Called at time specified by Start
                 "Ndn stack should be installed on the node " << GetNode());
 
   // step 1. Create a face
-  auto appLink = make_unique<AppLinkService>(this);
+  auto appLink = make_unique<AppLinkService>(this, m_isDirectDispatch);
   auto transport = make_unique<NullTransport>("appFace://", "appFace://",
                                               ::ndn::nfd::FACE_SCOPE_LOCAL);
   // @TODO Consider making AppTransport instead
@@ -101,6 +101,7 @@ protected:
 
 protected:
   bool m_active; ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
+  bool m_isDirectDispatch; ///< @brief Whether AppLinkService calls the application directly
   shared_ptr<Face> m_face;
   AppLinkService* m_appLink;
 
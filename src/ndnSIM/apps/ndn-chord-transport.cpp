@@ -0,0 +1,338 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-chord-transport.hpp"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-fib-helper.hpp"
+
+#include <limits>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ChordNdnTransport");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ChordNdnEndpoint);
+NS_OBJECT_ENSURE_REGISTERED(ChordNdnTransport);
+
+// number of name components following the transport prefix
+static const size_t CHORD_NDN_NAME_SUFFIX_SIZE = 5;
+
+TypeId
+ChordNdnEndpoint::GetTypeId(void)
+{
+  static TypeId tid = TypeId("ns3::ndn::ChordNdnEndpoint")
+                        .SetGroupName("Ndn")
+                        .SetParent<App>()
+                        .AddConstructor<ChordNdnEndpoint>();
+  return tid;
+}
+
+ChordNdnEndpoint::ChordNdnEndpoint()
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ChordNdnEndpoint::Setup(const Name& localPrefix, Callback<void, shared_ptr<const Interest>> onInterest,
+                        Callback<void, shared_ptr<const Data>> onData)
+{
+  m_localPrefix = localPrefix;
+  m_onInterest = onInterest;
+  m_onData = onData;
+}
+
+void
+ChordNdnEndpoint::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  FibHelper::AddRoute(GetNode(), m_localPrefix, m_face, 0);
+}
+
+void
+ChordNdnEndpoint::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  if (m_active) {
+    FibHelper::RemoveRoute(GetNode(), m_localPrefix, m_face);
+  }
+  App::StopApplication();
+}
+
+void
+ChordNdnEndpoint::Close()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  m_onInterest.Nullify();
+  m_onData.Nullify();
+  StopApplication();
+}
+
+bool
+ChordNdnEndpoint::IsActive() const
+{
+  return m_active;
+}
+
+bool
+ChordNdnEndpoint::SendInterest(shared_ptr<Interest> interest)
+{
+  if (!m_active)
+    return false;
+
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+  return true;
+}
+
+bool
+ChordNdnEndpoint::SendData(shared_ptr<Data> data)
+{
+  if (!m_active)
+    return false;
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+  return true;
+}
+
+void
+ChordNdnEndpoint::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  if (!m_active || m_onInterest.IsNull())
+    return;
+
+  m_onInterest(interest);
+}
+
+void
+ChordNdnEndpoint::OnData(shared_ptr<const Data> data)
+{
+  App::OnData(data); // tracing inside
+
+  if (!m_active || m_onData.IsNull())
+    return;
+
+  m_onData(data);
+}
+
+TypeId
+ChordNdnTransport::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ChordNdnTransport")
+      .SetGroupName("Ndn")
+      .SetParent<ns3::ChordTransport>()
+      .AddConstructor<ChordNdnTransport>()
+      .AddAttribute("Prefix", "Prefix under which Chord locators are announced",
+                    StringValue("/chord"), MakeNameAccessor(&ChordNdnTransport::m_prefix),
+                    MakeNameChecker())
+      .AddAttribute("InterestLifetime", "Lifetime of Interests carrying Chord messages",
+                    StringValue("1s"), MakeTimeAccessor(&ChordNdnTransport::m_interestLifetime),
+                    MakeTimeChecker())
+      .AddAttribute("Freshness",
+                    "Freshness of Data carrying Chord replies, if 0, replies are never "
+                    "served from Content Stores",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&ChordNdnTransport::m_freshness),
+                    MakeTimeChecker());
+  return tid;
+}
+
+ChordNdnTransport::ChordNdnTransport()
+  : m_rand(CreateObject<UniformRandomVariable>())
+  , m_listeningPort(0)
+  , m_pendingPort(0)
+  , m_pendingAnswered(false)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+ChordNdnTransport::~ChordNdnTransport()
+{
+}
+
+void
+ChordNdnTransport::DoDispose()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  // the endpoint is not closed here: the NDN stack may already be disposed
+  m_endpoint = 0;
+  m_pendingInterest.reset();
+  ns3::ChordTransport::DoDispose();
+}
+
+Name
+ChordNdnTransport::GetLocatorPrefix(const Name& prefix, Ipv4Address address)
+{
+  return Name(prefix).appendNumber(address.Get());
+}
+
+void
+ChordNdnTransport::Start(Ptr<Node> node, Ipv4Address localIpAddress, uint16_t listeningPort)
+{
+  NS_LOG_FUNCTION(this << localIpAddress << listeningPort);
+
+  m_localIpAddress = localIpAddress;
+  m_listeningPort = listeningPort;
+
+  if (m_endpoint == 0) {
+    m_endpoint = CreateObject<ChordNdnEndpoint>();
+    m_endpoint->Setup(Name(GetLocatorPrefix(m_prefix, localIpAddress)).appendNumber(listeningPort),
+                      MakeCallback(&ChordNdnTransport::OnInterest, this),
+                      MakeCallback(&ChordNdnTransport::OnData, this));
+    // application will be started by the node right away
+    node->AddApplication(m_endpoint);
+  }
+}
+
+void
+ChordNdnTransport::Stop()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  if (m_endpoint != 0) {
+    m_endpoint->Close();
+    m_endpoint = 0;
+  }
+  m_pendingInterest.reset();
+}
+
+shared_ptr<Data>
+ChordNdnTransport::MakeData(const Name& name, Ptr<Packet> packet)
+{
+  auto data = make_shared<Data>(name);
+
+  if (packet != 0) {
+    std::vector<uint8_t> buffer(packet->GetSize());
+    packet->CopyData(buffer.data(), buffer.size());
+    data->setContent(buffer.data(), buffer.size());
+    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+  }
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+
+  data->wireEncode();
+  return data;
+}
+
+void
+ChordNdnTransport::Send(Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort)
+{
+  NS_LOG_FUNCTION(this << destinationIp << destinationPort);
+
+  if (m_endpoint == 0 || !m_endpoint->IsActive()) {
+    NS_LOG_INFO("Endpoint is not active yet, dropping Chord message to " << destinationIp);
+    return;
+  }
+
+  NotifySend(packet->GetSize());
+
+  // Reply to the node whose Interest is being processed right now travels back as Data
+  if (m_pendingInterest != nullptr && !m_pendingAnswered && m_pendingIpAddress == destinationIp
+      && m_pendingPort == destinationPort) {
+    m_pendingAnswered = true;
+    NS_LOG_INFO("Carrying reply in Data for " << m_pendingInterest->getName().getPrefix(-1));
+    m_endpoint->SendData(MakeData(m_pendingInterest->getName(), packet));
+    return;
+  }
+
+  std::vector<uint8_t> buffer(packet->GetSize());
+  packet->CopyData(buffer.data(), buffer.size());
+
+  Name name(GetLocatorPrefix(m_prefix, destinationIp));
+  name.appendNumber(destinationPort)
+    .appendNumber(m_localIpAddress.Get())
+    .appendNumber(m_listeningPort)
+    .append(buffer.data(), buffer.size());
+
+  auto interest = make_shared<Interest>(name);
+  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setMustBeFresh(true);
+  interest->setInterestLifetime(::ndn::time::milliseconds(m_interestLifetime.GetMilliSeconds()));
+
+  m_endpoint->SendInterest(interest);
+}
+
+void
+ChordNdnTransport::OnInterest(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  const Name& name = interest->getName();
+  if (name.size() != m_prefix.size() + CHORD_NDN_NAME_SUFFIX_SIZE) {
+    NS_LOG_INFO("Ignoring malformed Chord Interest " << name);
+    return;
+  }
+
+  Ipv4Address fromIpAddress(static_cast<uint32_t>(name.get(-3).toNumber()));
+  uint16_t fromPort = static_cast<uint16_t>(name.get(-2).toNumber());
+  const ::ndn::name::Component& message = name.get(-1);
+
+  m_pendingInterest = interest;
+  m_pendingIpAddress = fromIpAddress;
+  m_pendingPort = fromPort;
+  m_pendingAnswered = false;
+
+  NotifyRecv(Create<Packet>(message.value(), message.value_size()), fromIpAddress, fromPort);
+
+  if (!m_pendingAnswered && m_endpoint != 0) {
+    // plain acknowledgement, consumes PIT entries on the way back
+    m_endpoint->SendData(MakeData(name, 0));
+  }
+  m_pendingInterest.reset();
+}
+
+void
+ChordNdnTransport::OnData(shared_ptr<const Data> data)
+{
+  NS_LOG_FUNCTION(this << data->getName());
+
+  const Block& content = data->getContent();
+  if (content.value_size() == 0) {
+    return;
+  }
+
+  const Name& name = data->getName();
+  if (name.size() != m_prefix.size() + CHORD_NDN_NAME_SUFFIX_SIZE) {
+    return;
+  }
+
+  // Reply comes from the node the Interest was addressed to
+  Ipv4Address fromIpAddress(static_cast<uint32_t>(name.get(-5).toNumber()));
+  uint16_t fromPort = static_cast<uint16_t>(name.get(-4).toNumber());
+
+  NotifyRecv(Create<Packet>(content.value(), content.value_size()), fromIpAddress, fromPort);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHORD_TRANSPORT_H
+#define NDN_CHORD_TRANSPORT_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/chord-transport.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN face used by ChordNdnTransport to exchange Chord messages
+ *
+ * The endpoint registers the locator prefix of the local ChordIpv4 instance in the FIB and hands
+ * every received Interest and Data to the owning ChordNdnTransport.
+ */
+class ChordNdnEndpoint : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ChordNdnEndpoint();
+
+  /**
+   * @brief Set prefix that should be registered towards this endpoint and the receive callbacks
+   */
+  void
+  Setup(const Name& localPrefix, Callback<void, shared_ptr<const Interest>> onInterest,
+        Callback<void, shared_ptr<const Data>> onData);
+
+  /**
+   * @brief Express Interest through the application face
+   * @returns false if the endpoint has not been started yet
+   */
+  bool
+  SendInterest(shared_ptr<Interest> interest);
+
+  /**
+   * @brief Send Data through the application face
+   */
+  bool
+  SendData(shared_ptr<Data> data);
+
+  /**
+   * @brief Stop the endpoint right away
+   *
+   * Unlike SetStopTime, takes effect even if the endpoint is already running: receive callbacks
+   * are released, the FIB route towards the endpoint is removed and the face is closed.
+   */
+  void
+  Close();
+
+  bool
+  IsActive() const;
+
+  // inherited from App
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest);
+
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  Name m_localPrefix;
+  Callback<void, shared_ptr<const Interest>> m_onInterest;
+  Callback<void, shared_ptr<const Data>> m_onData;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief ChordTransport that carries Chord protocol messages as NDN Interest/Data
+ *
+ * Every ChordIpv4 instance is reachable under the locator prefix
+ * `<Prefix>/<ipv4-as-number>`; the Ipv4Address of ChordIpv4 is used only as a node locator and
+ * does not require an IP stack.  A message sent to (ip, port) is expressed as Interest
+ *
+ *     <Prefix>/<dst-ip>/<dst-port>/<src-ip>/<src-port>/<serialized ChordMessage>
+ *
+ * The receiver always answers with Data under the same name.  If ChordIpv4 replies to the
+ * sender while processing the request (stabilize, heartbeat, join, directly resolved lookups),
+ * the reply is carried as the Data content instead of a separate Interest; otherwise the Data is
+ * empty and only consumes the PIT entry.  Because names are derived from message bytes,
+ * retransmissions of the same request are aggregated in the PIT and, if Freshness is non-zero,
+ * answered from Content Stores along the path.
+ *
+ * Locator prefixes have to be routable, e.g., via GlobalRoutingHelper::AddOrigins with
+ * GetLocatorPrefix().
+ */
+class ChordNdnTransport : public ns3::ChordTransport {
+public:
+  static TypeId
+  GetTypeId();
+
+  ChordNdnTransport();
+  virtual ~ChordNdnTransport();
+
+  virtual void
+  Start(Ptr<Node> node, Ipv4Address localIpAddress, uint16_t listeningPort);
+
+  virtual void
+  Stop();
+
+  virtual void
+  Send(Ptr<Packet> packet, Ipv4Address destinationIp, uint16_t destinationPort);
+
+  /**
+   * @brief Get name under which ChordIpv4 with the given locator receives messages
+   */
+  static Name
+  GetLocatorPrefix(const Name& prefix, Ipv4Address address);
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  void
+  OnInterest(shared_ptr<const Interest> interest);
+
+  void
+  OnData(shared_ptr<const Data> data);
+
+  shared_ptr<Data>
+  MakeData(const Name& name, Ptr<Packet> packet);
+
+private:
+  Name m_prefix;
+  Time m_interestLifetime;
+  Time m_freshness;
+
+  Ptr<ChordNdnEndpoint> m_endpoint;
+  Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
+
+  Ipv4Address m_localIpAddress;
+  uint16_t m_listeningPort;
+
+  // Interest currently being delivered to ChordIpv4, if any
+  shared_ptr<const Interest> m_pendingInterest;
+  Ipv4Address m_pendingIpAddress;
+  uint16_t m_pendingPort;
+  bool m_pendingAnswered;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHORD_TRANSPORT_H
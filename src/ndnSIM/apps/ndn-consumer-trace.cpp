@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-trace.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerTrace")
+      .SetGroupName("Ndn")
+      .SetParent<Consumer>()
+      .AddConstructor<ConsumerTrace>()
+
+      .AddAttribute("TraceFile", "Request trace to replay (see RequestTrace)", StringValue(""),
+                    MakeStringAccessor(&ConsumerTrace::m_traceFile), MakeStringChecker())
+
+      .AddAttribute("ShardIndex", "Index of the part of the trace replayed by this consumer",
+                    UintegerValue(0), MakeUintegerAccessor(&ConsumerTrace::m_shardIndex),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("ShardCount", "Number of consumers replaying parts of the trace",
+                    UintegerValue(1), MakeUintegerAccessor(&ConsumerTrace::m_shardCount),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("ShardByName",
+                    "Send all requests for a name to the same shard instead of dealing records "
+                    "round-robin",
+                    BooleanValue(false), MakeBooleanAccessor(&ConsumerTrace::m_shardByName),
+                    MakeBooleanChecker());
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace()
+  : m_shardIndex(0)
+  , m_shardCount(1)
+  , m_shardByName(false)
+  , m_cursor(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerTrace::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  m_trace = RequestTrace::Open(m_traceFile);
+  if (m_trace == nullptr) {
+    NS_FATAL_ERROR("Cannot open request trace " << m_traceFile);
+  }
+  if (m_shardIndex >= m_shardCount) {
+    NS_FATAL_ERROR("ShardIndex " << m_shardIndex << " is not less than ShardCount "
+                                 << m_shardCount);
+  }
+
+  m_startTime = Simulator::Now();
+  m_cursor = m_shardByName ? 0 : m_shardIndex;
+  if (!IsInShard(m_cursor)) {
+    NextRecord();
+  }
+
+  Consumer::StartApplication();
+}
+
+bool
+ConsumerTrace::IsInShard(uint64_t index) const
+{
+  if (index >= m_trace->GetRecordCount()) {
+    return true; // end of the trace
+  }
+
+  if (m_shardByName) {
+    return m_trace->GetRecord(index).nameId % m_shardCount == m_shardIndex;
+  }
+  else {
+    return index % m_shardCount == m_shardIndex;
+  }
+}
+
+void
+ConsumerTrace::NextRecord()
+{
+  if (m_shardByName) {
+    do {
+      m_cursor++;
+    } while (!IsInShard(m_cursor));
+  }
+  else {
+    m_cursor += m_shardCount;
+  }
+}
+
+Time
+ConsumerTrace::GetRecordTime(uint64_t index) const
+{
+  return m_startTime + NanoSeconds(m_trace->GetRecord(index).time);
+}
+
+void
+ConsumerTrace::ScheduleNextPacket()
+{
+  Time next;
+  if (!m_retxSeqs.empty()) {
+    next = Simulator::Now();
+  }
+  else if (m_cursor < m_trace->GetRecordCount()) {
+    next = GetRecordTime(m_cursor);
+  }
+  else {
+    return; // all records sent
+  }
+
+  if (m_sendEvent.IsRunning()) {
+    if (m_nextSendTime <= next) {
+      return; // will be sent by the already scheduled event
+    }
+    Simulator::Remove(m_sendEvent);
+  }
+
+  m_nextSendTime = next;
+  m_sendEvent = Simulator::Schedule(next - Simulator::Now(), &ConsumerTrace::SendPacket, this);
+}
+
+void
+ConsumerTrace::SendPacket()
+{
+  if (!m_active)
+    return;
+
+  NS_LOG_FUNCTION_NOARGS();
+
+  while (!m_retxSeqs.empty()) {
+    uint32_t seq = *m_retxSeqs.begin();
+    m_retxSeqs.erase(m_retxSeqs.begin());
+
+    auto nameId = m_seqNameIds.find(seq);
+    if (nameId != m_seqNameIds.end()) {
+      SendInterest(seq, nameId->second);
+    }
+  }
+
+  Time now = Simulator::Now();
+  while (m_cursor < m_trace->GetRecordCount() && GetRecordTime(m_cursor) <= now) {
+    uint32_t seq = m_seq++;
+    uint32_t nameId = m_trace->GetRecord(m_cursor).nameId;
+    m_seqNameIds[seq] = nameId;
+    SendInterest(seq, nameId);
+    NextRecord();
+  }
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerTrace::SendInterest(uint32_t seq, uint32_t nameId)
+{
+  Name name = m_trace->GetName(nameId);
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setName(name);
+  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+  interest->setInterestLifetime(interestLifeTime);
+
+  NS_LOG_INFO("> Interest for " << name << " (" << seq << ")");
+
+  if (m_seqRecords.Find(seq) == nullptr) {
+    m_pendingSeqs.insert(std::make_pair(name, seq));
+  }
+  WillSendOutInterest(seq);
+
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+}
+
+void
+ConsumerTrace::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  NS_LOG_FUNCTION(this << data);
+
+  int hopCount = 0;
+  auto hopCountTag = data->getTag<lp::HopCountTag>();
+  if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
+    hopCount = *hopCountTag;
+  }
+
+  // all requests for the name are satisfied by the same Data
+  auto range = m_pendingSeqs.equal_range(data->getName());
+  for (auto pending = range.first; pending != range.second; ++pending) {
+    uint32_t seq = pending->second;
+    NS_LOG_INFO("< DATA for " << data->getName() << " (" << seq << ")");
+
+    m_seqNameIds.erase(seq);
+    SatisfySeq(seq, hopCount);
+  }
+  m_pendingSeqs.erase(range.first, range.second);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Ndn application replaying requests of a RequestTrace
+ *
+ * Sends an Interest for the name of every record of the trace file (TraceFile) at the time of
+ * the record, relative to the start of the application.  Records are read from the memory
+ * mapping of the file when they are due and only the next send is scheduled, so memory use
+ * does not depend on the length of the trace.
+ *
+ * One trace can be split among ShardCount consumers (e.g., one per node), each with a different
+ * ShardIndex: either records are dealt round-robin (default, every shard gets the same request
+ * rate and popularity distribution), or all requests for the same name go to the same shard
+ * (ShardByName).
+ *
+ * Interests are retransmitted as by other consumers.  Data must have the same name as the
+ * Interest; the size in the records is not used, producers reply with their own PayloadSize.
+ */
+class ConsumerTrace : public Consumer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerTrace();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  SendPacket();
+
+  void
+  SendInterest(uint32_t seq, uint32_t nameId);
+
+  bool
+  IsInShard(uint64_t index) const;
+
+  /**
+   * @brief Move m_cursor to the next record of this shard
+   */
+  void
+  NextRecord();
+
+  Time
+  GetRecordTime(uint64_t index) const;
+
+private:
+  std::string m_traceFile;
+  uint32_t m_shardIndex;
+  uint32_t m_shardCount;
+  bool m_shardByName;
+
+  shared_ptr<const RequestTrace> m_trace;
+  uint64_t m_cursor;   ///< @brief next record to send
+  Time m_startTime;    ///< @brief simulation time of the start of the trace
+  Time m_nextSendTime; ///< @brief time of the scheduled m_sendEvent
+
+  std::unordered_map<uint32_t, uint32_t> m_seqNameIds;   ///< @brief name of unsatisfied requests
+  std::unordered_multimap<Name, uint32_t> m_pendingSeqs; ///< @brief unsatisfied requests by name
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
@@ -37,6 +37,8 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-table.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -47,6 +49,9 @@ namespace ndn {
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution:
  *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Contents are drawn in constant time from a ZipfMandelbrotTable, which is shared by all
+ * consumers with the same NumberOfContents, q, and s.
  */
 class ConsumerZipfMandelbrot : public ConsumerCbr {
 public:
@@ -91,10 +96,10 @@ private:
   GetS() const;
 
 private:
-  uint32_t m_N;               // number of the contents
-  double m_q;                 // q in (k+q)^s
-  double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  uint32_t m_N;  // number of the contents
+  double m_q;    // q in (k+q)^s
+  double m_s;    // s in (k+q)^s
+  shared_ptr<const ZipfMandelbrotTable> m_table; // created on first use
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -55,9 +55,11 @@ Consumer::GetTypeId(void)
                     MakeIntegerAccessor(&Consumer::m_seq), MakeIntegerChecker<int32_t>())
 
       .AddAttribute("Prefix", "Name of the Interest", StringValue("/"),
-                    MakeNameAccessor(&Consumer::m_interestName), MakeNameChecker())
+                    MakeNameAccessor(&Consumer::SetPrefix, &Consumer::GetPrefix),
+                    MakeNameChecker())
       .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
-                    MakeTimeAccessor(&Consumer::m_interestLifeTime), MakeTimeChecker())
+                    MakeTimeAccessor(&Consumer::SetLifeTime, &Consumer::GetLifeTime),
+                    MakeTimeChecker())
 
       .AddAttribute("RetxTimer",
                     "Timeout defining how frequent retransmission timeouts should be checked",
@@ -92,13 +94,16 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerOrigin = Simulator::Now();
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
   }
 
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  // schedule even with new timeout, if there is anything to check
+  if (!m_seqTimerStarts.empty()) {
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  }
 }
 
 Time
@@ -107,6 +112,32 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+Consumer::SetPrefix(const Name& prefix)
+{
+  m_interestName = prefix;
+  m_interestTemplate.reset(); // recreated with the next Interest
+}
+
+Name
+Consumer::GetPrefix() const
+{
+  return m_interestName;
+}
+
+void
+Consumer::SetLifeTime(Time lifeTime)
+{
+  m_interestLifeTime = lifeTime;
+  m_interestTemplate.reset();
+}
+
+Time
+Consumer::GetLifeTime() const
+{
+  return m_interestLifeTime;
+}
+
 void
 Consumer::CheckRetxTimeout()
 {
@@ -115,20 +146,45 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
+  while (!m_seqTimerStarts.empty()) {
+    Time start = m_seqTimerStarts.front().first;
+    uint32_t seqNo = m_seqTimerStarts.front().second;
+
+    SeqRecord* record = m_seqRecords.Find(seqNo);
+    if (record == nullptr || !record->isTimerArmed || record->timeoutBase != start) {
+      m_seqTimerStarts.pop_front(); // Data received or timer restarted
+    }
+    else if (start + rto <= now) // timeout expired?
     {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
+      record->isTimerArmed = false;
+      m_seqTimerStarts.pop_front();
       OnTimeout(seqNo);
     }
     else
       break; // nothing else to do. All later packets need not be retransmitted
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  // OnTimeout may have already scheduled the next check
+  if (!m_seqTimerStarts.empty() && !m_retxEvent.IsRunning()) {
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  }
+}
+
+void
+Consumer::ScheduleRetxCheck()
+{
+  if (m_retxEvent.IsRunning()) {
+    return;
+  }
+
+  // keep checks at the same times as if they were never stopped
+  Time delay = m_retxTimer;
+  if (m_retxTimer.IsStrictlyPositive()) {
+    int64_t period = m_retxTimer.GetTimeStep();
+    int64_t elapsed = (Simulator::Now() - m_retxTimerOrigin).GetTimeStep();
+    delay = TimeStep(period - elapsed % period);
+  }
+  m_retxEvent = Simulator::Schedule(delay, &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
@@ -163,36 +219,49 @@ Consumer::SendPacket()
 
   NS_LOG_FUNCTION_NOARGS();
 
-  uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
+  uint32_t seq;
+  if (!NextSeq(seq)) {
+    return; // we are totally done
+  }
+
+  if (m_interestTemplate == nullptr) {
+    m_interestTemplate =
+      make_unique<InterestTemplate>(m_interestName,
+                                    time::milliseconds(m_interestLifeTime.GetMilliSeconds()));
+  }
+  SendInterest(seq, m_interestTemplate->Make(seq, NextNonce()));
+
+  ScheduleNextPacket();
+}
 
-  while (m_retxSeqs.size()) {
+bool
+Consumer::NextSeq(uint32_t& seq)
+{
+  if (!m_retxSeqs.empty()) {
     seq = *m_retxSeqs.begin();
     m_retxSeqs.erase(m_retxSeqs.begin());
-    break;
+    return true;
   }
 
-  if (seq == std::numeric_limits<uint32_t>::max()) {
-    if (m_seqMax != std::numeric_limits<uint32_t>::max()) {
-      if (m_seq >= m_seqMax) {
-        return; // we are totally done
-      }
+  if (m_seqMax != std::numeric_limits<uint32_t>::max()) {
+    if (m_seq >= m_seqMax) {
+      return false;
     }
-
-    seq = m_seq++;
   }
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
+  seq = m_seq++;
+  return true;
+}
 
-  // shared_ptr<Interest> interest = make_shared<Interest> ();
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
+uint32_t
+Consumer::NextNonce()
+{
+  return m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+}
 
+void
+Consumer::SendInterest(uint32_t seq, shared_ptr<Interest> interest)
+{
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq);
 
@@ -200,8 +269,6 @@ Consumer::SendPacket()
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
-
-  ScheduleNextPacket();
 }
 
 ///////////////////////////////////////////////////
@@ -231,21 +298,23 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
+  SatisfySeq(seq, hopCount);
+}
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+void
+Consumer::SatisfySeq(uint32_t seq, int32_t hopCount)
+{
+  SeqRecord* record = m_seqRecords.Find(seq);
+  if (record != nullptr) {
+    Time lastDelay = Simulator::Now() - record->lastSent;
+    Time fullDelay = Simulator::Now() - record->firstSent;
+    uint32_t retxCount = record->retxCount;
+    m_seqRecords.Erase(seq); // also stops the retransmission timer
+
+    m_lastRetransmittedInterestDataDelay(this, seq, lastDelay, hopCount);
+    m_firstInterestDataDelay(this, seq, fullDelay, retxCount, hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
@@ -279,15 +348,22 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqRecords.GetSize() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  Time now = Simulator::Now();
+  SeqRecord& record = m_seqRecords.Insert(sequenceNumber);
+  if (record.retxCount == 0) {
+    record.firstSent = now;
+  }
+  record.lastSent = now;
+  record.retxCount++;
+
+  if (!record.isTimerArmed) {
+    record.isTimerArmed = true;
+    record.timeoutBase = now;
+    m_seqTimerStarts.push_back(std::make_pair(now, sequenceNumber));
+    ScheduleRetxCheck();
+  }
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
@@ -29,15 +29,12 @@
 #include "ns3/data-rate.h"
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-interest-template.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-seq-record-table.hpp"
 
 #include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <deque>
 
 namespace ns3 {
 namespace ndn {
@@ -111,12 +108,41 @@ protected:
   virtual void
   ScheduleNextPacket() = 0;
 
+  /**
+   * \brief Get sequence number to request next: the first sequence number to be retransmitted,
+   * otherwise the next new one
+   * \returns false if all sequence numbers up to the maximum have been requested
+   */
+  bool
+  NextSeq(uint32_t& seq);
+
+  /**
+   * \brief Draws a random nonce
+   */
+  uint32_t
+  NextNonce();
+
+  /**
+   * \brief Traces and sends out the Interest for sequence number @p seq
+   */
+  void
+  SendInterest(uint32_t seq, shared_ptr<Interest> interest);
+
   /**
    * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
+   *
+   * The check is repeated every RetxTimer while any retransmission timer is running.
    */
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Fires delay traces for Data satisfying sequence number @p seq and forgets the
+   * sequence number
+   */
+  void
+  SatisfySeq(uint32_t seq, int32_t hopCount);
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -131,6 +157,25 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Schedules the next retransmission check at the next multiple of RetxTimer
+   */
+  void
+  ScheduleRetxCheck();
+
+private:
+  void
+  SetPrefix(const Name& prefix);
+
+  Name
+  GetPrefix() const;
+
+  void
+  SetLifeTime(Time lifeTime);
+
+  Time
+  GetLifeTime() const;
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
@@ -146,6 +191,12 @@ protected:
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
+  /**
+   * \brief Encoded prefix and fields of Interests, created for the first Interest and again
+   * after Prefix or LifeTime has changed
+   */
+  std::unique_ptr<InterestTemplate> m_interestTemplate;
+
   /// @cond include_hidden
   /**
    * \struct This struct contains sequence numbers of packets to be retransmitted
@@ -156,53 +207,19 @@ protected:
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
   /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
+   * \brief Send times and retransmission counts of sequence numbers waiting for Data
    */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
+  SeqRecordTable m_seqRecords;
 
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+   * \brief Starts of retransmission timers (time, sequence number) in the order of time
+   *
+   * Timers start at the current simulation time, so appending keeps the queue ordered.  Entries
+   * of satisfied or restarted timers are skipped when they reach the front.
+   */
+  std::deque<std::pair<Time, uint32_t>> m_seqTimerStarts;
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  Time m_retxTimerOrigin; ///< \brief Time the retransmission checks are aligned to
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-producer-high-rate.hpp"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ProducerHighRate");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ProducerHighRate);
+
+TypeId
+ProducerHighRate::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ProducerHighRate")
+      .SetGroupName("Ndn")
+      .SetParent<Producer>()
+      .AddConstructor<ProducerHighRate>()
+      .AddAttribute("CacheSize",
+                    "Number of recently created Data kept for repeated requests "
+                    "(rounded up to a power of 2), 0 to disable",
+                    UintegerValue(1024), MakeUintegerAccessor(&ProducerHighRate::m_cacheSize),
+                    MakeUintegerChecker<uint32_t>());
+  return tid;
+}
+
+ProducerHighRate::ProducerHighRate()
+  : m_cacheMask(0)
+  , m_cacheHits(0)
+{
+}
+
+void
+ProducerHighRate::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  size_t cacheSize = 0;
+  if (m_cacheSize > 0) {
+    cacheSize = 1;
+    while (cacheSize < m_cacheSize) {
+      cacheSize <<= 1;
+    }
+  }
+  m_cache.assign(cacheSize, nullptr);
+  m_cacheMask = cacheSize - 1;
+
+  Producer::StartApplication();
+}
+
+void
+ProducerHighRate::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  m_cache.clear();
+  Producer::StopApplication();
+}
+
+void
+ProducerHighRate::CreateTemplate()
+{
+  Producer::CreateTemplate();
+  // Data created from the previous template is no longer valid
+  std::fill(m_cache.begin(), m_cache.end(), nullptr);
+}
+
+void
+ProducerHighRate::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  if (!m_active)
+    return;
+
+  if (m_template == nullptr) {
+    CreateTemplate();
+  }
+
+  const Name& name = interest->getName();
+
+  shared_ptr<Data> data;
+  if (m_cache.empty()) {
+    data = m_template->Make(name);
+  }
+  else {
+    shared_ptr<Data>& entry = m_cache[std::hash<Name>()(name) & m_cacheMask];
+    if (entry != nullptr && entry->getName() == name) {
+      m_cacheHits++;
+    }
+    else {
+      entry = m_template->Make(name);
+    }
+    data = entry;
+  }
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PRODUCER_HIGH_RATE_H
+#define NDN_PRODUCER_HIGH_RATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-producer.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Interest-sink application for scenarios where producers serve many Interests
+ *
+ * Producer that keeps the most recently created Data in a direct-mapped cache of CacheSize
+ * entries indexed by the hash of the name, so repeated requests for the same name (e.g., when
+ * the Content Store of the node is disabled or too small) reuse the encoded Data and its
+ * signature instead of creating it again.
+ *
+ * Data in the cache never changes, as all Data of the application differs only in the name.  The
+ * cache is cleared whenever the Data template is recreated.
+ */
+class ProducerHighRate : public Producer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ProducerHighRate();
+
+  // inherited from Producer
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest);
+
+  /**
+   * @brief Get number of Interests answered with Data from the cache
+   */
+  uint64_t
+  GetCacheHits() const
+  {
+    return m_cacheHits;
+  }
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  // inherited from Producer
+  virtual void
+  CreateTemplate();
+
+private:
+  uint32_t m_cacheSize;
+
+  std::vector<shared_ptr<Data>> m_cache;
+  size_t m_cacheMask;
+  uint64_t m_cacheHits;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PRODUCER_HIGH_RATE_H
@@ -26,6 +26,8 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-data-template.hpp"
+#include "utils/ndn-virtual-payload.hpp"
 
 #include <memory>
 
@@ -51,19 +53,22 @@ Producer::GetTypeId(void)
          "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
          StringValue("/"), MakeNameAccessor(&Producer::m_postfix), MakeNameChecker())
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
-                    MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
+                    MakeUintegerAccessor(&Producer::SetPayloadSize, &Producer::GetPayloadSize),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
-                    TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&Producer::SetFreshness, &Producer::GetFreshness),
                     MakeTimeChecker())
       .AddAttribute(
          "Signature",
          "Fake signature, 0 valid signature (default), other values application-specific",
-         UintegerValue(0), MakeUintegerAccessor(&Producer::m_signature),
+         UintegerValue(0), MakeUintegerAccessor(&Producer::SetSignature, &Producer::GetSignature),
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(),
+                    MakeNameAccessor(&Producer::SetKeyLocator, &Producer::GetKeyLocator),
+                    MakeNameChecker());
   return tid;
 }
 
@@ -79,6 +84,9 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  if (m_template == nullptr) {
+    CreateTemplate();
+  }
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -90,6 +98,66 @@ Producer::StopApplication()
   App::StopApplication();
 }
 
+void
+Producer::CreateTemplate()
+{
+  m_template = make_unique<DataTemplate>(time::milliseconds(m_freshness.GetMilliSeconds()),
+                                         VirtualPayload::GetBuffer(m_virtualPayloadSize),
+                                         m_signature, m_keyLocator);
+}
+
+void
+Producer::SetPayloadSize(uint32_t payloadSize)
+{
+  m_virtualPayloadSize = payloadSize;
+  m_template.reset(); // recreated with the next Data
+}
+
+uint32_t
+Producer::GetPayloadSize() const
+{
+  return m_virtualPayloadSize;
+}
+
+void
+Producer::SetFreshness(Time freshness)
+{
+  m_freshness = freshness;
+  m_template.reset();
+}
+
+Time
+Producer::GetFreshness() const
+{
+  return m_freshness;
+}
+
+void
+Producer::SetSignature(uint32_t signature)
+{
+  m_signature = signature;
+  m_template.reset();
+}
+
+uint32_t
+Producer::GetSignature() const
+{
+  return m_signature;
+}
+
+void
+Producer::SetKeyLocator(const Name& keyLocator)
+{
+  m_keyLocator = keyLocator;
+  m_template.reset();
+}
+
+Name
+Producer::GetKeyLocator() const
+{
+  return m_keyLocator;
+}
+
 void
 Producer::OnInterest(shared_ptr<const Interest> interest)
 {
@@ -104,29 +172,13 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   // dataName.append(m_postfix);
   // dataName.appendVersion();
 
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
+  if (m_template == nullptr) {
+    CreateTemplate();
   }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
+  auto data = m_template->Make(dataName);
 
   NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-  // to create real wire encoding
-  data->wireEncode();
-
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
 }
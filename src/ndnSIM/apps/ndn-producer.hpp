@@ -25,6 +25,8 @@
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
@@ -59,6 +61,43 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+  /**
+   * @brief (Re)create template of Data from the current attributes
+   *
+   * Called when the application starts and for the first Interest after PayloadSize, Freshness,
+   * Signature, or KeyLocator has changed.  Subclasses that keep Data created from the template
+   * override it to drop that Data as well.
+   */
+  virtual void
+  CreateTemplate();
+
+  std::unique_ptr<DataTemplate> m_template; ///< @brief nullptr until (re)created by CreateTemplate
+
+private:
+  void
+  SetPayloadSize(uint32_t payloadSize);
+
+  uint32_t
+  GetPayloadSize() const;
+
+  void
+  SetFreshness(Time freshness);
+
+  Time
+  GetFreshness() const;
+
+  void
+  SetSignature(uint32_t signature);
+
+  uint32_t
+  GetSignature() const;
+
+  void
+  SetKeyLocator(const Name& keyLocator);
+
+  Name
+  GetKeyLocator() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-chord-resolution.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/apps/ndn-chord-transport.hpp"
+#include "ns3/ndnSIM/model/ndn-chord-name-resolver.hpp"
+#include "ns3/ndnSIM/helper/ndn-chord-resolver-helper.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario compares Chord-based name resolution with centrally computed routes on a 3x3
+ * grid:
+ *
+ * (consumer1) -- ( ) ----- (producer2)
+ *      |          |            |
+ *     ( ) ------ ( ) -------- ( )
+ *      |          |            |
+ * (consumer2) -- ( ) ----- (producer1)
+ *
+ * Every node runs ChordIpv4 over ndn::ChordNdnTransport; only Chord locator prefixes
+ * (/chord/<ip>) are installed with GlobalRoutingHelper.  Producers announce /prefix1 and
+ * /prefix2 in Chord, routers resolve them on the first Interest without FIB match and cache the
+ * result for CacheLifetime.
+ *
+ * With --global=1 content prefixes are installed by GlobalRoutingHelper instead, which gives the
+ * baseline for the delays in chord-resolution-app-delays.txt.
+ *
+ *     NS_LOG=ndn.ChordNameResolver ./waf --run=ndn-chord-resolution
+ */
+
+static void
+InsertVNode(Ptr<ChordIpv4> chord, std::string name, Ptr<UniformRandomVariable> rand)
+{
+  uint8_t key[20];
+  for (uint32_t i = 0; i < sizeof(key); i++)
+    key[i] = rand->GetInteger(0, 255);
+  chord->InsertVNode(name, key, sizeof(key));
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  bool global = false;
+  std::string cacheLifetime = "60s";
+
+  CommandLine cmd;
+  cmd.AddValue("global", "Install content routes with GlobalRoutingHelper", global);
+  cmd.AddValue("cacheLifetime", "Lifetime of resolved FIB entries", cacheLifetime);
+  cmd.Parse(argc, argv);
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // Chord ring over NDN
+  NodeContainer nodes = NodeContainer::GetGlobal();
+  Ipv4AddressHelper locators("10.1.0.0", "255.255.0.0");
+  Ipv4Address bootStrapIp = locators.NewAddress();
+  uint16_t port = 2000;
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Ipv4Address localIp = (i == 0) ? bootStrapIp : locators.NewAddress();
+
+    ndn::AppHelper chordHelper("ns3::ChordIpv4");
+    chordHelper.SetAttribute("BootStrapIp", Ipv4AddressValue(bootStrapIp));
+    chordHelper.SetAttribute("BootStrapPort", UintegerValue(port));
+    chordHelper.SetAttribute("LocalIpAddress", Ipv4AddressValue(localIp));
+    chordHelper.SetAttribute("ListeningPort", UintegerValue(port));
+    chordHelper.SetAttribute("ApplicationPort", UintegerValue(port + 1));
+    chordHelper.SetAttribute("Transport", TypeIdValue(ndn::ChordNdnTransport::GetTypeId()));
+    Ptr<ChordIpv4> chord = chordHelper.Install(nodes.Get(i)).Get(0)->GetObject<ChordIpv4>();
+
+    ndnGlobalRoutingHelper.AddOrigin(ndn::ChordNdnTransport::GetLocatorPrefix("/chord", localIp)
+                                       .toUri(),
+                                     nodes.Get(i));
+
+    Simulator::ScheduleWithContext(nodes.Get(i)->GetId(), Seconds(1.0 + 0.5 * i), &InsertVNode,
+                                   chord, "router" + std::to_string(i), rand);
+  }
+
+  Ptr<Node> producers[] = {grid.GetNode(2, 2), grid.GetNode(0, 2)};
+  Ptr<Node> consumers[] = {grid.GetNode(0, 0), grid.GetNode(2, 0)};
+  std::string prefixes[] = {"/prefix1", "/prefix2"};
+
+  if (!global) {
+    ndn::ChordResolverHelper resolverHelper;
+    resolverHelper.SetResolverAttribute("CacheLifetime", StringValue(cacheLifetime));
+    resolverHelper.InstallAll();
+  }
+
+  for (int i = 0; i < 2; i++) {
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefixes[i]);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producers[i]);
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefixes[i]);
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.Install(consumers[i]).Start(Seconds(20.0));
+
+    if (global) {
+      ndnGlobalRoutingHelper.AddOrigin(prefixes[i], producers[i]);
+    }
+    else {
+      ndn::ChordResolverHelper::RegisterPrefix(producers[i], prefixes[i], Seconds(10.0));
+    }
+  }
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  ndn::AppDelayTracer::InstallAll("chord-resolution-app-delays.txt");
+
+  Simulator::Stop(Seconds(60.0));
+
+  Simulator::Run();
+
+  if (!global) {
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      std::cout << "Node " << i << ": ";
+      nodes.Get(i)->GetObject<ndn::ChordNameResolver>()->PrintStats(std::cout);
+      std::cout << std::endl;
+    }
+  }
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
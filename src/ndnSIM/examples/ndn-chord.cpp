@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-chord.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/apps/ndn-chord-transport.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario runs a Chord ring on top of NDN (no IP stack is installed).  Every node of a
+ * 3x3 grid runs ChordIpv4 with ndn::ChordNdnTransport; Ipv4 addresses are used only as Chord
+ * locators and are announced under /chord/<address> using GlobalRoutingHelper.
+ *
+ * Each node inserts one virtual node and, once the ring is stable, issues random key lookups.
+ * At the end of the simulation per-node transport counters are printed, which can be compared
+ * against the same scenario with ns3::ChordUdpTransport.
+ *
+ * To run scenario and see what is happening, use the following command:
+ *
+ *     NS_LOG=ndn.ChordNdnTransport ./waf --run=ndn-chord
+ */
+
+static uint32_t g_lookupSuccess = 0;
+static uint32_t g_lookupFailure = 0;
+
+static void
+LookupSuccess(uint8_t* key, uint8_t keyBytes, Ipv4Address ip, uint16_t port)
+{
+  g_lookupSuccess++;
+}
+
+static void
+LookupFailure(uint8_t* key, uint8_t keyBytes)
+{
+  g_lookupFailure++;
+}
+
+static void
+InsertVNode(Ptr<ChordIpv4> chord, std::string name, Ptr<UniformRandomVariable> rand)
+{
+  uint8_t key[20];
+  for (uint32_t i = 0; i < sizeof(key); i++)
+    key[i] = rand->GetInteger(0, 255);
+  chord->InsertVNode(name, key, sizeof(key));
+}
+
+static void
+LookupKey(Ptr<ChordIpv4> chord, Ptr<UniformRandomVariable> rand)
+{
+  uint8_t key[20];
+  for (uint32_t i = 0; i < sizeof(key); i++)
+    key[i] = rand->GetInteger(0, 255);
+  chord->LookupKey(key, sizeof(key));
+}
+
+int
+main(int argc, char* argv[])
+{
+  // Setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  uint32_t lookups = 100;
+
+  CommandLine cmd;
+  cmd.AddValue("lookups", "Number of random key lookups", lookups);
+  cmd.Parse(argc, argv);
+
+  // Creating 3x3 topology
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // Chord locators, no IP stack is needed
+  NodeContainer nodes = NodeContainer::GetGlobal();
+  Ipv4AddressHelper locators("10.1.0.0", "255.255.0.0");
+  Ipv4Address bootStrapIp = locators.NewAddress();
+  uint16_t port = 2000;
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  std::vector<Ptr<ChordIpv4>> chords;
+
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Ipv4Address localIp = (i == 0) ? bootStrapIp : locators.NewAddress();
+
+    ndn::AppHelper chordHelper("ns3::ChordIpv4");
+    chordHelper.SetAttribute("BootStrapIp", Ipv4AddressValue(bootStrapIp));
+    chordHelper.SetAttribute("BootStrapPort", UintegerValue(port));
+    chordHelper.SetAttribute("LocalIpAddress", Ipv4AddressValue(localIp));
+    chordHelper.SetAttribute("ListeningPort", UintegerValue(port));
+    chordHelper.SetAttribute("ApplicationPort", UintegerValue(port + 1));
+    chordHelper.SetAttribute("Transport", TypeIdValue(ndn::ChordNdnTransport::GetTypeId()));
+    Ptr<ChordIpv4> chord = chordHelper.Install(nodes.Get(i)).Get(0)->GetObject<ChordIpv4>();
+
+    chord->SetLookupSuccessCallback(MakeCallback(&LookupSuccess));
+    chord->SetLookupFailureCallback(MakeCallback(&LookupFailure));
+    chords.push_back(chord);
+
+    ndnGlobalRoutingHelper.AddOrigin(ndn::ChordNdnTransport::GetLocatorPrefix("/chord", localIp)
+                                       .toUri(),
+                                     nodes.Get(i));
+
+    // bootstrap node creates the ring, the rest join one after another
+    Simulator::ScheduleWithContext(nodes.Get(i)->GetId(), Seconds(1.0 + i), &InsertVNode, chord,
+                                   "vnode" + std::to_string(i), rand);
+  }
+
+  // Calculate and install FIBs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  double lookupStart = 1.0 + nodes.GetN() + 10.0;
+  for (uint32_t i = 0; i < lookups; i++) {
+    uint32_t node = rand->GetInteger(0, chords.size() - 1);
+    Simulator::ScheduleWithContext(nodes.Get(node)->GetId(), Seconds(lookupStart + 0.1 * i),
+                                   &LookupKey, chords[node], rand);
+  }
+
+  Simulator::Stop(Seconds(lookupStart + 0.1 * lookups + 10.0));
+
+  Simulator::Run();
+
+  std::cout << "Lookups: " << lookups << " success: " << g_lookupSuccess
+            << " failure: " << g_lookupFailure << std::endl;
+  std::cout << "Node\tTxMessages\tTxBytes\tRxMessages\tRxBytes" << std::endl;
+  for (uint32_t i = 0; i < chords.size(); i++) {
+    ChordTransport::TransportStats& stats = chords[i]->GetTransport()->GetStats();
+    std::cout << i << "\t" << stats.txMessages << "\t" << stats.txBytes << "\t"
+              << stats.rxMessages << "\t" << stats.rxBytes << std::endl;
+  }
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
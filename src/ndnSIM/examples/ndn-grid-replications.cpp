@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-grid-replications.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This scenario runs independent replications of a grid scenario in parallel worker processes
+ * (see ndn::ReplicationRunner)
+ *
+ * (consumer) -- ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) -- (producer)
+ *
+ * The topology, NDN stack, producer and FIBs are created once.  Every replication, with its own
+ * RngRun value, installs a consumer requesting Zipf-Mandelbrot distributed contents at
+ * exponentially distributed times and writes the delays into a shard of the application delay
+ * trace.  All shards are merged into app-delays-trace.txt, with the run number in the first
+ * column.
+ *
+ * To run 30 replications on all CPUs, use the following command:
+ *
+ *     ./waf --run="ndn-grid-replications --runs=30"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  // Setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(10));
+
+  uint32_t size = 3;
+  uint32_t runs = 10;
+  uint32_t jobs = 0;
+
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of rows and columns of the grid", size);
+  cmd.AddValue("runs", "Number of replications (RngRun 1 to runs)", runs);
+  cmd.AddValue("jobs", "Number of parallel workers, 0 for number of CPUs", jobs);
+  cmd.Parse(argc, argv);
+
+  // Creating size x size topology
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(size, size, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  // Set BestRoute strategy
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  std::string prefix = "/prefix";
+  Ptr<Node> producer = grid.GetNode(size - 1, size - 1);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  // Add /prefix origins to ndn::GlobalRouter, calculate and install FIBs
+  ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(Seconds(20.0));
+
+  ndn::ReplicationRunner runner;
+  runner.SetRuns(1, runs);
+  runner.SetJobs(jobs);
+  runner.AddTrace("app-delays-trace.txt");
+
+  // Applications draw random numbers, so they are installed in every replication
+  uint32_t failed = runner.Run([&] (uint32_t run) {
+      ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+      consumerHelper.SetPrefix(prefix);
+      consumerHelper.SetAttribute("Frequency", StringValue("100"));
+      consumerHelper.SetAttribute("Randomize", StringValue("exponential"));
+      consumerHelper.SetAttribute("NumberOfContents", StringValue("1000"));
+      consumerHelper.Install(grid.GetNode(0, 0));
+
+      ndn::AppDelayTracer::InstallAll(runner.GetTraceFile("app-delays-trace.txt"));
+    });
+
+  Simulator::Destroy();
+
+  return failed == 0 ? 0 : 1;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-replay.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+
+/**
+ * This scenario replays a request trace with several consumers sharing one router:
+ *
+ *      +------------+
+ *      | consumer 0 | <---+
+ *      +------------+     |       10Mbps      +--------+     10Mbps      +----------+
+ *            ...          +-----------------> | router | <-------------> | producer |
+ *      +------------+     |         10ms      +--------+        10ms     +----------+
+ *      | consumer N | <---+
+ *      +------------+
+ *
+ * The binary request trace (--trace) is split among the consumers (ConsumerTrace with
+ * ShardIndex and ShardCount).  A text trace (--text, lines "<time in s> <name> <size>") is
+ * converted to the binary trace first; without either, a synthetic trace of 10 seconds of
+ * Zipf-distributed requests for /content/<i> is generated.  The router caches Data, see the
+ * cache hit ratio in cs-trace.txt:
+ *
+ *     ./waf --run="ndn-trace-replay --text=requests.txt --consumers=4"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(100));
+
+  std::string traceFile = "requests.bin";
+  std::string textFile;
+  uint32_t nConsumers = 4;
+
+  CommandLine cmd;
+  cmd.AddValue("trace", "Binary request trace", traceFile);
+  cmd.AddValue("text", "Text request trace to convert to the binary trace", textFile);
+  cmd.AddValue("consumers", "Number of consumers replaying the trace", nConsumers);
+  cmd.Parse(argc, argv);
+
+  if (!textFile.empty()) {
+    std::ifstream is(textFile.c_str());
+    if (!ndn::RequestTrace::ConvertFromText(is, traceFile)) {
+      std::cerr << "Cannot convert " << textFile << " to " << traceFile << std::endl;
+      return 1;
+    }
+  }
+  else if (ndn::RequestTrace::Open(traceFile) == nullptr) {
+    std::stringstream requests;
+    Ptr<ZipfRandomVariable> popularity = CreateObject<ZipfRandomVariable>();
+    popularity->SetAttribute("N", IntegerValue(1000));
+    popularity->SetAttribute("Alpha", DoubleValue(0.8));
+    for (int i = 0; i < 5000; i++) {
+      requests << i * 0.002 << " /content/" << popularity->GetInteger() << " 1024\n";
+    }
+    if (!ndn::RequestTrace::ConvertFromText(requests, traceFile)) {
+      std::cerr << "Cannot write " << traceFile << std::endl;
+      return 1;
+    }
+  }
+
+  NodeContainer consumers;
+  consumers.Create(nConsumers);
+  Ptr<Node> router = CreateObject<Node>();
+  Ptr<Node> producer = CreateObject<Node>();
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < nConsumers; i++) {
+    p2p.Install(consumers.Get(i), router);
+  }
+  p2p.Install(router, producer);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+  routingHelper.AddOrigins("/", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // every consumer replays its part of the trace
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerTrace");
+  consumerHelper.SetAttribute("TraceFile", StringValue(traceFile));
+  consumerHelper.SetAttribute("ShardCount", UintegerValue(nConsumers));
+  for (uint32_t i = 0; i < nConsumers; i++) {
+    consumerHelper.SetAttribute("ShardIndex", UintegerValue(i));
+    consumerHelper.Install(consumers.Get(i));
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndn::CsTracer::Install(router, "cs-trace.txt", Seconds(1));
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-to-text.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * Converts a binary columnar trace of L3RateTracer, CsTracer, AppDelayTracer or L2RateTracer
+ * (written when the trace file name ends with .bin or .bin.gz) to the tab-separated text format
+ * the tracer writes otherwise:
+ *
+ *     ./waf --run="ndn-trace-to-text --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If output is -, the text is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary columnar trace (.bin or .bin.gz)", input);
+  cmd.AddValue("output", "Text trace, - for standard output", output);
+  cmd.Parse(argc, argv);
+
+  std::ofstream file;
+  if (output != "-") {
+    file.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open()) {
+      std::cerr << "Cannot open " << output << " for writing\n";
+      return 1;
+    }
+  }
+
+  if (!ndn::ColumnarTraceReader::ConvertToText(input, output != "-" ? file : std::cout)) {
+    std::cerr << input << " is not a columnar trace of a supported version\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-tree-mpi.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/mpi-interface.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#else
+#error "ndn-tree-mpi scenario can be compiled only if NS3_MPI is enabled"
+#endif
+
+namespace ns3 {
+
+/**
+ * This scenario simulates the 25-node tree topology (topo-tree-25-node.txt) using MPI, with
+ * nodes automatically assigned to as many partitions as there are MPI processes.
+ *
+ * AnnotatedTopologyReader::SetPartitions replaces the system IDs of the topology file with
+ * partitions computed by ndn::PartitionHelper, which keeps links with small delay inside
+ * partitions to maximize the lookahead of the distributed simulator.  Applications are
+ * installed on all nodes; AppHelper installs them only on nodes of the local partition.
+ *
+ * Every consumer SrcN requests Data from producer Dst(10-N) with frequency 100 interests per
+ * second.
+ *
+ * To run scenario, use the following command:
+ *
+ *     mpirun -np 4 ./waf --run=ndn-tree-mpi
+ */
+
+int
+main(int argc, char* argv[])
+{
+  bool nullmsg = false;
+
+  CommandLine cmd;
+  cmd.AddValue("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+  cmd.Parse(argc, argv);
+
+  if (nullmsg) {
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::NullMessageSimulatorImpl"));
+  }
+  else {
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::DistributedSimulatorImpl"));
+  }
+
+  MpiInterface::Enable(&argc, &argv);
+
+  AnnotatedTopologyReader topologyReader("", 10);
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-tree-25-node.txt");
+  topologyReader.SetPartitions(); // one partition per MPI process
+  topologyReader.Read();
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+
+  for (int i = 1; i <= 9; i++) {
+    std::string prefix = "/dst" + std::to_string(10 - i);
+
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.Install(Names::Find<Node>("Src" + std::to_string(i)));
+
+    Ptr<Node> producer = Names::Find<Node>("Dst" + std::to_string(10 - i));
+    ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+    producerHelper.SetPrefix(prefix);
+    producerHelper.Install(producer);
+  }
+
+  // Calculate and install FIBs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  MpiInterface::Disable();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
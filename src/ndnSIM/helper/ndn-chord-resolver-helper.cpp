@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-chord-resolver-helper.hpp"
+#include "ndn-strategy-choice-helper.hpp"
+
+#include "model/ndn-chord-name-resolver.hpp"
+#include "model/ndn-chord-resolver-strategy.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/chord-ipv4.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ChordResolverHelper");
+
+namespace ns3 {
+namespace ndn {
+
+ChordResolverHelper::ChordResolverHelper()
+{
+  m_resolverFactory.SetTypeId(ChordNameResolver::GetTypeId());
+}
+
+void
+ChordResolverHelper::SetResolverAttribute(const std::string& name, const AttributeValue& value)
+{
+  m_resolverFactory.Set(name, value);
+}
+
+void
+ChordResolverHelper::Install(Ptr<Node> node, const Name& namePrefix) const
+{
+  NS_ASSERT_MSG(node->GetObject<ChordNameResolver>() == 0,
+                "ChordNameResolver is already installed on node " << node->GetId());
+
+  Ptr<ChordIpv4> chord;
+  for (uint32_t i = 0; i < node->GetNApplications() && chord == 0; i++) {
+    chord = DynamicCast<ChordIpv4>(node->GetApplication(i));
+  }
+  NS_ASSERT_MSG(chord != 0, "ChordIpv4 has to be installed on node " << node->GetId());
+
+  Ptr<ChordNameResolver> resolver = m_resolverFactory.Create<ChordNameResolver>();
+  node->AggregateObject(resolver);
+  resolver->SetChord(chord);
+
+  StrategyChoiceHelper::Install<ChordResolverStrategy>(node, namePrefix);
+}
+
+void
+ChordResolverHelper::Install(const NodeContainer& nodes, const Name& namePrefix) const
+{
+  for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+    Install(*i, namePrefix);
+  }
+}
+
+void
+ChordResolverHelper::InstallAll(const Name& namePrefix) const
+{
+  Install(NodeContainer::GetGlobal(), namePrefix);
+}
+
+void
+ChordResolverHelper::RegisterPrefix(Ptr<Node> node, const Name& prefix, Time delay)
+{
+  Ptr<ChordNameResolver> resolver = node->GetObject<ChordNameResolver>();
+  NS_ASSERT_MSG(resolver != 0, "ChordNameResolver is not installed on node " << node->GetId());
+
+  Simulator::ScheduleWithContext(node->GetId(), delay, &ChordNameResolver::RegisterPrefix,
+                                 resolver, prefix);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHORD_RESOLVER_HELPER_H
+#define NDN_CHORD_RESOLVER_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+
+namespace ns3 {
+
+class Node;
+class NodeContainer;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper installing Chord-based name resolution (ChordNameResolver and
+ *        ChordResolverStrategy) on nodes
+ *
+ * Nodes must have NDN stack and ChordIpv4 application installed.  Chord locator prefixes
+ * (ChordNdnTransport::GetLocatorPrefix) have to be routable, e.g., using GlobalRoutingHelper.
+ */
+class ChordResolverHelper {
+public:
+  ChordResolverHelper();
+
+  /**
+   * @brief Set attribute of ChordNameResolver objects created by this helper
+   */
+  void
+  SetResolverAttribute(const std::string& name, const AttributeValue& value);
+
+  /**
+   * @brief Install resolver on the node and use ChordResolverStrategy for @p namePrefix
+   */
+  void
+  Install(Ptr<Node> node, const Name& namePrefix = "/") const;
+
+  void
+  Install(const NodeContainer& nodes, const Name& namePrefix = "/") const;
+
+  void
+  InstallAll(const Name& namePrefix = "/") const;
+
+  /**
+   * @brief Announce @p node as producer of @p prefix after @p delay
+   *
+   * ChordIpv4 on the node must be running at that time
+   */
+  static void
+  RegisterPrefix(Ptr<Node> node, const Name& prefix, Time delay = Seconds(0));
+
+private:
+  ObjectFactory m_resolverFactory;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHORD_RESOLVER_HELPER_H
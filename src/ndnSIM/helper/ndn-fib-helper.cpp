@@ -50,6 +50,17 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (!l3protocol->hasManagement()) {
+    // lightweight node: update FIB directly, the same way FibManager does
+    nfd::Face* face = l3protocol->getForwarder()->getFaceTable().get(parameters.getFaceId());
+    NS_ASSERT_MSG(face != nullptr, "Face with ID [" << parameters.getFaceId() << "] does not exist");
+
+    nfd::fib::Entry* entry = l3protocol->getForwarder()->getFib().insert(parameters.getName()).first;
+    entry->addNextHop(*face, parameters.getCost());
+    return;
+  }
+
   NS_LOG_DEBUG("Add Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -60,13 +71,25 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (!l3protocol->hasManagement()) {
+    nfd::Face* face = l3protocol->getForwarder()->getFaceTable().get(parameters.getFaceId());
+    nfd::fib::Entry* entry = l3protocol->getForwarder()->getFib().findExactMatch(parameters.getName());
+    if (face != nullptr && entry != nullptr) {
+      entry->removeNextHop(*face);
+      if (!entry->hasNextHops()) {
+        l3protocol->getForwarder()->getFib().erase(*entry);
+      }
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Remove Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -77,10 +100,40 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  shared_ptr<nfd::Forwarder> forwarder = ndn->getForwarder();
+  nfd::Fib& fib = forwarder->getFib();
+
+  // Most routes share all but the last component with an existing entry
+  forwarder->getNameTree().reserve(forwarder->getNameTree().size() + routes.size());
+
+  const Name* lastPrefix = nullptr;
+  nfd::fib::Entry* entry = nullptr;
+  for (const Route& route : routes) {
+    NS_ASSERT(route.face != nullptr);
+
+    if (route.prefix != lastPrefix) {
+      if (route.prefix->size() > nfd::Fib::getMaxDepth()) {
+        NS_LOG_WARN("Cannot add route " << *route.prefix << ": FIB entry prefix cannot exceed "
+                    << nfd::Fib::getMaxDepth() << " components");
+        lastPrefix = nullptr;
+        continue;
+      }
+      entry = fib.insert(*route.prefix).first;
+      lastPrefix = route.prefix;
+    }
+    entry->addNextHop(*route.face, route.cost);
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric)
 {
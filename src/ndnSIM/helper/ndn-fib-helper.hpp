@@ -43,6 +43,31 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * \brief Precomputed route for AddRoutes
+   *
+   * The route does not own the prefix; it must stay valid until AddRoutes returns.
+   */
+  struct Route {
+    const Name* prefix;
+    Face* face;
+    uint32_t cost;
+  };
+
+  /**
+   * \brief Add a batch of precomputed routes to FIB of the node
+   *
+   * Unlike AddRoute, the routes are inserted directly into nfd::Fib without generating FIB
+   * management commands.  NameTree is expanded once for the whole batch, and consecutive routes
+   * with the same prefix object share one FIB lookup, so routes to the same prefix should be
+   * placed next to each other.
+   *
+   * \param node   Node
+   * \param routes Routes, faces must belong to the node
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -47,16 +47,12 @@
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
 
-#include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
 #include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
@@ -214,176 +210,447 @@ GlobalRoutingHelper::AddOriginsForAll()
   }
 }
 
-void
-GlobalRoutingHelper::CalculateRoutes()
-{
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+/// @cond include_hidden
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+/**
+ * @brief Adjacency arrays of GlobalRouter graph
+ *
+ * Out edges of vertex i are edges[offsets[i]] .. edges[offsets[i + 1] - 1]
+ */
+struct RoutingAdjacency {
+  struct Edge {
+    uint32_t target;
+    uint32_t weight;
+    shared_ptr<Face> face; // nullptr for edges from multi-access channels
+  };
+
+  std::vector<uint32_t> offsets;
+  std::vector<Edge> edges;
+};
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+/**
+ * @brief Snapshot of GlobalRouter graph used for route calculation
+ *
+ * Vertices, edges and exported prefixes are copied into flat arrays, so that shortest path trees
+ * of different sources can be calculated concurrently without touching ns-3 or NFD objects.
+ * Edges that are down (see GlobalRouter::SetIncidencyUp) are excluded.
+ */
+class RoutingGraph {
+public:
+  RoutingGraph()
+    : nNodes(0)
+  {
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+      if (gr != 0)
+        addVertex(gr);
+    }
+    nNodes = vertices.size();
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+    for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+         channel++) {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+      if (gr != 0)
+        addVertex(gr);
     }
 
-    boost::DistancesMap distances;
+    for (uint32_t i = 0; i < vertices.size(); i++) {
+      adjacency.offsets.push_back(adjacency.edges.size());
+      for (const auto& incidency : vertices[i]->GetIncidencies()) {
+        const shared_ptr<Face>& face = std::get<1>(incidency);
+        if (face != nullptr && !vertices[i]->IsIncidencyUp(face.get()))
+          continue;
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+        auto target = index.find(PeekPointer(std::get<2>(incidency)));
+        NS_ASSERT(target != index.end());
+        adjacency.edges.push_back({target->second, getWeight(face), face});
+      }
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+      if (!vertices[i]->GetLocalPrefixes().empty()) {
+        origins.push_back(i);
+      }
+    }
+    adjacency.offsets.push_back(adjacency.edges.size());
+  }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+  static uint32_t
+  getWeight(const shared_ptr<Face>& face)
+  {
+    return face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric());
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
+  /**
+   * @brief Adjacency arrays with all edges reversed, to calculate distances towards a vertex
+   */
+  RoutingAdjacency
+  reverse() const
+  {
+    RoutingAdjacency reversed;
+    std::vector<uint32_t> inDegrees(vertices.size() + 1, 0);
+    for (const auto& edge : adjacency.edges) {
+      inDegrees[edge.target + 1]++;
+    }
+    for (uint32_t i = 1; i < inDegrees.size(); i++) {
+      inDegrees[i] += inDegrees[i - 1];
+    }
+    reversed.offsets = inDegrees;
+    reversed.edges.resize(adjacency.edges.size());
+    for (uint32_t u = 0; u < vertices.size(); u++) {
+      for (uint32_t e = adjacency.offsets[u]; e < adjacency.offsets[u + 1]; e++) {
+        const auto& edge = adjacency.edges[e];
+        reversed.edges[inDegrees[edge.target]++] = {u, edge.weight, nullptr};
       }
     }
+    return reversed;
   }
-}
 
-void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
-{
+  int32_t
+  find(Ptr<GlobalRouter> gr) const
+  {
+    auto i = index.find(PeekPointer(gr));
+    return i == index.end() ? -1 : i->second;
+  }
+
+private:
+  void
+  addVertex(Ptr<GlobalRouter> gr)
+  {
+    index[PeekPointer(gr)] = vertices.size();
+    vertices.push_back(gr);
+  }
+
+public:
+  std::vector<Ptr<GlobalRouter>> vertices; ///< @brief nodes first, then multi-access channels
+  uint32_t nNodes;
+  RoutingAdjacency adjacency;
+  std::vector<uint32_t> origins; ///< @brief vertices with locally exported prefixes
+  std::unordered_map<const GlobalRouter*, uint32_t> index;
+};
+
+/**
+ * @brief Dijkstra's shortest path tree with reusable per-thread arrays
+ */
+class ShortestPathTree {
+public:
+  static const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+  static const uint32_t INF = std::numeric_limits<uint32_t>::max();
+
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * @brief Calculate distances and first hops from source
+   * @param onlyEdge If not NONE, the only out edge of source that can be used
    */
+  void
+  calculate(const RoutingAdjacency& graph, uint32_t source, uint32_t onlyEdge = NONE)
+  {
+    distance.assign(graph.offsets.size() - 1, INF);
+    firstEdge.assign(graph.offsets.size() - 1, NONE);
+    m_heap.clear();
+
+    distance[source] = 0;
+    m_heap.push_back(std::make_pair(0, source));
+    while (!m_heap.empty()) {
+      std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<std::pair<uint32_t, uint32_t>>());
+      uint32_t d = m_heap.back().first;
+      uint32_t u = m_heap.back().second;
+      m_heap.pop_back();
+      if (d > distance[u])
+        continue;
+
+      for (uint32_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+        if (u == source && onlyEdge != NONE && e != onlyEdge)
+          continue;
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+        const auto& edge = graph.edges[e];
+        uint64_t newDistance = static_cast<uint64_t>(d) + edge.weight;
+        if (newDistance < distance[edge.target]) {
+          distance[edge.target] = newDistance;
+          firstEdge[edge.target] = (u == source) ? e : firstEdge[u];
+          m_heap.push_back(std::make_pair(newDistance, edge.target));
+          std::push_heap(m_heap.begin(), m_heap.end(), std::greater<std::pair<uint32_t, uint32_t>>());
+        }
+      }
+    }
+  }
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  std::vector<uint32_t> distance;
+  std::vector<uint32_t> firstEdge; ///< @brief out edge of source on the shortest path
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+private:
+  std::vector<std::pair<uint32_t, uint32_t>> m_heap;
+};
+
+const uint32_t ShortestPathTree::NONE;
+const uint32_t ShortestPathTree::INF;
+
+struct CalculatedRoute {
+  const shared_ptr<Name>* prefix;
+  uint32_t edge;
+  uint32_t cost;
+};
+
+typedef std::function<void(ShortestPathTree&, uint32_t, std::vector<CalculatedRoute>&)> RouteCalculation;
+
+static uint32_t g_nThreads = 0;
+static bool g_isIncremental = false;
+
+// Number of sources whose routes are kept in memory before being installed into FIBs
+static const uint32_t ROUTE_BATCH_SIZE = 1024;
+
+static void
+collectRoutes(const RoutingGraph& graph, const ShortestPathTree& tree, uint32_t source,
+              std::vector<CalculatedRoute>& routes)
+{
+  for (uint32_t origin : graph.origins) {
+    if (origin == source || tree.firstEdge[origin] == ShortestPathTree::NONE)
       continue;
+
+    for (const auto& prefix : graph.vertices[origin]->GetLocalPrefixes()) {
+      routes.push_back({&prefix, tree.firstEdge[origin], tree.distance[origin]});
     }
+  }
+}
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+static void
+removeInstalledRoutes(Ptr<GlobalRouter> gr)
+{
+  nfd::Fib& fib = gr->GetL3Protocol()->getForwarder()->getFib();
+  for (const auto& route : gr->GetInstalledRoutes()) {
+    nfd::fib::Entry* entry = fib.findExactMatch(*route.first);
+    if (entry == nullptr)
+      continue;
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+    entry->removeNextHop(*route.second);
+    if (!entry->hasNextHops()) {
+      fib.erase(*entry);
+    }
+  }
+  gr->GetInstalledRoutes().clear();
+}
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+/**
+ * @brief Install all routes of one node with one FibHelper::AddRoutes call
+ */
+static void
+installRoutes(const RoutingGraph& graph, uint32_t source,
+              const std::vector<CalculatedRoute>& routes, std::vector<FibHelper::Route>& fibRoutes)
+{
+  Ptr<GlobalRouter> gr = graph.vertices[source];
+
+  NS_LOG_DEBUG("Reachability from Node: " << gr->GetObject<Node>()->GetId());
+  fibRoutes.clear();
+  for (const auto& route : routes) {
+    const shared_ptr<Face>& face = graph.adjacency.edges[route.edge].face;
+    NS_LOG_DEBUG(" prefix " << **route.prefix << " reachable via face " << *face
+                 << " with distance " << route.cost);
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+    fibRoutes.push_back({route.prefix->get(), face.get(), route.cost});
+
+    if (g_isIncremental) {
+      gr->GetInstalledRoutes().push_back(std::make_pair(*route.prefix, face));
     }
+  }
 
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-        continue;
+  FibHelper::AddRoutes(gr->GetObject<Node>(), fibRoutes);
+}
+
+/**
+ * @brief Calculate routes of sources in parallel and install them, one batch of sources at a time
+ */
+static void
+calculateAndInstallRoutes(const RoutingGraph& graph, const std::vector<uint32_t>& sources,
+                          const RouteCalculation& calculation)
+{
+  uint32_t nThreads = g_nThreads;
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::vector<std::vector<CalculatedRoute>> routes;
+  std::vector<FibHelper::Route> fibRoutes;
+  for (size_t batchStart = 0; batchStart < sources.size(); batchStart += ROUTE_BATCH_SIZE) {
+    size_t batchSize = std::min<size_t>(ROUTE_BATCH_SIZE, sources.size() - batchStart);
+    routes.assign(batchSize, std::vector<CalculatedRoute>());
+
+    std::atomic<size_t> next(0);
+    auto worker = [&] {
+      ShortestPathTree tree;
+      for (size_t i = next++; i < batchSize; i = next++) {
+        calculation(tree, sources[batchStart + i], routes[i]);
       }
+    };
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < std::min<size_t>(nThreads, batchSize); i++) {
+      threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
 
-      boost::DistancesMap distances;
+    // FIB and NameTree are not thread-safe
+    for (size_t i = 0; i < batchSize; i++) {
+      installRoutes(graph, sources[batchStart + i], routes[i], fibRoutes);
+    }
+  }
+}
 
-      NS_LOG_DEBUG("-----------");
+static std::vector<uint32_t>
+getAllSources(const RoutingGraph& graph)
+{
+  std::vector<uint32_t> sources;
+  for (uint32_t i = 0; i < graph.nNodes; i++) {
+    if (graph.vertices[i]->GetL3Protocol() != 0) {
+      sources.push_back(i);
+    }
+  }
+  return sources;
+}
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+/// @endcond
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+void
+GlobalRoutingHelper::CalculateRoutes()
+{
+  // Dijkstra for every node.  Shortest path trees of different nodes are calculated in parallel
+  // on a snapshot of GlobalRouter graph (see SetNumberOfThreads)
+  RoutingGraph graph;
+  std::vector<uint32_t> sources = getAllSources(graph);
+
+  if (g_isIncremental) {
+    for (uint32_t source : sources) {
+      removeInstalledRoutes(graph.vertices[source]);
+    }
+  }
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
-      }
+  calculateAndInstallRoutes(graph, sources,
+                            [&graph] (ShortestPathTree& tree, uint32_t source,
+                                      std::vector<CalculatedRoute>& routes) {
+                              tree.calculate(graph.adjacency, source);
+                              collectRoutes(graph, tree, source, routes);
+                            });
+}
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  // For every node, Dijkstra is run once per face with only that face enabled on the node.
+  // Routes to every prefix origin are installed via each face with the cost of the shortest
+  // path that starts with the face
+  RoutingGraph graph;
+  std::vector<uint32_t> sources = getAllSources(graph);
+
+  if (g_isIncremental) {
+    for (uint32_t source : sources) {
+      removeInstalledRoutes(graph.vertices[source]);
     }
+  }
+
+  calculateAndInstallRoutes(graph, sources,
+                            [&graph] (ShortestPathTree& tree, uint32_t source,
+                                      std::vector<CalculatedRoute>& routes) {
+                              for (uint32_t edge = graph.adjacency.offsets[source];
+                                   edge < graph.adjacency.offsets[source + 1]; edge++) {
+                                tree.calculate(graph.adjacency, source, edge);
+                                collectRoutes(graph, tree, source, routes);
+                              }
+                              // routes to the same prefix next to each other for AddRoutes
+                              std::stable_sort(routes.begin(), routes.end(),
+                                               [] (const CalculatedRoute& a, const CalculatedRoute& b) {
+                                                 return a.prefix < b.prefix;
+                                               });
+                            });
+}
+
+void
+GlobalRoutingHelper::SetNumberOfThreads(uint32_t nThreads)
+{
+  g_nThreads = nThreads;
+}
+
+void
+GlobalRoutingHelper::EnableIncrementalUpdates(bool isEnabled)
+{
+  g_isIncremental = isEnabled;
+}
+
+void
+GlobalRoutingHelper::UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
+{
+  if (!g_isIncremental)
+    return;
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+  Ptr<GlobalRouter> gr1 = node1->GetObject<GlobalRouter>();
+  Ptr<GlobalRouter> gr2 = node2->GetObject<GlobalRouter>();
+  if (gr1 == 0 || gr2 == 0)
+    return;
+
+  shared_ptr<Face> face1, face2;
+  for (const auto& incidency : gr1->GetIncidencies()) {
+    if (std::get<2>(incidency) == gr2)
+      face1 = std::get<1>(incidency);
+  }
+  for (const auto& incidency : gr2->GetIncidencies()) {
+    if (std::get<2>(incidency) == gr1)
+      face2 = std::get<1>(incidency);
+  }
+  if (face1 == nullptr || face2 == nullptr) {
+    NS_LOG_WARN("No point-to-point link between nodes " << node1->GetId() << " and "
+                << node2->GetId() << " in GlobalRouter graph");
+    return;
+  }
+
+  // Distances towards both ends of the link before the change tell which sources can have
+  // (when the link goes down) or can get (when the link goes up) a shortest path over the link
+  std::vector<uint32_t> affected;
+  {
+    RoutingGraph graph;
+    RoutingAdjacency reversed = graph.reverse();
+    uint32_t u = graph.find(gr1);
+    uint32_t v = graph.find(gr2);
+
+    ShortestPathTree toU, toV;
+    toU.calculate(reversed, u);
+    toV.calculate(reversed, v);
+
+    uint64_t weight1 = RoutingGraph::getWeight(face1);
+    uint64_t weight2 = RoutingGraph::getWeight(face2);
+    for (uint32_t source : getAllSources(graph)) {
+      uint64_t du = toU.distance[source];
+      uint64_t dv = toV.distance[source];
+      bool isAffected = false;
+      if (isUp) {
+        isAffected = (du != ShortestPathTree::INF && du + weight1 <= dv)
+                     || (dv != ShortestPathTree::INF && dv + weight2 <= du);
+      }
+      else {
+        isAffected = (du != ShortestPathTree::INF && du + weight1 == dv)
+                     || (dv != ShortestPathTree::INF && dv + weight2 == du);
+      }
+      if (isAffected) {
+        affected.push_back(source);
+      }
     }
   }
+
+  gr1->SetIncidencyUp(face1, isUp);
+  gr2->SetIncidencyUp(face2, isUp);
+
+  RoutingGraph graph;
+  NS_LOG_DEBUG("Link " << node1->GetId() << " - " << node2->GetId() << (isUp ? " up" : " down")
+               << ", recalculating routes of " << affected.size() << " out of " << graph.nNodes
+               << " nodes");
+
+  for (uint32_t source : affected) {
+    removeInstalledRoutes(graph.vertices[source]);
+  }
+
+  calculateAndInstallRoutes(graph, affected,
+                            [&graph] (ShortestPathTree& tree, uint32_t source,
+                                      std::vector<CalculatedRoute>& routes) {
+                              tree.calculate(graph.adjacency, source);
+                              collectRoutes(graph, tree, source, routes);
+                            });
 }
 
 } // namespace ndn
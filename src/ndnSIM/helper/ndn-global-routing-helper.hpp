@@ -111,6 +111,40 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set number of threads used to calculate shortest path trees
+   *
+   * Shortest path trees of different sources are calculated in parallel, FIB entries are
+   * installed afterwards, one node at a time.
+   *
+   * @param nThreads Number of threads, 0 (default) uses all hardware threads
+   */
+  static void
+  SetNumberOfThreads(uint32_t nThreads);
+
+  /**
+   * @brief Enable or disable incremental route updates
+   *
+   * When enabled, LinkControlHelper::FailLink and LinkControlHelper::UpLink exclude (include)
+   * the link from route calculation and recalculate routes of only those nodes whose shortest
+   * paths can be affected by the change.  Routes must be calculated with CalculateRoutes after
+   * enabling incremental updates.
+   */
+  static void
+  EnableIncrementalUpdates(bool isEnabled = true);
+
+  /**
+   * @brief Recalculate routes affected by the change of the link between node1 and node2
+   *
+   * Called by LinkControlHelper.  Does nothing unless incremental updates are enabled.
+   *
+   * @param node1 One end of point-to-point link
+   * @param node2 Another end of point-to-point link
+   * @param isUp  New status of the link
+   */
+  static void
+  UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp);
+
 private:
   void
   Install(Ptr<Channel> channel);
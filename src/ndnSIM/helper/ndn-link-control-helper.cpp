@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-link-control-helper.hpp"
+#include "ndn-global-routing-helper.hpp"
 
 #include "ns3/assert.h"
 #include "ns3/names.h"
@@ -95,6 +96,7 @@ void
 LinkControlHelper::FailLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, 1.0);
+  GlobalRoutingHelper::UpdateLink(node1, node2, false);
 }
 
 void
@@ -107,6 +109,7 @@ void
 LinkControlHelper::UpLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
+  GlobalRoutingHelper::UpdateLink(node1, node2, true);
 }
 
 void
@@ -43,6 +43,8 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * With GlobalRoutingHelper::EnableIncrementalUpdates, routes that use the link are recalculated
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +75,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * With GlobalRoutingHelper::EnableIncrementalUpdates, routes that can use the link are
+   * recalculated
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-partition-helper.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <numeric>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+PartitionHelper::PartitionHelper()
+  : m_imbalance(0.1)
+  , m_nPartitions(1)
+{
+}
+
+void
+PartitionHelper::AddNode(const std::string& name, double weight)
+{
+  NS_ASSERT_MSG(m_index.count(name) == 0, "Node " << name << " is already added");
+
+  m_index[name] = m_weights.size();
+  m_weights.push_back(weight);
+}
+
+void
+PartitionHelper::AddLink(const std::string& node1, const std::string& node2, const Time& delay)
+{
+  auto index1 = m_index.find(node1);
+  NS_ASSERT_MSG(index1 != m_index.end(), node1 << " node not found");
+  auto index2 = m_index.find(node2);
+  NS_ASSERT_MSG(index2 != m_index.end(), node2 << " node not found");
+
+  m_links.push_back({index1->second, index2->second, delay});
+}
+
+void
+PartitionHelper::SetImbalance(double imbalance)
+{
+  m_imbalance = imbalance;
+}
+
+void
+PartitionHelper::Partition(uint32_t nPartitions)
+{
+  m_nPartitions = std::max<uint32_t>(nPartitions, 1);
+  m_partitions.assign(m_weights.size(), 0);
+  if (m_nPartitions == 1 || m_weights.empty()) {
+    return;
+  }
+
+  // candidate lookaheads: links with smaller delay are contracted
+  std::vector<Time> thresholds;
+  for (const LinkInfo& link : m_links) {
+    thresholds.push_back(link.delay);
+  }
+  thresholds.push_back(Time::Max()); // only links between disconnected parts of the topology
+  std::sort(thresholds.begin(), thresholds.end());
+  thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+
+  // without contraction (the smallest threshold), the assignment is used even if unbalanced
+  Assign(m_nPartitions, thresholds.front(), m_partitions);
+
+  size_t low = 0;
+  size_t high = thresholds.size() - 1;
+  std::vector<uint32_t> partitions;
+  while (low < high) {
+    size_t middle = (low + high + 1) / 2;
+    if (Assign(m_nPartitions, thresholds[middle], partitions)) {
+      low = middle;
+      m_partitions.swap(partitions);
+    }
+    else {
+      high = middle - 1;
+    }
+  }
+
+  NS_LOG_INFO(m_weights.size() << " nodes in " << m_nPartitions << " partitions, lookahead "
+              << GetLookahead().As(Time::MS) << ", " << GetNCutLinks() << " links between "
+              << "partitions");
+}
+
+bool
+PartitionHelper::Assign(uint32_t nPartitions, const Time& threshold,
+                        std::vector<uint32_t>& partitions) const
+{
+  size_t nNodes = m_weights.size();
+
+  // groups of nodes connected by links with delay below the threshold
+  std::vector<uint32_t> parent(nNodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent] (uint32_t node) {
+    while (parent[node] != node) {
+      parent[node] = parent[parent[node]];
+      node = parent[node];
+    }
+    return node;
+  };
+
+  for (const LinkInfo& link : m_links) {
+    if (link.delay < threshold) {
+      parent[find(link.node1)] = find(link.node2);
+    }
+  }
+
+  std::vector<uint32_t> group(nNodes);
+  std::vector<uint32_t> groupIndex(nNodes, nNodes);
+  std::vector<double> groupWeights;
+  for (uint32_t node = 0; node < nNodes; node++) {
+    uint32_t root = find(node);
+    if (groupIndex[root] == nNodes) {
+      groupIndex[root] = groupWeights.size();
+      groupWeights.push_back(0);
+    }
+    group[node] = groupIndex[root];
+    groupWeights[group[node]] += m_weights[node];
+  }
+
+  if (groupWeights.size() < nPartitions && groupWeights.size() < nNodes) {
+    return false;
+  }
+
+  std::vector<std::vector<uint32_t>> neighbors(groupWeights.size());
+  for (const LinkInfo& link : m_links) {
+    if (group[link.node1] != group[link.node2]) {
+      neighbors[group[link.node1]].push_back(group[link.node2]);
+      neighbors[group[link.node2]].push_back(group[link.node1]);
+    }
+  }
+
+  // largest groups first, each to the partition with most links to it
+  std::vector<uint32_t> order(groupWeights.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&groupWeights] (uint32_t a, uint32_t b) {
+    return groupWeights[a] > groupWeights[b];
+  });
+
+  double limit = (1 + m_imbalance) * std::accumulate(m_weights.begin(), m_weights.end(), 0.0)
+                 / nPartitions;
+  bool isBalanced = true;
+
+  std::vector<double> loads(nPartitions, 0);
+  std::vector<uint32_t> groupPartitions(groupWeights.size(), nPartitions);
+  std::vector<uint32_t> nLinks(nPartitions);
+  for (uint32_t g : order) {
+    std::fill(nLinks.begin(), nLinks.end(), 0);
+    for (uint32_t neighbor : neighbors[g]) {
+      if (groupPartitions[neighbor] != nPartitions) {
+        nLinks[groupPartitions[neighbor]]++;
+      }
+    }
+
+    uint32_t best = nPartitions;
+    uint32_t lightest = 0;
+    for (uint32_t p = 0; p < nPartitions; p++) {
+      if (loads[p] < loads[lightest]) {
+        lightest = p;
+      }
+      if (loads[p] + groupWeights[g] > limit) {
+        continue;
+      }
+      if (best == nPartitions || nLinks[p] > nLinks[best]
+          || (nLinks[p] == nLinks[best] && loads[p] < loads[best])) {
+        best = p;
+      }
+    }
+
+    if (best == nPartitions) {
+      isBalanced = false;
+      best = lightest;
+    }
+    groupPartitions[g] = best;
+    loads[best] += groupWeights[g];
+  }
+
+  if (nNodes >= nPartitions) {
+    std::vector<bool> isUsed(nPartitions, false);
+    for (uint32_t g = 0; g < groupPartitions.size(); g++) {
+      isUsed[groupPartitions[g]] = true;
+    }
+    isBalanced = isBalanced && std::find(isUsed.begin(), isUsed.end(), false) == isUsed.end();
+  }
+
+  partitions.resize(nNodes);
+  for (uint32_t node = 0; node < nNodes; node++) {
+    partitions[node] = groupPartitions[group[node]];
+  }
+  return isBalanced;
+}
+
+uint32_t
+PartitionHelper::GetPartition(const std::string& name) const
+{
+  auto index = m_index.find(name);
+  NS_ASSERT_MSG(index != m_index.end(), name << " node not found");
+
+  return m_partitions.empty() ? 0 : m_partitions[index->second];
+}
+
+Time
+PartitionHelper::GetLookahead() const
+{
+  Time lookahead = Time::Max();
+  for (const LinkInfo& link : m_links) {
+    if (!m_partitions.empty() && m_partitions[link.node1] != m_partitions[link.node2]) {
+      lookahead = std::min(lookahead, link.delay);
+    }
+  }
+  return lookahead;
+}
+
+size_t
+PartitionHelper::GetNCutLinks() const
+{
+  return std::count_if(m_links.begin(), m_links.end(), [this] (const LinkInfo& link) {
+    return !m_partitions.empty() && m_partitions[link.node1] != m_partitions[link.node2];
+  });
+}
+
+std::vector<double>
+PartitionHelper::GetWeights() const
+{
+  std::vector<double> weights(m_nPartitions, 0);
+  for (uint32_t node = 0; node < m_weights.size(); node++) {
+    weights[m_partitions.empty() ? 0 : m_partitions[node]] += m_weights[node];
+  }
+  return weights;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to split a topology into partitions for the distributed simulator
+ *
+ * With the distributed simulator (MPI, DistributedSimulatorImpl or NullMessageSimulatorImpl),
+ * every partition (system ID of the nodes) is simulated by one process.  Processes can run
+ * independently for the lookahead, i.e., the smallest delay of the links between partitions,
+ * so the helper looks for partitions where all links between partitions have the largest
+ * possible delay, while the partitions have similar weight (e.g., number of nodes):
+ *
+ * - links with delay below a threshold are contracted, i.e., their nodes must be in the same
+ *   partition;
+ * - the resulting groups are assigned to partitions, largest first, preferably to the partition
+ *   with most links to the group, unless that partition would exceed its share of the total
+ *   weight by more than the allowed imbalance;
+ * - the largest threshold for which this succeeds is found by binary search over link delays.
+ *
+ * Nodes must be assigned to partitions when they are created, so the helper works with node
+ * names.  AnnotatedTopologyReader::SetPartitions uses the helper for topology files:
+ *
+ *     PartitionHelper partitioner;
+ *     partitioner.AddNode("A");
+ *     partitioner.AddNode("B");
+ *     partitioner.AddLink("A", "B", MilliSeconds(10));
+ *     partitioner.Partition(MpiInterface::GetSize());
+ *
+ *     Ptr<Node> a = CreateObject<Node>(partitioner.GetPartition("A"));
+ */
+class PartitionHelper {
+public:
+  PartitionHelper();
+
+  /**
+   * @brief Add node with @p weight (e.g., expected number of applications or events)
+   */
+  void
+  AddNode(const std::string& name, double weight = 1.0);
+
+  /**
+   * @brief Add link between two added nodes
+   */
+  void
+  AddLink(const std::string& node1, const std::string& node2, const Time& delay);
+
+  /**
+   * @brief Set by how much the weight of a partition may exceed the average (default 0.1)
+   */
+  void
+  SetImbalance(double imbalance);
+
+  /**
+   * @brief Assign nodes to @p nPartitions partitions
+   *
+   * If there are fewer nodes than partitions, some partitions stay empty.
+   */
+  void
+  Partition(uint32_t nPartitions);
+
+  /**
+   * @brief Get partition (system ID) of the node, 0 if Partition was not called
+   */
+  uint32_t
+  GetPartition(const std::string& name) const;
+
+  /**
+   * @brief Get smallest delay of links between partitions, Time::Max() if there are none
+   */
+  Time
+  GetLookahead() const;
+
+  /**
+   * @brief Get number of links between partitions
+   */
+  size_t
+  GetNCutLinks() const;
+
+  /**
+   * @brief Get weight of nodes in every partition
+   */
+  std::vector<double>
+  GetWeights() const;
+
+private:
+  /**
+   * @brief Assign groups of nodes connected by links with delay below @p threshold
+   * @return whether partitions are within the allowed imbalance and not empty
+   */
+  bool
+  Assign(uint32_t nPartitions, const Time& threshold, std::vector<uint32_t>& partitions) const;
+
+private:
+  struct LinkInfo
+  {
+    uint32_t node1;
+    uint32_t node2;
+    Time delay;
+  };
+
+  std::map<std::string, uint32_t> m_index;
+  std::vector<double> m_weights;
+  std::vector<LinkInfo> m_links;
+  double m_imbalance;
+
+  uint32_t m_nPartitions;
+  std::vector<uint32_t> m_partitions;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARTITION_HELPER_H
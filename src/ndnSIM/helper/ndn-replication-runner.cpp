@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-replication-runner.hpp"
+
+#include "utils/tracers/l2-rate-tracer.hpp"
+#include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-columnar-trace.hpp"
+#include "utils/tracers/ndn-cs-tracer.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include "ns3/ndnSIM/NFD/core/random.hpp"
+
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ReplicationRunner");
+
+namespace ns3 {
+namespace ndn {
+
+ReplicationRunner::ReplicationRunner()
+  : m_firstRun(1)
+  , m_nRuns(10)
+  , m_jobs(0)
+  , m_run(0)
+{
+}
+
+void
+ReplicationRunner::SetRuns(uint32_t firstRun, uint32_t nRuns)
+{
+  m_firstRun = firstRun;
+  m_nRuns = nRuns;
+}
+
+void
+ReplicationRunner::SetJobs(uint32_t jobs)
+{
+  m_jobs = jobs;
+}
+
+void
+ReplicationRunner::AddTrace(const std::string& file)
+{
+  m_traces.push_back(file);
+}
+
+std::string
+ReplicationRunner::GetTraceFile(const std::string& file) const
+{
+  if (m_run == 0) {
+    return file;
+  }
+  return GetShardFile(file, m_run);
+}
+
+uint32_t
+ReplicationRunner::GetRun() const
+{
+  return m_run;
+}
+
+std::string
+ReplicationRunner::GetShardFile(const std::string& file, uint32_t run)
+{
+  // insert run number before the extension (".bin.gz" counts as one extension)
+  size_t directory = file.rfind('/');
+  size_t base = directory == std::string::npos ? 0 : directory + 1;
+  size_t end = file.size();
+  if (boost::algorithm::ends_with(file, ".gz")) {
+    end -= 3;
+  }
+  size_t extension = file.rfind('.', end - 1);
+  if (extension == std::string::npos || extension <= base) {
+    extension = file.size();
+  }
+  return file.substr(0, extension) + ".run-" + std::to_string(run) + file.substr(extension);
+}
+
+uint32_t
+ReplicationRunner::Run(const ReplicationCallback& setup, const ReplicationCallback& finish)
+{
+  NS_ASSERT_MSG(m_run == 0, "Replications cannot be started from a replication");
+
+  uint32_t jobs = m_jobs;
+  if (jobs == 0) {
+    jobs = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1L);
+  }
+  NS_LOG_INFO("Running " << m_nRuns << " replications on " << jobs << " workers");
+
+  std::map<pid_t, uint32_t> workers;
+  std::vector<uint32_t> runs;
+  uint32_t failed = 0;
+  uint32_t next = m_firstRun;
+  while (next < m_firstRun + m_nRuns || !workers.empty()) {
+    while (next < m_firstRun + m_nRuns && workers.size() < jobs) {
+      // otherwise buffered output would be written by every worker
+      std::cout.flush();
+      std::cerr.flush();
+
+      pid_t pid = fork();
+      if (pid < 0) {
+        NS_FATAL_ERROR("Cannot fork replication worker: " << std::strerror(errno));
+      }
+      if (pid == 0) {
+        int status = 0;
+        try {
+          RunReplication(next, setup, finish);
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Replication " << next << " failed: " << e.what() << std::endl;
+          status = 1;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        // skip destruction of objects shared with the parent
+        _exit(status);
+      }
+      NS_LOG_DEBUG("Started replication " << next << " in worker " << pid);
+      workers[pid] = next;
+      next++;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) {
+      NS_FATAL_ERROR("Cannot wait for replication workers: " << std::strerror(errno));
+    }
+    auto worker = workers.find(pid);
+    if (worker == workers.end()) {
+      continue;
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+      NS_LOG_INFO("Replication " << worker->second << " finished");
+      runs.push_back(worker->second);
+    }
+    else {
+      NS_LOG_WARN("Replication " << worker->second << " failed");
+      failed++;
+    }
+    workers.erase(worker);
+  }
+
+  std::sort(runs.begin(), runs.end());
+  for (const auto& file : m_traces) {
+    MergeTrace(file, runs);
+  }
+  return failed;
+}
+
+void
+ReplicationRunner::RunReplication(uint32_t run, const ReplicationCallback& setup,
+                                  const ReplicationCallback& finish)
+{
+  m_run = run;
+  RngSeedManager::SetRun(run);
+  std::seed_seq seed{RngSeedManager::GetSeed(), run};
+  nfd::getGlobalRng().seed(seed);
+
+  if (setup != nullptr) {
+    setup(run);
+  }
+
+  Simulator::Run();
+
+  if (finish != nullptr) {
+    finish(run);
+  }
+
+  // to write trace files, which are not closed when the worker exits
+  L2RateTracer::Destroy();
+  L3RateTracer::Destroy();
+  AppDelayTracer::Destroy();
+  CsTracer::Destroy();
+
+  Simulator::Destroy();
+}
+
+void
+ReplicationRunner::MergeTrace(const std::string& file, const std::vector<uint32_t>& runs) const
+{
+  NS_LOG_FUNCTION(file);
+
+  bool isColumnar = ColumnarTraceWriter::IsColumnarFile(file);
+  shared_ptr<ColumnarTraceWriter> writer;
+  std::ofstream os;
+  std::string header;
+
+  for (uint32_t run : runs) {
+    std::string shard = GetShardFile(file, run);
+
+    if (isColumnar) {
+      ColumnarTraceReader reader;
+      if (!reader.Open(shard)) {
+        NS_LOG_WARN("Replication " << run << " did not write columnar trace " << shard);
+        continue;
+      }
+      if (writer == nullptr) {
+        writer = ColumnarTraceWriter::Open(file);
+        if (writer == nullptr) {
+          NS_FATAL_ERROR("Cannot open " << file << " for writing");
+        }
+        header = reader.GetTextHeader();
+        std::vector<ColumnarTraceWriter::ColumnType> types{ColumnarTraceWriter::INT64};
+        for (const auto& column : reader.GetColumns()) {
+          types.push_back(column.type);
+        }
+        writer->WriteSchema(reader.GetTracer(), "Run\t" + header, types);
+      }
+      NS_ASSERT_MSG(reader.GetTextHeader() == header, shard << " has different columns");
+
+      const auto& columns = reader.GetColumns();
+      while (reader.ReadBlock()) {
+        for (size_t row = 0; row < reader.GetRowCount(); row++) {
+          *writer << run;
+          for (size_t column = 0; column < columns.size(); column++) {
+            switch (columns[column].type) {
+            case ColumnarTraceWriter::FLOAT64:
+              *writer << reader.GetDouble(column, row);
+              break;
+            case ColumnarTraceWriter::INT64:
+              *writer << reader.GetInt(column, row);
+              break;
+            case ColumnarTraceWriter::STRING:
+              *writer << reader.GetString(column, row);
+              break;
+            }
+          }
+          writer->EndRow();
+        }
+      }
+    }
+    else {
+      std::ifstream is(shard.c_str());
+      std::string line;
+      if (!is.is_open() || !std::getline(is, line)) {
+        NS_LOG_WARN("Replication " << run << " did not write trace " << shard);
+        continue;
+      }
+      if (!os.is_open()) {
+        os.open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+        if (!os.is_open()) {
+          NS_FATAL_ERROR("Cannot open " << file << " for writing");
+        }
+        header = line;
+        os << "Run\t" << header << "\n";
+      }
+      NS_ASSERT_MSG(line == header, shard << " has different columns");
+
+      while (std::getline(is, line)) {
+        if (!line.empty()) {
+          os << run << "\t" << line << "\n";
+        }
+      }
+    }
+
+    std::remove(shard.c_str());
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REPLICATION_RUNNER_H
+#define NDN_REPLICATION_RUNNER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to run independent replications of a scenario in forked worker processes
+ *
+ * The scenario (topology, NDN stack, FIBs, shared tables such as Zipf-Mandelbrot CDFs, and
+ * events scheduled so far, e.g., Simulator::Stop) is built once by the calling process.  Every
+ * replication is then simulated by a worker process forked from it, which shares the built
+ * scenario copy-on-write, so that setting up a replication costs almost nothing:
+ *
+ * - RngRun is set to the run number of the replication and NFD random number generator is
+ *   seeded from it;
+ * - the setup callback installs what differs between replications: applications, tracers and
+ *   anything else that creates random variables (ns-3 random variables take the run number
+ *   when they are created, so the ones created before Run() are the same in all replications);
+ * - the simulation runs, the finish callback (if any) is called, and tracers are destroyed to
+ *   write their files.
+ *
+ * Trace files registered with AddTrace() are written by every replication into a shard file
+ * (see GetTraceFile()), and after all replications the shards are merged into the registered
+ * file in the order of runs, with an additional first column "Run".  Text traces are merged
+ * line by line, binary columnar traces (".bin" or ".bin.gz") record by record.
+ *
+ *     ScenarioHelper scenario;
+ *     scenario.createTopology({{"1", "2"}});
+ *     scenario.addRoutes({{"1", "2", "/prefix", 1}});
+ *     Simulator::Stop(Seconds(10));
+ *
+ *     ReplicationRunner runner;
+ *     runner.SetRuns(1, 30);
+ *     runner.AddTrace("app-delays.txt");
+ *     runner.Run([&] (uint32_t run) {
+ *         scenario.addApps({...});
+ *         AppDelayTracer::InstallAll(runner.GetTraceFile("app-delays.txt"));
+ *       });
+ *
+ * Workers are processes and not threads, because the ns-3 Simulator is a process-wide singleton.
+ */
+class ReplicationRunner {
+public:
+  typedef std::function<void(uint32_t run)> ReplicationCallback;
+
+  ReplicationRunner();
+
+  /**
+   * @brief Run replications with RngRun @p firstRun, @p firstRun + 1, ..., (default 1 to 10)
+   */
+  void
+  SetRuns(uint32_t firstRun, uint32_t nRuns);
+
+  /**
+   * @brief Set maximum number of concurrent workers (0, the default, for number of online CPUs)
+   */
+  void
+  SetJobs(uint32_t jobs);
+
+  /**
+   * @brief Merge shards of trace file @p file written by the replications into @p file
+   */
+  void
+  AddTrace(const std::string& file);
+
+  /**
+   * @brief Get name of the shard of trace file @p file that the current replication writes
+   *
+   * For "rate-trace.txt" in run 3, returns "rate-trace.run-3.txt" (the extension is kept, so
+   * that tracers still select the output format by file name).  Returns @p file if called
+   * outside of a replication.
+   */
+  std::string
+  GetTraceFile(const std::string& file) const;
+
+  /**
+   * @brief Run all replications and merge their traces
+   *
+   * @param setup  Called in the worker before the simulation starts
+   * @param finish Called in the worker after the simulation ends, before tracers are destroyed
+   *
+   * @returns number of failed replications (worker did not exit normally), whose traces are not
+   *          merged
+   */
+  uint32_t
+  Run(const ReplicationCallback& setup, const ReplicationCallback& finish = nullptr);
+
+  /**
+   * @brief Get run number of the replication in the current process, 0 outside of replications
+   */
+  uint32_t
+  GetRun() const;
+
+private:
+  /**
+   * @brief Set up, simulate and clean up the replication in the worker process
+   */
+  void
+  RunReplication(uint32_t run, const ReplicationCallback& setup,
+                 const ReplicationCallback& finish);
+
+  void
+  MergeTrace(const std::string& file, const std::vector<uint32_t>& runs) const;
+
+  static std::string
+  GetShardFile(const std::string& file, uint32_t run);
+
+private:
+  uint32_t m_firstRun;
+  uint32_t m_nRuns;
+  uint32_t m_jobs;
+  std::vector<std::string> m_traces;
+
+  uint32_t m_run;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REPLICATION_RUNNER_H
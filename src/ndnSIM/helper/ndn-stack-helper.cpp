@@ -50,6 +50,7 @@ StackHelper::StackHelper()
   // , m_isFaceManagerDisabled(false)
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isLightweight(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
 {
@@ -197,6 +198,10 @@ StackHelper::Install(Ptr<Node> node) const
     ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
   }
 
+  if (m_isLightweight) {
+    ndn->getConfig().put("ndnSIM.lightweight", true);
+  }
+
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
 
   // Create and aggregate content store if NFD's contest store has been disabled
@@ -429,6 +434,12 @@ StackHelper::disableForwarderStatusManager()
   m_isForwarderStatusManagerDisabled = true;
 }
 
+void
+StackHelper::setLightweight(bool isLightweight)
+{
+  m_isLightweight = isLightweight;
+}
+
 void
 StackHelper::SetLinkDelayAsFaceMetric()
 {
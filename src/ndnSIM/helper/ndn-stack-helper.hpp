@@ -248,6 +248,21 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install lightweight NDN stacks, omitting NFD's management plane and RIB manager
+   *
+   * Lightweight nodes create only the forwarder and its tables.  FibHelper and
+   * StrategyChoiceHelper update the tables directly instead of sending signed management
+   * commands.  The internal face, dispatcher and managers are created on first call of
+   * L3Protocol::injectInterest, getFibManager or getStrategyChoiceManager; the RIB manager
+   * is never created.
+   *
+   * Use for large topologies (10K+ nodes) that do not rely on NFD management or prefix
+   * registration through the RIB.
+   */
+  void
+  setLightweight(bool isLightweight = true);
+
   /**
    * @brief Set face metric of all faces connected through PointToPoint channel to channel latency
    */
@@ -268,6 +283,7 @@ private:
   // bool m_isFaceManagerDisabled;
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isLightweight;
 
 public:
   void
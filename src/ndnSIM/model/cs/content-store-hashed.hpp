@@ -0,0 +1,665 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_HASHED_H_
+#define NDN_CONTENT_STORE_HASHED_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-content-store.hpp"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+
+#include <memory>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Cache entry of ContentStoreHashed
+ *
+ * The entry is also the node of the policy container (same as trie nodes in ContentStoreImpl),
+ * and is linked into one list per proper prefix of its name for prefix lookups.
+ */
+template<class PolicyHook>
+class HashedEntry : public Entry {
+public:
+  typedef HashedEntry* iterator;
+  typedef const HashedEntry* const_iterator;
+
+  /**
+   * @brief Membership in the list of entries under a prefix of the entry name
+   */
+  struct PrefixLink {
+    uint64_t hash; ///< @brief hash of the prefix
+    HashedEntry* prev;
+    HashedEntry* next;
+  };
+
+  HashedEntry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
+    : Entry(cs, data)
+    , hash_(0)
+    , links_(new PrefixLink[data->getName().size()])
+  {
+  }
+
+  /**
+   * @brief Get the entry itself, for policies that access entries of trie nodes via payload()
+   */
+  HashedEntry*
+  payload()
+  {
+    return this;
+  }
+
+  const HashedEntry*
+  payload() const
+  {
+    return this;
+  }
+
+public:
+  PolicyHook policy_hook_;
+  uint64_t hash_; ///< @brief hash of the full name
+  std::unique_ptr<PrefixLink[]> links_; ///< @brief one link per proper prefix, by prefix length
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Open-addressing hash table of entry pointers with 64-bit hash keys
+ *
+ * Linear probing; several slots may have the same hash, callers resolve collisions by comparing
+ * names.  Removal shifts following slots back instead of leaving tombstones, so that lookups stop
+ * at the first empty slot.
+ */
+template<class Node>
+class HashedCsTable {
+public:
+  struct Slot {
+    uint64_t hash;
+    Node* node; ///< @brief nullptr for empty slots
+  };
+
+  HashedCsTable()
+    : m_slots(MIN_CAPACITY, Slot{0, nullptr})
+    , m_size(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_slots.size();
+  }
+
+  /**
+   * @brief Position where probing for the hash starts
+   */
+  size_t
+  first(uint64_t hash) const
+  {
+    return hash & (m_slots.size() - 1);
+  }
+
+  size_t
+  next(size_t position) const
+  {
+    return (position + 1) & (m_slots.size() - 1);
+  }
+
+  const Slot&
+  operator[](size_t position) const
+  {
+    return m_slots[position];
+  }
+
+  Slot&
+  operator[](size_t position)
+  {
+    return m_slots[position];
+  }
+
+  /**
+   * @brief Find position of the node stored with the hash, which must be in the table
+   *
+   * The same node may be stored with several hashes (e.g., as head of lists of several
+   * prefixes), so both have to match.
+   */
+  size_t
+  find(uint64_t hash, const Node* node) const
+  {
+    size_t position = first(hash);
+    while (m_slots[position].node != node || m_slots[position].hash != hash) {
+      position = next(position);
+    }
+    return position;
+  }
+
+  void
+  insert(uint64_t hash, Node* node)
+  {
+    // keep load factor below 2/3, linear probing degrades quickly above that
+    if ((m_size + 1) * 3 > m_slots.size() * 2) {
+      rehash(m_slots.size() * 2);
+    }
+
+    size_t position = first(hash);
+    while (m_slots[position].node != nullptr) {
+      position = next(position);
+    }
+    m_slots[position] = Slot{hash, node};
+    m_size++;
+  }
+
+  void
+  erase(size_t position)
+  {
+    size_t mask = m_slots.size() - 1;
+    size_t hole = position;
+    for (size_t i = next(position); m_slots[i].node != nullptr; i = next(i)) {
+      // move the slot into the hole unless its probe sequence starts after the hole
+      size_t home = first(m_slots[i].hash);
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        m_slots[hole] = m_slots[i];
+        hole = i;
+      }
+    }
+    m_slots[hole] = Slot{0, nullptr};
+    m_size--;
+  }
+
+  void
+  clear()
+  {
+    m_slots.assign(MIN_CAPACITY, Slot{0, nullptr});
+    m_size = 0;
+  }
+
+private:
+  void
+  rehash(size_t capacity)
+  {
+    std::vector<Slot> slots(capacity, Slot{0, nullptr});
+    slots.swap(m_slots);
+    for (const Slot& slot : slots) {
+      if (slot.node != nullptr) {
+        size_t position = first(slot.hash);
+        while (m_slots[position].node != nullptr) {
+          position = next(position);
+        }
+        m_slots[position] = slot;
+      }
+    }
+  }
+
+private:
+  static const size_t MIN_CAPACITY = 16;
+
+  std::vector<Slot> m_slots;
+  size_t m_size;
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Hash of a name prefix, extended by one component
+ *
+ * Hash of a name is computed component by component starting from NAME_HASH_SEED, so hashes of
+ * all prefixes of a name are the intermediate values.
+ */
+inline uint64_t
+hashNameComponent(uint64_t hash, const name::Component& component)
+{
+  static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+  hash = (hash ^ component.type()) * FNV_PRIME;
+  const uint8_t* value = component.value();
+  for (size_t i = 0; i < component.value_size(); i++) {
+    hash = (hash ^ value[i]) * FNV_PRIME;
+  }
+  // component boundary, so that /ab/c and /a/bc differ
+  return (hash ^ component.value_size()) * FNV_PRIME;
+}
+
+static const uint64_t NAME_HASH_SEED = 14695981039346656037ULL;
+
+/**
+ * @ingroup ndn-cs
+ * @brief NDN content store with full-name hash index
+ *
+ * Alternative to ContentStoreImpl for large caches: instead of a trie with one node (and hash
+ * table of children) per name component, entries are indexed by the hash of their full name in
+ * an open-addressing table, so exact-match lookups and insertions hash the name once and touch
+ * one or two cache lines.  Interests that can be satisfied by Data with a longer name (CanBePrefix
+ * or Exclude) are served from a second table that maps hashes of name prefixes to lists of
+ * entries under them.
+ *
+ * Uses the same replacement policies as ContentStoreImpl (LRU, LFU, FIFO, Random), registered as
+ * ns3::ndn::cs::Hashed::Lru, ns3::ndn::cs::Hashed::Lfu, etc.  Lookup semantics are the same as of
+ * ContentStoreImpl, except that Interests without CanBePrefix only match Data with the same name.
+ */
+template<class Policy>
+class ContentStoreHashed : public ContentStore {
+public:
+  typedef HashedEntry<typename Policy::policy_hook_type> entry;
+
+  typedef typename Policy::
+    template policy<ContentStoreHashed<Policy>, entry,
+                    typename Policy::template container_hook<entry>::type>::type policy_container;
+
+  static TypeId
+  GetTypeId();
+
+  ContentStoreHashed();
+
+  virtual ~ContentStoreHashed();
+
+  // from ContentStore
+
+  virtual shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual bool
+  Add(shared_ptr<const Data> data);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  virtual uint32_t
+  GetSize() const;
+
+  virtual Ptr<Entry>
+  Begin();
+
+  virtual Ptr<Entry>
+  End();
+
+  virtual Ptr<Entry> Next(Ptr<Entry>);
+
+  const policy_container&
+  GetPolicy() const
+  {
+    return m_policy;
+  }
+
+  policy_container&
+  GetPolicy()
+  {
+    return m_policy;
+  }
+
+  /**
+   * @brief Remove entry from the store (called by the replacement policy to evict entries)
+   */
+  void
+  erase(entry* item);
+
+public:
+  typedef void (*CsEntryCallback)(Ptr<const Entry>);
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  entry*
+  FindExact(const Name& name, uint64_t hash) const;
+
+  entry*
+  FindUnderPrefix(const Name& prefix, uint64_t hash, const Exclude& exclude) const;
+
+  /**
+   * @brief Find slot of the list of entries under prefix with the hash and number of components
+   * @returns position of the slot, or of an empty slot if there is no such list
+   */
+  size_t
+  FindPrefixList(uint64_t hash, size_t depth) const;
+
+  void
+  Unlink(entry* item);
+
+  void
+  Clear();
+
+  void
+  SetMaxSize(uint32_t maxSize);
+
+  uint32_t
+  GetMaxSize() const;
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  HashedCsTable<entry> m_names;    ///< @brief all entries, by hash of the full name
+  HashedCsTable<entry> m_prefixes; ///< @brief heads of entry lists, by hash of the prefix
+  mutable policy_container m_policy;
+
+  /// @brief trace of for entry additions (fired every time entry is successfully added to the
+  /// cache): first parameter is pointer to the CS entry
+  TracedCallback<Ptr<const Entry>> m_didAddEntry;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreHashed<Policy>::g_log = LogComponent(("ndn.cs.Hashed."
+                                                               + Policy::GetName()).c_str(),
+                                                              __FILE__);
+
+template<class Policy>
+TypeId
+ContentStoreHashed<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Hashed::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<ContentStore>()
+      .AddConstructor<ContentStoreHashed<Policy>>()
+      .AddAttribute("MaxSize",
+                    "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                    StringValue("100"),
+                    MakeUintegerAccessor(&ContentStoreHashed<Policy>::GetMaxSize,
+                                         &ContentStoreHashed<Policy>::SetMaxSize),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("DidAddEntry",
+                      "Trace fired every time entry is successfully added to the cache",
+                      MakeTraceSourceAccessor(&ContentStoreHashed<Policy>::m_didAddEntry),
+                      "ns3::ndn::cs::ContentStoreHashed::CsEntryCallback");
+
+  return tid;
+}
+
+template<class Policy>
+ContentStoreHashed<Policy>::ContentStoreHashed()
+  : m_policy(*this)
+{
+}
+
+template<class Policy>
+ContentStoreHashed<Policy>::~ContentStoreHashed()
+{
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::DoDispose()
+{
+  // entries reference the store
+  Clear();
+  ContentStore::DoDispose();
+}
+
+template<class Policy>
+typename ContentStoreHashed<Policy>::entry*
+ContentStoreHashed<Policy>::FindExact(const Name& name, uint64_t hash) const
+{
+  for (size_t i = m_names.first(hash); m_names[i].node != nullptr; i = m_names.next(i)) {
+    if (m_names[i].hash == hash && m_names[i].node->GetName() == name) {
+      return m_names[i].node;
+    }
+  }
+  return nullptr;
+}
+
+template<class Policy>
+typename ContentStoreHashed<Policy>::entry*
+ContentStoreHashed<Policy>::FindUnderPrefix(const Name& prefix, uint64_t hash,
+                                            const Exclude& exclude) const
+{
+  size_t depth = prefix.size();
+  // different prefixes with the same hash share the list
+  for (entry* item = m_prefixes[FindPrefixList(hash, depth)].node; item != nullptr;
+       item = item->links_[depth].next) {
+    const Name& name = item->GetName();
+    if (prefix.isPrefixOf(name) && (exclude.empty() || !exclude.isExcluded(name.get(depth)))) {
+      return item;
+    }
+  }
+  return nullptr;
+}
+
+template<class Policy>
+size_t
+ContentStoreHashed<Policy>::FindPrefixList(uint64_t hash, size_t depth) const
+{
+  size_t i = m_prefixes.first(hash);
+  for (; m_prefixes[i].node != nullptr; i = m_prefixes.next(i)) {
+    const entry* head = m_prefixes[i].node;
+    if (m_prefixes[i].hash == hash && head->GetName().size() > depth
+        && head->links_[depth].hash == hash && head->links_[depth].prev == nullptr) {
+      break;
+    }
+  }
+  return i;
+}
+
+template<class Policy>
+shared_ptr<Data>
+ContentStoreHashed<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  const Name& name = interest->getName();
+  uint64_t hash = NAME_HASH_SEED;
+  for (const name::Component& component : name) {
+    hash = hashNameComponent(hash, component);
+  }
+
+  entry* item = nullptr;
+  // same as the trie-based store: with Exclude, only Data with longer names can match
+  if (interest->getExclude().empty()) {
+    item = FindExact(name, hash);
+  }
+  if (item == nullptr && (interest->getCanBePrefix() || !interest->getExclude().empty())) {
+    item = FindUnderPrefix(name, hash, interest->getExclude());
+  }
+
+  if (item != nullptr) {
+    m_policy.lookup(item);
+    this->m_cacheHitsTrace(interest, item->GetData());
+
+    shared_ptr<Data> copy = make_shared<Data>(*item->GetData());
+    return copy;
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+    return 0;
+  }
+}
+
+template<class Policy>
+bool
+ContentStoreHashed<Policy>::Add(shared_ptr<const Data> data)
+{
+  NS_LOG_FUNCTION(this << data->getName());
+
+  const Name& name = data->getName();
+  Ptr<entry> newEntry = Create<entry>(this, data);
+
+  uint64_t hash = NAME_HASH_SEED;
+  for (size_t i = 0; i < name.size(); i++) {
+    newEntry->links_[i] = {hash, nullptr, nullptr};
+    hash = hashNameComponent(hash, name.get(i));
+  }
+  newEntry->hash_ = hash;
+
+  if (FindExact(name, hash) != nullptr) {
+    return false;
+  }
+
+  // the policy may evict entries, but must not see this one in the tables before it is inserted
+  if (!m_policy.insert(GetPointer(newEntry))) {
+    return false; // cannot insert entry
+  }
+
+  newEntry->Ref(); // owned by the tables until erased
+  m_names.insert(hash, GetPointer(newEntry));
+  for (size_t depth = 0; depth < name.size(); depth++) {
+    typename entry::PrefixLink& link = newEntry->links_[depth];
+    size_t i = FindPrefixList(link.hash, depth);
+    if (m_prefixes[i].node == nullptr) {
+      m_prefixes.insert(link.hash, GetPointer(newEntry));
+    }
+    else {
+      entry* head = m_prefixes[i].node;
+      link.next = head;
+      head->links_[depth].prev = GetPointer(newEntry);
+      m_prefixes[i].node = GetPointer(newEntry);
+    }
+  }
+
+  m_didAddEntry(newEntry);
+  return true;
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::erase(entry* item)
+{
+  m_policy.erase(item);
+  Unlink(item);
+  item->Unref();
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::Unlink(entry* item)
+{
+  m_names.erase(m_names.find(item->hash_, item));
+
+  size_t nComponents = item->GetName().size();
+  for (size_t depth = 0; depth < nComponents; depth++) {
+    typename entry::PrefixLink& link = item->links_[depth];
+    if (link.next != nullptr) {
+      link.next->links_[depth].prev = link.prev;
+    }
+
+    if (link.prev != nullptr) {
+      link.prev->links_[depth].next = link.next;
+    }
+    else {
+      size_t i = m_prefixes.find(link.hash, item);
+      if (link.next != nullptr) {
+        m_prefixes[i].node = link.next;
+      }
+      else {
+        m_prefixes.erase(i);
+      }
+    }
+  }
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::Clear()
+{
+  m_policy.clear();
+  for (size_t i = 0; i < m_names.capacity(); i++) {
+    if (m_names[i].node != nullptr) {
+      m_names[i].node->Unref();
+    }
+  }
+  m_names.clear();
+  m_prefixes.clear();
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::Print(std::ostream& os) const
+{
+  for (typename policy_container::const_iterator item = m_policy.begin(); item != m_policy.end();
+       item++) {
+    os << item->GetName() << std::endl;
+  }
+}
+
+template<class Policy>
+void
+ContentStoreHashed<Policy>::SetMaxSize(uint32_t maxSize)
+{
+  m_policy.set_max_size(maxSize);
+}
+
+template<class Policy>
+uint32_t
+ContentStoreHashed<Policy>::GetMaxSize() const
+{
+  return m_policy.get_max_size();
+}
+
+template<class Policy>
+uint32_t
+ContentStoreHashed<Policy>::GetSize() const
+{
+  return m_policy.size();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreHashed<Policy>::Begin()
+{
+  for (size_t i = 0; i < m_names.capacity(); i++) {
+    if (m_names[i].node != nullptr) {
+      return m_names[i].node;
+    }
+  }
+  return End();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreHashed<Policy>::End()
+{
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreHashed<Policy>::Next(Ptr<Entry> from)
+{
+  if (from == 0)
+    return 0;
+
+  entry* item = static_cast<entry*>(GetPointer(from));
+  for (size_t i = m_names.find(item->hash_, item) + 1; i < m_names.capacity(); i++) {
+    if (m_names[i].node != nullptr) {
+      return m_names[i].node;
+    }
+  }
+  return End();
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_HASHED_H_
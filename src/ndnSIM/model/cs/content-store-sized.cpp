@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "content-store-sized.hpp"
+
+#include "custom-policies/gdsf-policy.hpp"
+#include "custom-policies/arc-policy.hpp"
+#include "custom-policies/tinylfu-policy.hpp"
+#include "custom-policies/s3fifo-policy.hpp"
+
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
+  static struct X##type##templ##RegistrationClass {                                                \
+    X##type##templ##RegistrationClass()                                                            \
+    {                                                                                              \
+      ns3::TypeId tid = type<templ>::GetTypeId();                                                  \
+      tid.GetParent();                                                                             \
+    }                                                                                              \
+  } x_##type##templ##RegistrationVariable
+
+namespace ns3 {
+namespace ndn {
+
+using namespace ndnSIM;
+
+namespace cs {
+
+// explicit instantiation and registering
+/**
+ * @brief ContentStore with Greedy-Dual-Size-Frequency cache replacement policy
+ **/
+template class ContentStoreImpl<gdsf_policy_traits>;
+template class ContentStoreSized<gdsf_policy_traits>;
+
+/**
+ * @brief ContentStore with Adaptive Replacement Cache policy
+ **/
+template class ContentStoreImpl<arc_policy_traits>;
+template class ContentStoreSized<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with LRU cache replacement policy and TinyLFU admission
+ **/
+template class ContentStoreImpl<tinylfu_policy_traits>;
+template class ContentStoreSized<tinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore with S3-FIFO cache replacement policy
+ **/
+template class ContentStoreImpl<s3fifo_policy_traits>;
+template class ContentStoreSized<s3fifo_policy_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, gdsf_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, s3fifo_policy_traits);
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSized, gdsf_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSized, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSized, tinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreSized, s3fifo_policy_traits);
+
+#ifdef DOXYGEN
+/**
+ * \brief Content Store implementing Greedy-Dual-Size-Frequency cache replacement policy
+ */
+class Sized::Gdsf : public ContentStoreSized<gdsf_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing Adaptive Replacement Cache policy
+ */
+class Sized::Arc : public ContentStoreSized<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy with TinyLFU admission
+ */
+class Sized::TinyLfu : public ContentStoreSized<tinylfu_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing S3-FIFO cache replacement policy
+ */
+class Sized::S3Fifo : public ContentStoreSized<s3fifo_policy_traits> {
+};
+#endif
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
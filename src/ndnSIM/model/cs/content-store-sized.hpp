@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_SIZED_H_
+#define NDN_CONTENT_STORE_SIZED_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store that limits the total size of cached Data in bytes
+ *
+ * Requires one of the size-aware policies (custom-policies/size-aware-policy.hpp): GDSF, ARC,
+ * TinyLFU, or S3-FIFO.  Size of an entry is the size of wire encoding of its Data.  The cache
+ * is full when either MaxSize entries or MaxBytes bytes are cached; both limits are disabled
+ * when set to 0.  Data larger than MaxBytes is never cached.
+ */
+template<class Policy>
+class ContentStoreSized : public ContentStoreImpl<Policy> {
+public:
+  typedef ContentStoreImpl<Policy> super;
+
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get total size of cached Data in bytes
+   */
+  inline uint64_t
+  GetBytes() const;
+
+private:
+  inline void
+  SetMaxBytes(uint64_t maxBytes);
+
+  inline uint64_t
+  GetMaxBytes() const;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+TypeId
+ContentStoreSized<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Sized::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<super>()
+      .template AddConstructor<ContentStoreSized<Policy>>()
+      .AddAttribute("MaxBytes",
+                    "Set maximum total size of Data in ContentStore (bytes). If 0, limit is not "
+                    "enforced",
+                    StringValue("0"), MakeUintegerAccessor(&ContentStoreSized<Policy>::GetMaxBytes,
+                                                           &ContentStoreSized<Policy>::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>());
+
+  return tid;
+}
+
+template<class Policy>
+inline uint64_t
+ContentStoreSized<Policy>::GetBytes() const
+{
+  return this->getPolicy().get_bytes();
+}
+
+template<class Policy>
+inline void
+ContentStoreSized<Policy>::SetMaxBytes(uint64_t maxBytes)
+{
+  this->getPolicy().set_max_bytes(maxBytes);
+}
+
+template<class Policy>
+inline uint64_t
+ContentStoreSized<Policy>::GetMaxBytes() const
+{
+  return this->getPolicy().get_max_bytes();
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_SIZED_H_
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+/// @cond include_hidden
+
+#include "size-aware-policy.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache policy
+ *
+ * Entries requested once are kept in LRU list T1, entries requested more than once in LRU list
+ * T2.  Names of entries evicted from T1 and T2 are remembered in ghost lists B1 and B2.  A miss
+ * on a name in B1 (B2) means T1 (T2) was too small and moves the target size p of T1 up (down).
+ * Sizes are measured in bytes if the byte limit is set, otherwise in entries.
+ *
+ * T1 and T2 are stored in one intrusive list: T1 is [begin, mid) and T2 is [mid, end).
+ */
+struct arc_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Arc";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint64_t key;
+    size_t size;
+    bool isFrequent;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    class type : public policy_container, public capacity_accounting {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , frequent_(policy_container::end())
+        , recentUnits_(0)
+        , frequentUnits_(0)
+        , target_(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = get_data_size(item);
+        if (!fits(1, size)) {
+          return false; // would not fit into empty cache
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        hook.key = get_name_key(item);
+        hook.size = size;
+
+        double capacity = capacity_units();
+        double delta = units(size);
+        bool inRecentGhost = recentGhost_.contains(hook.key);
+        bool inFrequentGhost = frequentGhost_.contains(hook.key);
+        if (inRecentGhost) {
+          double ratio = frequentGhost_.units() / std::max<double>(recentGhost_.units(), 1);
+          target_ = std::min(capacity, target_ + delta * std::max(1.0, ratio));
+          recentGhost_.remove(hook.key);
+        }
+        else if (inFrequentGhost) {
+          double ratio = recentGhost_.units() / std::max<double>(frequentGhost_.units(), 1);
+          target_ = std::max(0.0, target_ - delta * std::max(1.0, ratio));
+          frequentGhost_.remove(hook.key);
+        }
+
+        while (!policy_container::empty() && !fits(policy_container::size() + 1, bytes_ + size)) {
+          replace(inFrequentGhost);
+        }
+
+        if (inRecentGhost || inFrequentGhost) {
+          hook.isFrequent = true;
+          policy_container::push_back(*item);
+          if (frequent_ == policy_container::end()) {
+            frequent_ = policy_container::s_iterator_to(*item);
+          }
+          frequentUnits_ += units(size);
+        }
+        else {
+          hook.isFrequent = false;
+          policy_container::insert(frequent_, *item);
+          recentUnits_ += units(size);
+        }
+        bytes_ += size;
+
+        // keep |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+        while (!recentGhost_.empty() && recentUnits_ + recentGhost_.units() > capacity) {
+          recentGhost_.pop();
+        }
+        while (!frequentGhost_.empty()
+               && recentUnits_ + frequentUnits_ + recentGhost_.units() + frequentGhost_.units()
+                    > 2 * capacity) {
+          frequentGhost_.pop();
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        policy_hook_type& hook = get_hook(item);
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+
+        if (!hook.isFrequent) {
+          hook.isFrequent = true;
+          recentUnits_ -= units(hook.size);
+          frequentUnits_ += units(hook.size);
+        }
+        else if (position == frequent_) {
+          ++frequent_;
+        }
+
+        // move to MRU position of T2
+        policy_container::splice(policy_container::end(), *this, position);
+        if (frequent_ == policy_container::end()) {
+          frequent_ = position;
+        }
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position == frequent_) {
+          ++frequent_;
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        (hook.isFrequent ? frequentUnits_ : recentUnits_) -= units(hook.size);
+        bytes_ -= hook.size;
+        policy_container::erase(position);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        frequent_ = policy_container::end();
+        recentUnits_ = 0;
+        frequentUnits_ = 0;
+        bytes_ = 0;
+        target_ = 0;
+        recentGhost_.clear();
+        frequentGhost_.clear();
+      }
+
+    private:
+      /**
+       * @brief Evict LRU entry of T1 if T1 exceeds its target size, otherwise LRU entry of T2
+       */
+      inline void
+      replace(bool inFrequentGhost)
+      {
+        bool hasRecent = policy_container::begin() != frequent_;
+        bool hasFrequent = frequent_ != policy_container::end();
+
+        if (hasRecent
+            && (!hasFrequent || recentUnits_ > target_
+                || (inFrequentGhost && recentUnits_ >= target_))) {
+          typename policy_container::iterator victim = policy_container::begin();
+          recentGhost_.push(get_hook(&*victim).key, units(get_hook(&*victim).size));
+          base_.erase(&(*victim));
+        }
+        else {
+          typename policy_container::iterator victim = frequent_;
+          frequentGhost_.push(get_hook(&*victim).key, units(get_hook(&*victim).size));
+          base_.erase(&(*victim));
+        }
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      typename policy_container::iterator frequent_; ///< @brief LRU entry of T2
+      size_t recentUnits_;
+      size_t frequentUnits_;
+      double target_; ///< @brief target size of T1 (p)
+      ghost_list recentGhost_;
+      ghost_list frequentGhost_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ARC_POLICY_H_
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef GDSF_POLICY_H_
+#define GDSF_POLICY_H_
+
+/// @cond include_hidden
+
+#include "size-aware-policy.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/set.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Greedy-Dual-Size-Frequency replacement policy
+ *
+ * Every entry has priority H = L + frequency * cost / size, where cost is 1 for all entries (the
+ * policy maximizes object hit ratio) and L is the priority of the last evicted entry.  Entries
+ * with the lowest priority are evicted first, so small and popular Data stays in the cache,
+ * while L ages out entries that were popular long ago.
+ */
+struct gdsf_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Gdsf";
+  }
+
+  struct policy_hook_type : public boost::intrusive::set_member_hook<> {
+    double priority;
+    uint32_t frequency;
+    size_t size;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static const policy_hook_type&
+    get_hook(typename Container::const_iterator item)
+    {
+      return *static_cast<const typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    template<class Key>
+    struct MemberHookLess {
+      bool
+      operator()(const Key& a, const Key& b) const
+      {
+        return get_hook(&a).priority < get_hook(&b).priority;
+      }
+    };
+
+    typedef boost::intrusive::multiset<Container,
+                                       boost::intrusive::compare<MemberHookLess<Container>>,
+                                       Hook> policy_container;
+
+    class type : public policy_container, public capacity_accounting {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , inflation_(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = get_data_size(item);
+        if (!fits(1, size)) {
+          return false; // would not fit into empty cache
+        }
+
+        while (!policy_container::empty() && !fits(policy_container::size() + 1, bytes_ + size)) {
+          inflation_ = get_hook(&*policy_container::begin()).priority;
+          base_.erase(&(*policy_container::begin()));
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        hook.size = size;
+        hook.frequency = 1;
+        hook.priority = get_priority(hook);
+
+        policy_container::insert(*item);
+        bytes_ += size;
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        policy_container::erase(policy_container::s_iterator_to(*item));
+
+        policy_hook_type& hook = get_hook(item);
+        hook.frequency++;
+        hook.priority = get_priority(hook);
+
+        policy_container::insert(*item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_ -= get_hook(item).size;
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        bytes_ = 0;
+        inflation_ = 0;
+      }
+
+    private:
+      inline double
+      get_priority(const policy_hook_type& hook) const
+      {
+        return inflation_ + static_cast<double>(hook.frequency) / std::max<size_t>(hook.size, 1);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      double inflation_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // GDSF_POLICY_H_
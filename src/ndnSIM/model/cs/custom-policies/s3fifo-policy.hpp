@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef S3FIFO_POLICY_H_
+#define S3FIFO_POLICY_H_
+
+/// @cond include_hidden
+
+#include "size-aware-policy.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for S3-FIFO replacement policy
+ *
+ * Entries are kept in two FIFO queues: small (S, 10% of the capacity) and main (M).  New Data
+ * enters S, unless its name is remembered in the ghost queue G of names recently evicted from S,
+ * in which case it enters M.  Entries leaving S move to M if they were requested more than
+ * once, otherwise they are evicted (and remembered in G).  Entries leaving M are reinserted
+ * into M while they have been requested since the last reinsertion.  One-time requests are
+ * thus evicted quickly, without ever touching the main queue.
+ *
+ * Both queues are stored in one intrusive list: S is [begin, mid) and M is [mid, end).
+ */
+struct s3fifo_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "S3Fifo";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint64_t key;
+    size_t size;
+    uint8_t frequency;
+    bool isMain;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    class type : public policy_container, public capacity_accounting {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , main_(policy_container::end())
+        , smallUnits_(0)
+        , mainUnits_(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = get_data_size(item);
+        if (!fits(1, size)) {
+          return false; // would not fit into empty cache
+        }
+
+        while (!policy_container::empty() && !fits(policy_container::size() + 1, bytes_ + size)) {
+          evict();
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        hook.key = get_name_key(item);
+        hook.size = size;
+        hook.frequency = 0;
+
+        if (ghost_.contains(hook.key)) {
+          ghost_.remove(hook.key);
+          hook.isMain = true;
+          policy_container::push_back(*item);
+          if (main_ == policy_container::end()) {
+            main_ = policy_container::s_iterator_to(*item);
+          }
+          mainUnits_ += units(size);
+        }
+        else {
+          hook.isMain = false;
+          policy_container::insert(main_, *item);
+          smallUnits_ += units(size);
+        }
+
+        bytes_ += size;
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        policy_hook_type& hook = get_hook(item);
+        if (hook.frequency < 3)
+          hook.frequency++;
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position == main_) {
+          ++main_;
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        (hook.isMain ? mainUnits_ : smallUnits_) -= units(hook.size);
+        bytes_ -= hook.size;
+        policy_container::erase(position);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        main_ = policy_container::end();
+        smallUnits_ = 0;
+        mainUnits_ = 0;
+        bytes_ = 0;
+        ghost_.clear();
+      }
+
+    private:
+      inline void
+      evict()
+      {
+        if (policy_container::begin() != main_
+            && (main_ == policy_container::end() || smallUnits_ * 10 >= capacity_units())) {
+          evictSmall();
+        }
+        else {
+          evictMain();
+        }
+      }
+
+      inline void
+      evictSmall()
+      {
+        while (policy_container::begin() != main_) {
+          typename policy_container::iterator item = policy_container::begin();
+          policy_hook_type& hook = get_hook(&*item);
+          if (hook.frequency > 1) {
+            // promote to the tail of main queue
+            policy_container::splice(policy_container::end(), *this, item);
+            if (main_ == policy_container::end()) {
+              main_ = item;
+            }
+            hook.isMain = true;
+            hook.frequency = 0;
+            smallUnits_ -= units(hook.size);
+            mainUnits_ += units(hook.size);
+
+            if (mainUnits_ * 10 > capacity_units() * 9) {
+              evictMain();
+              return;
+            }
+          }
+          else {
+            ghost_.push(hook.key, units(hook.size));
+            while (ghost_.units() * 10 > capacity_units() * 9) {
+              ghost_.pop();
+            }
+
+            base_.erase(&(*item));
+            return;
+          }
+        }
+
+        evictMain();
+      }
+
+      inline void
+      evictMain()
+      {
+        while (main_ != policy_container::end()) {
+          typename policy_container::iterator item = main_;
+          policy_hook_type& hook = get_hook(&*item);
+          if (hook.frequency > 0) {
+            // reinsert at the tail of main queue
+            hook.frequency--;
+            if (std::next(item) != policy_container::end()) {
+              ++main_;
+              policy_container::splice(policy_container::end(), *this, item);
+            }
+          }
+          else {
+            base_.erase(&(*item));
+            return;
+          }
+        }
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      typename policy_container::iterator main_; ///< @brief first entry of main queue
+      size_t smallUnits_;
+      size_t mainUnits_;
+      ghost_list ghost_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // S3FIFO_POLICY_H_
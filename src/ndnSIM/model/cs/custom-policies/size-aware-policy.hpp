@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef SIZE_AWARE_POLICY_H_
+#define SIZE_AWARE_POLICY_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Entry and byte limits of size-aware replacement policies
+ *
+ * The cache is full when it holds max_size entries or max_bytes bytes of Data (0 disables the
+ * limit).  Policies that adapt their queues to the cache capacity measure it in bytes if
+ * max_bytes is set, otherwise in entries.
+ */
+class capacity_accounting {
+public:
+  capacity_accounting()
+    : max_size_(100)
+    , max_bytes_(0)
+    , bytes_(0)
+  {
+  }
+
+  inline void
+  set_max_size(size_t max_size)
+  {
+    max_size_ = max_size;
+  }
+
+  inline size_t
+  get_max_size() const
+  {
+    return max_size_;
+  }
+
+  inline void
+  set_max_bytes(size_t max_bytes)
+  {
+    max_bytes_ = max_bytes;
+  }
+
+  inline size_t
+  get_max_bytes() const
+  {
+    return max_bytes_;
+  }
+
+  /**
+   * @brief Get number of bytes of Data in the cache
+   */
+  inline size_t
+  get_bytes() const
+  {
+    return bytes_;
+  }
+
+  /**
+   * @brief Size of Data of the entry: wire encoding if available, otherwise content size
+   *
+   * A zero-filled payload (see VirtualPayload) counts in full, like in a real cache.
+   */
+  template<class Item>
+  static size_t
+  get_data_size(Item item)
+  {
+    const Data& data = *item->payload()->GetData();
+    return data.hasWire() ? data.wireEncode().size() : data.getContent().value_size();
+  }
+
+  /**
+   * @brief Hash of the entry name, to remember entries after they are evicted
+   */
+  template<class Item>
+  static uint64_t
+  get_name_key(Item item)
+  {
+    return std::hash<Name>()(item->payload()->GetData()->getName());
+  }
+
+protected:
+  /**
+   * @brief Check whether the given number of entries and bytes is within limits
+   */
+  inline bool
+  fits(size_t size, size_t bytes) const
+  {
+    return (max_size_ == 0 || size <= max_size_) && (max_bytes_ == 0 || bytes <= max_bytes_);
+  }
+
+  /**
+   * @brief Capacity in bytes if max_bytes is set, otherwise in entries (0 if unlimited)
+   */
+  inline size_t
+  capacity_units() const
+  {
+    return max_bytes_ != 0 ? max_bytes_ : max_size_;
+  }
+
+  /**
+   * @brief Size of an entry of @p bytes in the units of capacity_units()
+   */
+  inline size_t
+  units(size_t bytes) const
+  {
+    return max_bytes_ != 0 ? bytes : 1;
+  }
+
+protected:
+  size_t max_size_;
+  size_t max_bytes_;
+  size_t bytes_;
+};
+
+/**
+ * @brief FIFO of keys (name hashes) of recently evicted entries, with their size in units
+ */
+class ghost_list {
+public:
+  ghost_list()
+    : units_(0)
+  {
+  }
+
+  inline bool
+  contains(uint64_t key) const
+  {
+    return index_.count(key) > 0;
+  }
+
+  inline void
+  push(uint64_t key, size_t units)
+  {
+    remove(key);
+    keys_.push_back(std::make_pair(key, units));
+    index_[key] = std::prev(keys_.end());
+    units_ += units;
+  }
+
+  inline void
+  remove(uint64_t key)
+  {
+    auto item = index_.find(key);
+    if (item != index_.end()) {
+      units_ -= item->second->second;
+      keys_.erase(item->second);
+      index_.erase(item);
+    }
+  }
+
+  /**
+   * @brief Forget the oldest key
+   */
+  inline void
+  pop()
+  {
+    units_ -= keys_.front().second;
+    index_.erase(keys_.front().first);
+    keys_.pop_front();
+  }
+
+  inline bool
+  empty() const
+  {
+    return keys_.empty();
+  }
+
+  inline size_t
+  units() const
+  {
+    return units_;
+  }
+
+  inline void
+  clear()
+  {
+    keys_.clear();
+    index_.clear();
+    units_ = 0;
+  }
+
+private:
+  typedef std::list<std::pair<uint64_t, size_t>> key_list;
+
+  key_list keys_;
+  std::unordered_map<uint64_t, key_list::iterator> index_;
+  size_t units_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // SIZE_AWARE_POLICY_H_
@@ -0,0 +1,272 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "size-aware-policy.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Count-min sketch of access frequencies with periodic aging
+ *
+ * DEPTH rows of 4-bit (saturating at 15) counters, indexed by differently mixed hashes of the
+ * key; the estimate is the smallest of the counters.  After 10 * width increments all counters
+ * are halved, so the sketch follows changes in popularity.
+ */
+class count_min_sketch {
+public:
+  static const size_t DEPTH = 4;
+  static const uint8_t MAX_COUNT = 15;
+
+  count_min_sketch()
+    : mask_(0)
+    , additions_(0)
+  {
+    resize(64);
+  }
+
+  /**
+   * @brief Reset the sketch to hold at least @p width counters per row
+   */
+  inline void
+  resize(size_t width)
+  {
+    size_t roundedWidth = 64;
+    while (roundedWidth < width)
+      roundedWidth <<= 1;
+
+    counters_.assign(DEPTH * roundedWidth, 0);
+    mask_ = roundedWidth - 1;
+    additions_ = 0;
+  }
+
+  inline void
+  increment(uint64_t key)
+  {
+    for (size_t row = 0; row < DEPTH; ++row) {
+      uint8_t& counter = counters_[row * (mask_ + 1) + index(key, row)];
+      if (counter < MAX_COUNT)
+        ++counter;
+    }
+
+    if (++additions_ >= 10 * (mask_ + 1)) {
+      for (uint8_t& counter : counters_)
+        counter >>= 1;
+      additions_ /= 2;
+    }
+  }
+
+  inline uint8_t
+  estimate(uint64_t key) const
+  {
+    uint8_t count = MAX_COUNT;
+    for (size_t row = 0; row < DEPTH; ++row) {
+      count = std::min(count, counters_[row * (mask_ + 1) + index(key, row)]);
+    }
+    return count;
+  }
+
+private:
+  inline size_t
+  index(uint64_t key, size_t row) const
+  {
+    static const uint64_t seeds[DEPTH] = {0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL,
+                                          0x165667b19e3779f9ULL, 0xd6e8feb86659fd93ULL};
+    uint64_t hash = (key ^ (key >> 31)) * seeds[row];
+    return static_cast<size_t>(hash >> 32) & mask_;
+  }
+
+private:
+  std::vector<uint8_t> counters_;
+  size_t mask_;
+  size_t additions_;
+};
+
+/**
+ * @brief Traits for LRU replacement policy with TinyLFU admission
+ *
+ * Accesses (lookups and insertions) of all names, cached or not, are counted in a
+ * count_min_sketch.  When the cache is full, new Data is admitted only if its name was
+ * accessed more often than the name of the least recently used entry, which is then evicted.
+ * One-time requests therefore do not push popular Data out of the cache.
+ */
+struct tinylfu_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "TinyLfu";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    uint64_t key;
+    size_t size;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    class type : public policy_container, public capacity_accounting {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+      {
+        resize_sketch();
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do relocation
+        policy_container::splice(policy_container::end(), *this,
+                                 policy_container::s_iterator_to(*item));
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = get_data_size(item);
+        uint64_t key = get_name_key(item);
+        sketch_.increment(key);
+
+        if (!fits(1, size)) {
+          return false; // would not fit into empty cache
+        }
+
+        if (!policy_container::empty() && !fits(policy_container::size() + 1, bytes_ + size)) {
+          uint8_t victimCount = sketch_.estimate(get_hook(&*policy_container::begin()).key);
+          if (sketch_.estimate(key) <= victimCount) {
+            return false; // not admitted
+          }
+
+          while (!policy_container::empty()
+                 && !fits(policy_container::size() + 1, bytes_ + size)) {
+            base_.erase(&(*policy_container::begin()));
+          }
+        }
+
+        policy_hook_type& hook = get_hook(item);
+        hook.key = key;
+        hook.size = size;
+
+        policy_container::push_back(*item);
+        bytes_ += size;
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        sketch_.increment(get_hook(item).key);
+
+        // do relocation
+        policy_container::splice(policy_container::end(), *this,
+                                 policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_ -= get_hook(item).size;
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        bytes_ = 0;
+        resize_sketch();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        capacity_accounting::set_max_size(max_size);
+        resize_sketch();
+      }
+
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        capacity_accounting::set_max_bytes(max_bytes);
+        resize_sketch();
+      }
+
+    private:
+      /**
+       * @brief Size sketch for the expected number of entries (assuming 1 KB Data when only
+       *        the byte limit is set)
+       */
+      inline void
+      resize_sketch()
+      {
+        size_t entries = max_size_;
+        if (max_bytes_ != 0 && (entries == 0 || max_bytes_ / 1024 < entries)) {
+          entries = max_bytes_ / 1024;
+        }
+        sketch_.resize(entries != 0 ? entries : 1024);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      count_min_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // TINYLFU_POLICY_H_
@@ -27,14 +27,81 @@
 
 #include "apps/ndn-app.hpp"
 
+#include <deque>
+#include <functional>
+
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
 namespace ns3 {
 namespace ndn {
 
-AppLinkService::AppLinkService(Ptr<App> app)
+namespace {
+
+// Packets that applications send while NFD of the simulation thread is busy (direct dispatch)
+struct DispatchState
+{
+  int depth = 0; // AppLinkService calls into NFD or applications on the stack
+  bool isFlushing = false;
+  bool isFlushScheduled = false;
+  std::deque<std::function<void()>> queue;
+};
+
+thread_local DispatchState g_dispatch;
+
+class DispatchGuard
+{
+public:
+  explicit
+  DispatchGuard(bool* isActive = nullptr)
+    : m_isActive(isActive)
+  {
+    ++g_dispatch.depth;
+    if (m_isActive != nullptr) {
+      *m_isActive = true;
+    }
+  }
+
+  ~DispatchGuard()
+  {
+    --g_dispatch.depth;
+    if (m_isActive != nullptr) {
+      *m_isActive = false;
+    }
+  }
+
+private:
+  bool* m_isActive;
+};
+
+void
+flushQueue()
+{
+  if (g_dispatch.isFlushing)
+    return;
+
+  g_dispatch.isFlushing = true;
+  while (g_dispatch.depth == 0 && !g_dispatch.queue.empty()) {
+    std::function<void()> receive = std::move(g_dispatch.queue.front());
+    g_dispatch.queue.pop_front();
+    receive();
+  }
+  g_dispatch.isFlushing = false;
+}
+
+void
+flushScheduledQueue()
+{
+  g_dispatch.isFlushScheduled = false;
+  flushQueue();
+}
+
+} // namespace
+
+AppLinkService::AppLinkService(Ptr<App> app, bool isDirectDispatch)
   : m_node(app->GetNode())
   , m_app(app)
+  , m_isDirectDispatch(isDirectDispatch)
+  , m_isReceiving(false)
 {
   NS_LOG_FUNCTION(this << app);
 
@@ -46,13 +113,64 @@ AppLinkService::~AppLinkService()
   NS_LOG_FUNCTION_NOARGS();
 }
 
+template<class Packet>
+void
+AppLinkService::sendToApp(void (App::*handler)(shared_ptr<const Packet>),
+                          shared_ptr<const Packet> packet)
+{
+  if (!m_isDirectDispatch || m_isReceiving) {
+    // to decouple callbacks
+    Simulator::ScheduleNow(handler, m_app, packet);
+    return;
+  }
+
+  {
+    DispatchGuard guard;
+    (PeekPointer(m_app)->*handler)(packet);
+  }
+
+  if (g_dispatch.depth == 0 && !g_dispatch.queue.empty() && !g_dispatch.isFlushScheduled) {
+    // NFD was not called by an application (e.g., packet from a NetDevice) and is still busy
+    g_dispatch.isFlushScheduled = true;
+    Simulator::ScheduleNow(&flushScheduledQueue);
+  }
+}
+
+template<class Packet>
+void
+AppLinkService::receiveFromApp(const Packet& packet,
+                               void (nfd::face::LinkService::*receive)(const Packet&))
+{
+  if (g_dispatch.depth > 0) {
+    // NFD is busy, e.g., with the packet being delivered to an application.  The face (and this
+    // link service) is kept alive until the queue is flushed, e.g., if the application restarts
+    // and creates a new face; packets of a face closed in the meantime are dropped
+    shared_ptr<const Face> face = getFace()->shared_from_this();
+    auto copy = make_shared<Packet>(packet);
+    g_dispatch.queue.push_back([this, face, copy, receive] {
+        if (face->getState() != nfd::face::TransportState::UP) {
+          NS_LOG_DEBUG("Face " << face->getId() << " is closed, dropping queued packet");
+          return;
+        }
+        receiveFromApp(*copy, receive);
+      });
+    return;
+  }
+
+  {
+    DispatchGuard guard(&m_isReceiving);
+    (this->*receive)(packet);
+  }
+
+  flushQueue();
+}
+
 void
 AppLinkService::doSendInterest(const Interest& interest)
 {
   NS_LOG_FUNCTION(this << &interest);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  sendToApp(&App::OnInterest, interest.shared_from_this());
 }
 
 void
@@ -60,8 +178,7 @@ AppLinkService::doSendData(const Data& data)
 {
   NS_LOG_FUNCTION(this << &data);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  sendToApp(&App::OnData, data.shared_from_this());
 }
 
 void
@@ -69,8 +186,7 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 {
   NS_LOG_FUNCTION(this << &nack);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
+  sendToApp<lp::Nack>(&App::OnNack, make_shared<lp::Nack>(nack));
 }
 
 //
@@ -78,19 +194,19 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 void
 AppLinkService::onReceiveInterest(const Interest& interest)
 {
-  this->receiveInterest(interest);
+  receiveFromApp(interest, &AppLinkService::receiveInterest);
 }
 
 void
 AppLinkService::onReceiveData(const Data& data)
 {
-  this->receiveData(data);
+  receiveFromApp(data, &AppLinkService::receiveData);
 }
 
 void
 AppLinkService::onReceiveNack(const lp::Nack& nack)
 {
-  this->receiveNack(nack);
+  receiveFromApp(nack, &AppLinkService::receiveNack);
 }
 
 } // namespace ndn
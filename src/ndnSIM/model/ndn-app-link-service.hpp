@@ -36,6 +36,14 @@ class App;
  * \ingroup ndn-face
  * \brief Implementation of LinkService for ndnSIM application
  *
+ * By default, packets are delivered to the application in a separate simulator event
+ * (Simulator::ScheduleNow), to decouple the application from NFD.  With direct dispatch
+ * (App attribute DirectDispatch), packets are delivered by calling the application directly,
+ * saving one event per packet.  Packets that the application sends while NFD is still
+ * processing (e.g., Data sent from OnInterest) are queued and passed to NFD when the outermost
+ * call returns, or in a separate event if NFD was not called by an application.  Packets for an
+ * application that is itself calling NFD are always delivered in a separate event.
+ *
  * \see NetDeviceLinkService
  */
 class AppLinkService : public nfd::face::LinkService
@@ -43,8 +51,9 @@ class AppLinkService : public nfd::face::LinkService
 public:
   /**
    * \brief Default constructor
+   * \param isDirectDispatch whether to deliver packets by calling the application directly
    */
-  AppLinkService(Ptr<App> app);
+  AppLinkService(Ptr<App> app, bool isDirectDispatch = false);
 
   virtual ~AppLinkService();
 
@@ -75,9 +84,25 @@ private:
     BOOST_ASSERT(false);
   }
 
+  /**
+   * \brief Pass packet from the application to NFD, or queue it if NFD is being called
+   */
+  template<class Packet>
+  void
+  receiveFromApp(const Packet& packet, void (nfd::face::LinkService::*receive)(const Packet&));
+
+  /**
+   * \brief Deliver packet to the application directly or in a separate event
+   */
+  template<class Packet>
+  void
+  sendToApp(void (App::*handler)(shared_ptr<const Packet>), shared_ptr<const Packet> packet);
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  bool m_isDirectDispatch;
+  bool m_isReceiving; ///< \brief whether the application is calling NFD
 };
 
 } // namespace ndn
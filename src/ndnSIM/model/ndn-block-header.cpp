@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include "../utils/ndn-virtual-payload.hpp"
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -53,58 +50,109 @@ BlockHeader::GetInstanceTypeId(void) const
 }
 
 BlockHeader::BlockHeader()
+  : m_begin(0)
+  , m_end(0)
 {
 }
 
 BlockHeader::BlockHeader(const nfdFace::Transport::Packet& packet)
   : m_block(packet.packet)
+  , m_begin(0)
+  , m_end(m_block.size())
 {
 }
 
+BlockHeader::BlockHeader(const Block& block, size_t begin, size_t end)
+  : m_block(block)
+  , m_begin(begin)
+  , m_end(end)
+{
+}
+
+Ptr<ns3::Packet>
+BlockHeader::CreatePacket(const nfdFace::Transport::Packet& packet)
+{
+  size_t payloadOffset = 0;
+  size_t payloadLength = 0;
+  if (!VirtualPayload::Find(packet.packet, payloadOffset, payloadLength)) {
+    Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(BlockHeader(packet));
+    return ns3Packet;
+  }
+
+  // ns-3 packet created with a size consists of the zero area, which takes no memory
+  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(payloadLength);
+  ns3Packet->AddHeader(BlockHeader(packet.packet, 0, payloadOffset));
+  ns3Packet->AddTrailer(BlockTrailer(packet.packet, payloadOffset + payloadLength));
+  return ns3Packet;
+}
+
 uint32_t
 BlockHeader::GetSerializedSize(void) const
 {
-  return m_block.size();
+  return m_end - m_begin;
 }
 
 void
 BlockHeader::Serialize(ns3::Buffer::Iterator start) const
 {
-  start.Write(m_block.wire(), m_block.size());
+  start.Write(m_block.wire() + m_begin, m_end - m_begin);
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+static bool
+readVarNumber(ns3::Buffer::Iterator& i, uint64_t& number)
+{
+  if (i.GetRemainingSize() < 1) {
+    return false;
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
+  uint8_t firstOctet = i.ReadU8();
+  if (firstOctet < 253) {
+    number = firstOctet;
+  }
+  else if (firstOctet == 253) {
+    if (i.GetRemainingSize() < 2) {
+      return false;
     }
-    if (i == 0) {
-      return -1;
+    number = i.ReadNtohU16();
+  }
+  else if (firstOctet == 254) {
+    if (i.GetRemainingSize() < 4) {
+      return false;
     }
-    else {
-      return i;
+    number = i.ReadNtohU32();
+  }
+  else {
+    if (i.GetRemainingSize() < 8) {
+      return false;
     }
+    number = i.ReadNtohU64();
   }
-
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  return true;
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
-  return m_block.size();
+  // Peek TLV-TYPE and TLV-LENGTH to learn the block size, then copy the whole block out of the
+  // ns-3 buffer at once (packet may carry trailing bytes, e.g., Ethernet padding)
+  ns3::Buffer::Iterator i = start;
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!readVarNumber(i, type) || !readVarNumber(i, length)) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data to decode TLV-TYPE and TLV-LENGTH"));
+  }
+  if (length > i.GetRemainingSize()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV"));
+  }
+  uint32_t size = i.GetDistanceFrom(start) + length;
+
+  auto buffer = make_shared< ::ndn::Buffer>(size);
+  start.Read(buffer->get<uint8_t>(), size);
+  m_block = Block(buffer);
+  m_begin = 0;
+  m_end = size;
+  return size;
 }
 
 void
@@ -167,5 +215,61 @@ BlockHeader::getBlock() const
   return m_block;
 }
 
+ns3::TypeId
+BlockTrailer::GetTypeId()
+{
+  static ns3::TypeId tid =
+    ns3::TypeId("ns3::ndn::PacketTrailer")
+    .SetGroupName("Ndn")
+    .SetParent<Trailer>()
+    .AddConstructor<BlockTrailer>()
+    ;
+  return tid;
+}
+
+TypeId
+BlockTrailer::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+BlockTrailer::BlockTrailer()
+  : m_begin(0)
+{
+}
+
+BlockTrailer::BlockTrailer(const Block& block, size_t begin)
+  : m_block(block)
+  , m_begin(begin)
+{
+}
+
+uint32_t
+BlockTrailer::GetSerializedSize(void) const
+{
+  return m_block.hasWire() ? m_block.size() - m_begin : 0;
+}
+
+void
+BlockTrailer::Serialize(ns3::Buffer::Iterator end) const
+{
+  uint32_t size = GetSerializedSize();
+  end.Prev(size);
+  end.Write(m_block.wire() + m_begin, size);
+}
+
+uint32_t
+BlockTrailer::Deserialize(ns3::Buffer::Iterator end)
+{
+  // the size is only known from the beginning of the block, which is decoded by BlockHeader
+  return 0;
+}
+
+void
+BlockTrailer::Print(std::ostream& os) const
+{
+  os << "end of block";
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -21,6 +21,8 @@
 #define NDNSIM_NDN_BLOCK_HEADER_HPP
 
 #include "ns3/header.h"
+#include "ns3/trailer.h"
+#include "ns3/packet.h"
 
 #include "ndn-common.hpp"
 
@@ -41,6 +43,23 @@ public:
 
   BlockHeader(const nfdFace::Transport::Packet& packet);
 
+  /**
+   * @brief Create header holding bytes [@p begin, @p end) of the wire encoding of @p block
+   *
+   * Only for sending, see CreatePacket.
+   */
+  BlockHeader(const Block& block, size_t begin, size_t end);
+
+  /**
+   * @brief Create ns-3 packet carrying @p packet
+   *
+   * If @p packet holds Data with a zero-filled Content (see VirtualPayload), the Content value
+   * is the zero area of the ns-3 packet, between BlockHeader and BlockTrailer holding the rest
+   * of the block.  Either way the packet is received as a single BlockHeader.
+   */
+  static Ptr<ns3::Packet>
+  CreatePacket(const nfdFace::Transport::Packet& packet);
+
   virtual uint32_t
   GetSerializedSize(void) const;
 
@@ -61,6 +80,45 @@ public:
 
 private:
   Block m_block;
+  size_t m_begin;
+  size_t m_end;
+};
+
+/**
+ * @brief Trailer holding the end of a block whose beginning is in BlockHeader
+ *
+ * Only for sending, see BlockHeader::CreatePacket.
+ */
+class BlockTrailer : public Trailer {
+public:
+  static ns3::TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  BlockTrailer();
+
+  /**
+   * @brief Create trailer holding bytes of the wire encoding of @p block from @p begin
+   */
+  BlockTrailer(const Block& block, size_t begin);
+
+  virtual uint32_t
+  GetSerializedSize(void) const;
+
+  virtual void
+  Serialize(ns3::Buffer::Iterator end) const;
+
+  virtual uint32_t
+  Deserialize(ns3::Buffer::Iterator end);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  Block m_block;
+  size_t m_begin;
 };
 
 } // namespace ndn
@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-chord-name-resolver.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "apps/ndn-chord-transport.hpp"
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/chord-ipv4.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <openssl/sha.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ChordNameResolver");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ChordNameResolver);
+
+TypeId
+ChordNameResolver::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ChordNameResolver")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<ChordNameResolver>()
+      .AddAttribute("LocatorPrefix", "Prefix under which Chord locators are routed",
+                    StringValue("/chord"), MakeNameAccessor(&ChordNameResolver::m_locatorPrefix),
+                    MakeNameChecker())
+      .AddAttribute("PrefixLength", "Number of name components resolved through Chord",
+                    UintegerValue(1), MakeUintegerAccessor(&ChordNameResolver::m_prefixLength),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("CacheLifetime",
+                    "Lifetime of resolved FIB entries, if 0, entries never expire",
+                    StringValue("60s"), MakeTimeAccessor(&ChordNameResolver::m_cacheLifetime),
+                    MakeTimeChecker())
+
+      .AddTraceSource("Resolved", "Name prefix resolved to producer locator (prefix, locator, latency)",
+                      MakeTraceSourceAccessor(&ChordNameResolver::m_resolvedTrace),
+                      "ns3::ndn::ChordNameResolver::ResolvedCallback");
+  return tid;
+}
+
+ChordNameResolver::ChordNameResolver()
+  : m_prefixLength(1)
+{
+  m_stats.cacheHits = 0;
+  m_stats.cacheMisses = 0;
+  m_stats.lookups = 0;
+  m_stats.resolved = 0;
+  m_stats.failures = 0;
+}
+
+void
+ChordNameResolver::NotifyNewAggregate()
+{
+  if (m_ndn == 0) {
+    m_ndn = GetObject<L3Protocol>();
+  }
+  Object::NotifyNewAggregate();
+}
+
+void
+ChordNameResolver::DoDispose()
+{
+  for (auto& entry : m_cache) {
+    Simulator::Cancel(entry.second.expireEvent);
+  }
+  m_cache.clear();
+  m_pending.clear();
+
+  m_ndn = 0;
+  m_chord = 0;
+  Object::DoDispose();
+}
+
+void
+ChordNameResolver::SetChord(Ptr<ChordIpv4> chord)
+{
+  m_chord = chord;
+
+  Ipv4AddressValue localIpAddress;
+  m_chord->GetAttribute("LocalIpAddress", localIpAddress);
+  m_localIpAddress = localIpAddress.Get();
+
+  m_chord->SetLookupOwnerCallback(MakeCallback(&ChordNameResolver::OnLookupSuccess, this));
+  m_chord->SetLookupFailureCallback(MakeCallback(&ChordNameResolver::OnLookupFailure, this));
+}
+
+Ptr<ChordIpv4>
+ChordNameResolver::GetChord() const
+{
+  return m_chord;
+}
+
+std::string
+ChordNameResolver::GetKey(const Name& prefix)
+{
+  std::string uri = prefix.toUri();
+  uint8_t digest[SHA_DIGEST_LENGTH];
+  SHA1(reinterpret_cast<const uint8_t*>(uri.data()), uri.size(), digest);
+  return std::string(reinterpret_cast<char*>(digest), sizeof(digest));
+}
+
+void
+ChordNameResolver::RegisterPrefix(const Name& prefix)
+{
+  NS_ASSERT_MSG(m_chord != 0, "ChordIpv4 is not set");
+
+  std::string key = GetKey(prefix);
+  m_chord->InsertVNode(prefix.toUri(), reinterpret_cast<uint8_t*>(&key[0]), key.size());
+}
+
+Name
+ChordNameResolver::GetResolvedPrefix(const Name& name) const
+{
+  return name.getPrefix(m_prefixLength);
+}
+
+bool
+ChordNameResolver::IsResolved(const Name& name) const
+{
+  return m_cache.find(GetResolvedPrefix(name)) != m_cache.end();
+}
+
+void
+ChordNameResolver::NotifyCacheHit()
+{
+  m_stats.cacheHits++;
+}
+
+void
+ChordNameResolver::Resolve(const Name& name, const ResolveCallback& callback)
+{
+  m_stats.cacheMisses++;
+
+  Name prefix = GetResolvedPrefix(name);
+  if (m_chord == 0 || m_locatorPrefix.isPrefixOf(prefix)) {
+    // locators have to be routed by other means, otherwise resolution would loop
+    m_stats.failures++;
+    callback(prefix, false);
+    return;
+  }
+
+  std::string key = GetKey(prefix);
+  auto pending = m_pending.find(key);
+  if (pending != m_pending.end()) {
+    pending->second.callbacks.push_back(callback);
+    return;
+  }
+
+  PendingResolution& resolution = m_pending[key];
+  resolution.prefix = prefix;
+  resolution.startTime = Simulator::Now();
+  resolution.callbacks.push_back(callback);
+
+  NS_LOG_DEBUG("Resolving " << prefix);
+  m_stats.lookups++;
+  // callback may be fired synchronously if this node owns the key
+  m_chord->LookupKey(reinterpret_cast<uint8_t*>(&key[0]), key.size());
+}
+
+void
+ChordNameResolver::OnLookupSuccess(uint8_t* key, uint8_t keyBytes, uint8_t* owner,
+                                   uint8_t ownerBytes, Ipv4Address ipAddress, uint16_t port)
+{
+  std::string lookupKey(reinterpret_cast<char*>(key), keyBytes);
+  auto pending = m_pending.find(lookupKey);
+  if (pending == m_pending.end()) {
+    return;
+  }
+
+  const Name& prefix = pending->second.prefix;
+  if (lookupKey != std::string(reinterpret_cast<char*>(owner), ownerBytes)) {
+    // key is owned by its successor, nobody has registered the prefix
+    NS_LOG_DEBUG("Prefix " << prefix << " is not registered");
+    m_stats.failures++;
+    Finish(lookupKey, false);
+    return;
+  }
+
+  if (ipAddress == m_localIpAddress) {
+    // prefix is registered locally, there is nothing to resolve
+    NS_LOG_DEBUG("Prefix " << prefix << " is produced locally");
+    m_stats.failures++;
+    Finish(lookupKey, false);
+    return;
+  }
+
+  if (!InstallRoute(prefix, ipAddress)) {
+    m_stats.failures++;
+    Finish(lookupKey, false);
+    return;
+  }
+
+  Time latency = Simulator::Now() - pending->second.startTime;
+  NS_LOG_DEBUG("Resolved " << prefix << " to " << ipAddress << " in " << latency.As(Time::MS));
+  m_stats.resolved++;
+  m_stats.totalLatency += latency;
+  m_resolvedTrace(prefix, ipAddress, latency);
+
+  Finish(lookupKey, true);
+}
+
+void
+ChordNameResolver::OnLookupFailure(uint8_t* key, uint8_t keyBytes)
+{
+  std::string lookupKey(reinterpret_cast<char*>(key), keyBytes);
+  if (m_pending.find(lookupKey) == m_pending.end()) {
+    return;
+  }
+
+  m_stats.failures++;
+  Finish(lookupKey, false);
+}
+
+void
+ChordNameResolver::Finish(const std::string& key, bool isResolved)
+{
+  auto pending = m_pending.find(key);
+  PendingResolution resolution = pending->second;
+  m_pending.erase(pending);
+
+  for (const auto& callback : resolution.callbacks) {
+    callback(resolution.prefix, isResolved);
+  }
+}
+
+bool
+ChordNameResolver::InstallRoute(const Name& prefix, Ipv4Address locator)
+{
+  nfd::Fib& fib = m_ndn->getForwarder()->getFib();
+
+  Name locatorName = ChordNdnTransport::GetLocatorPrefix(m_locatorPrefix, locator);
+  const nfd::fib::Entry& locatorEntry = fib.findLongestPrefixMatch(locatorName);
+  if (!locatorEntry.hasNextHops() || !m_locatorPrefix.isPrefixOf(locatorEntry.getPrefix())) {
+    NS_LOG_DEBUG("No route towards locator " << locatorName);
+    return false;
+  }
+
+  nfd::fib::Entry* entry = fib.insert(prefix).first;
+  for (const auto& nexthop : locatorEntry.getNextHops()) {
+    entry->addNextHop(nexthop.getFace(), nexthop.getCost());
+  }
+
+  CacheEntry& cacheEntry = m_cache[prefix];
+  cacheEntry.locator = locator;
+  Simulator::Cancel(cacheEntry.expireEvent);
+  if (!m_cacheLifetime.IsZero()) {
+    cacheEntry.expireEvent =
+      Simulator::Schedule(m_cacheLifetime, &ChordNameResolver::ExpireRoute, this, prefix);
+  }
+  return true;
+}
+
+void
+ChordNameResolver::ExpireRoute(const Name& prefix)
+{
+  NS_LOG_DEBUG("Resolved entry for " << prefix << " expired");
+  m_cache.erase(prefix);
+  m_ndn->getForwarder()->getFib().erase(prefix);
+}
+
+const ChordNameResolver::Stats&
+ChordNameResolver::GetStats() const
+{
+  return m_stats;
+}
+
+void
+ChordNameResolver::PrintStats(std::ostream& os) const
+{
+  uint32_t interests = m_stats.cacheHits + m_stats.cacheMisses;
+  os << "CacheHits " << m_stats.cacheHits << " CacheMisses " << m_stats.cacheMisses
+     << " HitRate " << (interests > 0 ? 1.0 * m_stats.cacheHits / interests : 0.0)
+     << " Lookups " << m_stats.lookups << " Resolved " << m_stats.resolved
+     << " Failures " << m_stats.failures << " MeanLatency "
+     << (m_stats.resolved > 0 ? m_stats.totalLatency.ToDouble(Time::MS) / m_stats.resolved : 0.0)
+     << "ms";
+}
+
+} // namespace ndn
+} // namespace ns3
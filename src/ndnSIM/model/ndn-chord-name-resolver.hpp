@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHORD_NAME_RESOLVER_H
+#define NDN_CHORD_NAME_RESOLVER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/traced-callback.h"
+
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+class ChordIpv4;
+
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Per-node service resolving name prefixes to producer locations through Chord
+ *
+ * A producer announces prefix P by inserting a Chord virtual node with identifier SHA1(P) (see
+ * RegisterPrefix).  A Chord lookup of SHA1(P) therefore resolves to the IPv4 locator of that
+ * producer; if the owner of SHA1(P) has a different identifier, P has not been registered and
+ * the resolution fails.  The resolver installs a FIB entry for P that reuses the next hops of the
+ * producer's locator prefix `<LocatorPrefix>/<ip>` (see ChordNdnTransport::GetLocatorPrefix), so
+ * only the locator prefixes have to be routed in advance.
+ *
+ * Installed entries expire after CacheLifetime and are removed from the FIB, so the next
+ * Interest triggers a new resolution.  The resolver takes over lookup callbacks of ChordIpv4.
+ */
+class ChordNameResolver : public Object {
+public:
+  /**
+   * @brief Resolution counters
+   */
+  struct Stats {
+    uint32_t cacheHits;     ///< @brief Interests forwarded using a previously resolved entry
+    uint32_t cacheMisses;   ///< @brief Interests without FIB match
+    uint32_t lookups;       ///< @brief Chord lookups issued
+    uint32_t resolved;      ///< @brief successful resolutions
+    uint32_t failures;      ///< @brief failed resolutions (lookup failure or unregistered prefix)
+    Time totalLatency;      ///< @brief sum of latencies of successful resolutions
+  };
+
+  typedef std::function<void(const Name& prefix, bool isResolved)> ResolveCallback;
+
+  typedef void (*ResolvedCallback)(const Name&, Ipv4Address, Time);
+
+  static TypeId
+  GetTypeId();
+
+  ChordNameResolver();
+
+  /**
+   * @brief Set ChordIpv4 instance used to resolve names, normally installed on the same node
+   */
+  void
+  SetChord(Ptr<ChordIpv4> chord);
+
+  Ptr<ChordIpv4>
+  GetChord() const;
+
+  /**
+   * @brief Announce that this node produces data under @p prefix
+   *
+   * Inserts Chord virtual node with identifier derived from @p prefix
+   */
+  void
+  RegisterPrefix(const Name& prefix);
+
+  /**
+   * @brief Get prefix of @p name that is resolved (first PrefixLength components)
+   */
+  Name
+  GetResolvedPrefix(const Name& name) const;
+
+  /**
+   * @brief Check whether @p name falls into a prefix installed by the resolver
+   *
+   * Used to account cache hits
+   */
+  bool
+  IsResolved(const Name& name) const;
+
+  /**
+   * @brief Start resolution of prefix of @p name unless one is already in progress
+   *
+   * @p callback is called when FIB entry is installed or resolution fails
+   */
+  void
+  Resolve(const Name& name, const ResolveCallback& callback);
+
+  /**
+   * @brief Account Interest forwarded via entry installed by the resolver
+   */
+  void
+  NotifyCacheHit();
+
+  const Stats&
+  GetStats() const;
+
+  /**
+   * @brief Print resolution statistics
+   */
+  void
+  PrintStats(std::ostream& os) const;
+
+  /**
+   * @brief Calculate identifier of @p prefix in Chord key space
+   */
+  static std::string
+  GetKey(const Name& prefix);
+
+protected:
+  // inherited from Object
+  virtual void
+  NotifyNewAggregate();
+
+  virtual void
+  DoDispose();
+
+private:
+  void
+  OnLookupSuccess(uint8_t* key, uint8_t keyBytes, uint8_t* owner, uint8_t ownerBytes,
+                  Ipv4Address ipAddress, uint16_t port);
+
+  void
+  OnLookupFailure(uint8_t* key, uint8_t keyBytes);
+
+  bool
+  InstallRoute(const Name& prefix, Ipv4Address locator);
+
+  void
+  ExpireRoute(const Name& prefix);
+
+  void
+  Finish(const std::string& key, bool isResolved);
+
+private:
+  struct PendingResolution {
+    Name prefix;
+    Time startTime;
+    std::list<ResolveCallback> callbacks;
+  };
+
+  struct CacheEntry {
+    Ipv4Address locator;
+    EventId expireEvent;
+  };
+
+  Ptr<L3Protocol> m_ndn;
+  Ptr<ChordIpv4> m_chord;
+  Ipv4Address m_localIpAddress;
+
+  Name m_locatorPrefix;
+  uint32_t m_prefixLength;
+  Time m_cacheLifetime;
+
+  std::map<std::string, PendingResolution> m_pending; ///< @brief key -> resolution in progress
+  std::map<Name, CacheEntry> m_cache;                 ///< @brief resolved prefix -> locator
+
+  Stats m_stats;
+
+  TracedCallback<const Name&, Ipv4Address, Time> m_resolvedTrace;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHORD_NAME_RESOLVER_H
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-chord-resolver-strategy.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/algorithm.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ChordResolverStrategy");
+
+namespace ns3 {
+namespace ndn {
+
+ChordResolverStrategy::ChordResolverStrategy(nfd::Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+{
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+const Name&
+ChordResolverStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/chord-resolver/%FD%01");
+  return strategyName;
+}
+
+Ptr<ChordNameResolver>
+ChordResolverStrategy::getResolver()
+{
+  if (m_resolver == 0) {
+    // strategy is always invoked in the context of the node owning the forwarder
+    m_resolver = NodeList::GetNode(Simulator::GetContext())->GetObject<ChordNameResolver>();
+  }
+  return m_resolver;
+}
+
+void
+ChordResolverStrategy::afterReceiveInterest(const nfd::Face& inFace, const Interest& interest,
+                                            const shared_ptr<nfd::pit::Entry>& pitEntry)
+{
+  if (nfd::fw::hasPendingOutRecords(*pitEntry)) {
+    // not a new Interest, don't forward
+    return;
+  }
+
+  Ptr<ChordNameResolver> resolver = getResolver();
+
+  const nfd::fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  if (fibEntry.hasNextHops() || resolver == 0) {
+    if (resolver != 0 && resolver->IsResolved(interest.getName())) {
+      resolver->NotifyCacheHit();
+    }
+    forward(inFace, pitEntry);
+    return;
+  }
+
+  NS_LOG_DEBUG("No route for " << interest.getName() << ", resolving through Chord");
+  resolver->Resolve(interest.getName(),
+                    std::bind(&ChordResolverStrategy::onResolved, this, inFace.getId(),
+                              std::weak_ptr<nfd::pit::Entry>(pitEntry), std::placeholders::_2));
+}
+
+void
+ChordResolverStrategy::onResolved(nfd::FaceId inFaceId, std::weak_ptr<nfd::pit::Entry> weakPitEntry,
+                                  bool isResolved)
+{
+  shared_ptr<nfd::pit::Entry> pitEntry = weakPitEntry.lock();
+  nfd::Face* inFace = this->getFace(inFaceId);
+  if (pitEntry == nullptr || inFace == nullptr) {
+    // Interest expired or downstream face is gone while waiting for resolution
+    return;
+  }
+
+  if (!isResolved) {
+    NS_LOG_DEBUG("Cannot resolve " << pitEntry->getName());
+    lp::NackHeader nackHeader;
+    nackHeader.setReason(lp::NackReason::NO_ROUTE);
+    this->sendNack(pitEntry, *inFace, nackHeader);
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  forward(*inFace, pitEntry);
+}
+
+void
+ChordResolverStrategy::forward(const nfd::Face& inFace, const shared_ptr<nfd::pit::Entry>& pitEntry)
+{
+  const Interest& interest = pitEntry->getInterest();
+  const nfd::fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+
+  // next hops are sorted by cost
+  for (const auto& nexthop : fibEntry.getNextHops()) {
+    nfd::Face& outFace = nexthop.getFace();
+    if (outFace.getId() == inFace.getId() || nfd::fw::wouldViolateScope(inFace, interest, outFace)) {
+      continue;
+    }
+
+    this->sendInterest(pitEntry, outFace, interest);
+    return;
+  }
+
+  lp::NackHeader nackHeader;
+  nackHeader.setReason(lp::NackReason::NO_ROUTE);
+  this->sendNack(pitEntry, inFace, nackHeader);
+  this->rejectPendingInterest(pitEntry);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHORD_RESOLVER_STRATEGY_H
+#define NDN_CHORD_RESOLVER_STRATEGY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-chord-name-resolver.hpp"
+
+#include "ns3/ptr.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Forwarding strategy that resolves unknown name prefixes through Chord
+ *
+ * Interests with a FIB match are forwarded to the lowest-cost eligible next hop.  When the only
+ * match is an entry without next hops (e.g., the root entry), the strategy asks the node's
+ * ChordNameResolver to resolve the prefix, which installs a FIB entry towards the producer, and
+ * then forwards all Interests that were waiting for the resolution.  If the prefix cannot be
+ * resolved, the Interest is Nacked with reason NoRoute.
+ *
+ * Use StrategyChoiceHelper::Install<ChordResolverStrategy>(nodes, "/") or
+ * ChordResolverHelper::Install.
+ */
+class ChordResolverStrategy : public nfd::fw::Strategy {
+public:
+  explicit ChordResolverStrategy(nfd::Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+  virtual void
+  afterReceiveInterest(const nfd::Face& inFace, const Interest& interest,
+                       const shared_ptr<nfd::pit::Entry>& pitEntry) override;
+
+private:
+  void
+  forward(const nfd::Face& inFace, const shared_ptr<nfd::pit::Entry>& pitEntry);
+
+  void
+  onResolved(nfd::FaceId inFaceId, std::weak_ptr<nfd::pit::Entry> weakPitEntry, bool isResolved);
+
+  Ptr<ChordNameResolver>
+  getResolver();
+
+private:
+  Ptr<ChordNameResolver> m_resolver;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHORD_RESOLVER_STRATEGY_H
@@ -82,6 +82,29 @@ GlobalRouter::GetIncidencies()
   return m_incidencies;
 }
 
+void
+GlobalRouter::SetIncidencyUp(shared_ptr<Face> face, bool isUp)
+{
+  if (isUp) {
+    m_downFaces.erase(face.get());
+  }
+  else {
+    m_downFaces.insert(face.get());
+  }
+}
+
+bool
+GlobalRouter::IsIncidencyUp(const Face* face) const
+{
+  return m_downFaces.empty() || m_downFaces.count(face) == 0;
+}
+
+GlobalRouter::RouteList&
+GlobalRouter::GetInstalledRoutes()
+{
+  return m_installedRoutes;
+}
+
 const GlobalRouter::LocalPrefixList&
 GlobalRouter::GetLocalPrefixes() const
 {
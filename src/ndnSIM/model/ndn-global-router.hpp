@@ -26,7 +26,9 @@
 #include "ns3/ptr.h"
 
 #include <list>
+#include <set>
 #include <tuple>
+#include <vector>
 
 namespace ns3 {
 
@@ -54,6 +56,10 @@ public:
    * @brief List of locally exported prefixes
    */
   typedef std::list<shared_ptr<Name>> LocalPrefixList;
+  /**
+   * @brief List of FIB next hops (prefix, face) installed by GlobalRoutingHelper
+   */
+  typedef std::vector<std::pair<shared_ptr<Name>, shared_ptr<Face>>> RouteList;
 
   /**
    * \brief Interface ID
@@ -101,6 +107,24 @@ public:
   IncidencyList&
   GetIncidencies();
 
+  /**
+   * @brief Mark edge over the face as down (excluded from route calculation) or up
+   */
+  void
+  SetIncidencyUp(shared_ptr<Face> face, bool isUp);
+
+  /**
+   * @brief Check whether edge over the face is up
+   */
+  bool
+  IsIncidencyUp(const Face* face) const;
+
+  /**
+   * @brief Get FIB next hops installed on the node by GlobalRoutingHelper in incremental mode
+   */
+  RouteList&
+  GetInstalledRoutes();
+
   /**
    * @brief Get list of locally exported prefixes
    */
@@ -124,6 +148,8 @@ private:
   Ptr<L3Protocol> m_ndn;
   LocalPrefixList m_localPrefixes;
   IncidencyList m_incidencies;
+  std::set<const Face*> m_downFaces;
+  RouteList m_installedRoutes;
 
   static uint32_t m_idCounter;
 };
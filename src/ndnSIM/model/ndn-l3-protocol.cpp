@@ -108,10 +108,12 @@ L3Protocol::GetTypeId(void)
   return tid;
 }
 
-class L3Protocol::Impl {
-private:
-  Impl()
-  {
+static const nfd::ConfigSection&
+getInitialConfig()
+{
+  // Parsed once and copied into every node, so that large topologies do not pay for parsing
+  static nfd::ConfigSection config;
+  if (config.empty()) {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -162,7 +164,16 @@ private:
       "\n";
 
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    boost::property_tree::read_info(input, config);
+  }
+  return config;
+}
+
+class L3Protocol::Impl {
+private:
+  Impl()
+    : m_config(getInitialConfig())
+  {
   }
 
   friend class L3Protocol;
@@ -208,12 +219,18 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
-  initializeManagement();
+  initializeTables();
+
+  // Lightweight nodes create the management plane on first use (see injectInterest)
+  bool isLightweight = this->getConfig().get<bool>("ndnSIM.lightweight", false);
+  if (!isLightweight) {
+    initializeManagement();
+  }
 
   nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
   faceTable.addReserved(nfd::face::makeNullFace(), nfd::face::FACEID_NULL);
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
+  if (!isLightweight && !this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
     Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
   }
 
@@ -245,15 +262,47 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  if (!hasManagement()) {
+    initializeManagement();
+  }
   m_impl->m_internalFace->sendInterest(interest);
 }
 
+bool
+L3Protocol::hasManagement() const
+{
+  return m_impl->m_dispatcher != nullptr;
+}
+
 void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
   m_impl->m_policy = policy;
 }
 
+void
+L3Protocol::initializeTables()
+{
+  auto& forwarder = m_impl->m_forwarder;
+  using namespace nfd;
+
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+
+  // if we use NFD's CS, we have to specify a replacement policy
+  m_impl->m_csFromNdnSim = GetObject<ContentStore>();
+  if (m_impl->m_csFromNdnSim == nullptr) {
+    forwarder->getCs().setPolicy(m_impl->m_policy());
+  }
+
+  TablesConfigSection tablesConfig(*forwarder);
+  tablesConfig.setConfigFile(config);
+
+  // apply config
+  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+
+  tablesConfig.ensureConfigured();
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -299,15 +348,6 @@ L3Protocol::initializeManagement()
 
   ConfigFile config(&ConfigFile::ignoreUnknownSection);
 
-  // if we use NFD's CS, we have to specify a replacement policy
-  m_impl->m_csFromNdnSim = GetObject<ContentStore>();
-  if (m_impl->m_csFromNdnSim == nullptr) {
-    forwarder->getCs().setPolicy(m_impl->m_policy());
-  }
-
-  TablesConfigSection tablesConfig(*forwarder);
-  tablesConfig.setConfigFile(config);
-
   m_impl->m_authenticator->setConfigFile(config);
 
   // if (!this->getConfig().get<bool>("ndnSIM.disable_face_manager", false)) {
@@ -317,8 +357,6 @@ L3Protocol::initializeManagement()
   // apply config
   config.parse(m_impl->m_config, false, "ndnSIM.conf");
 
-  tablesConfig.ensureConfigured();
-
   // add FIB entry for NFD Management Protocol
   Name topPrefix("/localhost/nfd");
   auto entry = forwarder->getFib().insert(topPrefix).first;
@@ -369,12 +407,18 @@ L3Protocol::getForwarder()
 shared_ptr<nfd::FibManager>
 L3Protocol::getFibManager()
 {
+  if (!hasManagement()) {
+    initializeManagement();
+  }
   return m_impl->m_fibManager;
 }
 
 shared_ptr<nfd::StrategyChoiceManager>
 L3Protocol::getStrategyChoiceManager()
 {
+  if (!hasManagement()) {
+    initializeManagement();
+  }
   return m_impl->m_strategyChoiceManager;
 }
 
@@ -103,12 +103,16 @@ public:
 
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   *
+   * On a lightweight node, the call creates the management plane if it does not exist yet
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
 
   /**
    * \brief Get smart pointer to nfd::StrategyChoiceManager, used by node's NFD
+   *
+   * On a lightweight node, the call creates the management plane if it does not exist yet
    */
   shared_ptr<nfd::StrategyChoiceManager>
   getStrategyChoiceManager();
@@ -152,10 +156,21 @@ public:
 
   /**
    * \brief Inject interest through internal Face
+   *
+   * On a lightweight node, the call creates the management plane if it does not exist yet
    */
   void
   injectInterest(const Interest& interest);
 
+  /**
+   * \brief Check whether the management plane (internal face, dispatcher and managers) exists
+   *
+   * The management plane is always created on regular nodes.  Nodes installed with
+   * StackHelper::setLightweight create it only when a management command is injected.
+   */
+  bool
+  hasManagement() const;
+
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
 
   /**
@@ -192,6 +207,9 @@ private:
   void
   initialize();
 
+  void
+  initializeTables();
+
   void
   initializeManagement();
 
@@ -104,10 +104,7 @@ NetDeviceTransport::doSend(Packet&& packet)
                   << this->getLocalUri());
 
   // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
-
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+  Ptr<ns3::Packet> ns3Packet = BlockHeader::CreatePacket(packet);
 
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
@@ -124,11 +121,9 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
-
+  // Convert NS3 packet to NFD packet, decoding straight from the (shared) packet buffer
   BlockHeader header;
-  packet->RemoveHeader(header);
+  p->PeekHeader(header);
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
 
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-app-dispatch-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Simulator events and runtime of application-heavy scenarios with and without direct dispatch
+ * of packets to applications (App attribute DirectDispatch).
+ *
+ * Runs the ndn-grid scenario (3x3 grid, producer of /prefix in the corner) with ConsumerCbr
+ * applications on every node (100 per node by default) and reports the number of scheduled
+ * events, wall-clock time, and events per second, once with packets delivered to applications
+ * in separate events and once with direct dispatch.
+ *
+ * By default, every consumer requests its own names (/prefix/<node>/<consumer>/<seq>).  With
+ * --same-names, all consumers request /prefix/<seq>, so most Interests are answered from the
+ * Content Store of the consumer's node while the consumer is still calling NFD; such Data is
+ * always delivered in a separate event.
+ *
+ *     ./waf --run "ndn-app-dispatch-benchmark --consumers=100 --sim-time=10"
+ */
+
+/**
+ * Default simulator that counts scheduled events
+ */
+class CountingSimulatorImpl : public DefaultSimulatorImpl {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CountingSimulatorImpl")
+                          .SetParent<DefaultSimulatorImpl>()
+                          .AddConstructor<CountingSimulatorImpl>();
+    return tid;
+  }
+
+  virtual EventId
+  Schedule(const Time& delay, EventImpl* event)
+  {
+    s_nEvents++;
+    return DefaultSimulatorImpl::Schedule(delay, event);
+  }
+
+  virtual void
+  ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+  {
+    s_nEvents++;
+    DefaultSimulatorImpl::ScheduleWithContext(context, delay, event);
+  }
+
+  virtual EventId
+  ScheduleNow(EventImpl* event)
+  {
+    s_nEvents++;
+    return DefaultSimulatorImpl::ScheduleNow(event);
+  }
+
+  static uint64_t s_nEvents;
+};
+
+uint64_t CountingSimulatorImpl::s_nEvents = 0;
+
+NS_OBJECT_ENSURE_REGISTERED(CountingSimulatorImpl);
+
+static uint64_t g_nReceivedDatas = 0;
+
+static void
+countData(shared_ptr<const ndn::Data>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+{
+  g_nReceivedDatas++;
+}
+
+static void
+runGrid(bool isDirectDispatch, uint32_t nConsumers, double frequency, double simulationTime,
+        bool isSameNames)
+{
+  Config::SetDefault("ns3::ndn::App::DirectDispatch", BooleanValue(isDirectDispatch));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> producer = grid.GetNode(2, 2);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.SetAttribute("Randomize", StringValue("uniform"));
+  for (uint32_t row = 0; row < 3; row++) {
+    for (uint32_t column = 0; column < 3; column++) {
+      for (uint32_t i = 0; i < nConsumers; i++) {
+        ndn::Name prefix("/prefix");
+        if (!isSameNames) {
+          prefix.appendNumber(row * 3 + column).appendNumber(i);
+        }
+        consumerHelper.SetPrefix(prefix.toUri());
+        consumerHelper.Install(grid.GetNode(row, column));
+      }
+    }
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  g_nReceivedDatas = 0;
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::App/ReceivedDatas",
+                                MakeCallback(&countData));
+
+  Simulator::Stop(Seconds(simulationTime));
+
+  uint64_t nEvents = CountingSimulatorImpl::s_nEvents;
+  double start = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - start;
+  nEvents = CountingSimulatorImpl::s_nEvents - nEvents;
+
+  std::cout << (isDirectDispatch ? "Direct dispatch:    " : "Scheduled dispatch: ") << nEvents
+            << " events, " << realTime << " s, " << nEvents / realTime << " events/s, "
+            << g_nReceivedDatas << " Data received by consumers\n";
+
+  Simulator::Destroy();
+  ndn::GlobalRouter::clear();
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("100Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(1000));
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::CountingSimulatorImpl"));
+
+  uint32_t nConsumers = 100;
+  double frequency = 10;
+  double simulationTime = 10;
+  bool isSameNames = false;
+
+  CommandLine cmd;
+  cmd.AddValue("consumers", "Number of ConsumerCbr applications on every node", nConsumers);
+  cmd.AddValue("frequency", "Interests per second sent by each consumer", frequency);
+  cmd.AddValue("sim-time", "Simulated time in seconds", simulationTime);
+  cmd.AddValue("same-names", "Whether all consumers request the same names", isSameNames);
+  cmd.Parse(argc, argv);
+
+  runGrid(false, nConsumers, frequency, simulationTime, isSameNames);
+  runGrid(true, nConsumers, frequency, simulationTime, isSameNames);
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,303 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-consumer-retx-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer.hpp"
+#include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/tag.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <sstream>
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Per-Interest cost of the retransmission bookkeeping of ndn::Consumer.
+ *
+ * For every window size, sends --interests Interests with consecutive sequence numbers, --batch
+ * of them every millisecond of simulation time, and acknowledges every Interest once the given
+ * number of later Interests has been sent, i.e., keeps the window full.  The same load is run
+ * through ndn::Consumer and through a copy of the previous bookkeeping (ordered multi-index
+ * containers and a map, checked every RetxTimer regardless of outstanding Interests).
+ *
+ *     ./waf --run "ndn-consumer-retx-benchmark --windows=10,1000,100000"
+ */
+
+namespace ndn {
+
+/**
+ * @brief Consumer without network, driven directly by the benchmark
+ */
+class BenchmarkConsumer : public Consumer {
+public:
+  void
+  Send(uint32_t seq)
+  {
+    WillSendOutInterest(seq);
+  }
+
+  void
+  Ack(uint32_t seq)
+  {
+    SatisfySeq(seq, 0);
+  }
+
+protected:
+  virtual void
+  ScheduleNextPacket()
+  {
+  }
+};
+
+/**
+ * @brief Previous bookkeeping of ndn::Consumer
+ */
+class LegacyBookkeeping {
+public:
+  LegacyBookkeeping()
+    : m_rtt(CreateObject<RttMeanDeviation>())
+    , m_retxTimer(MilliSeconds(50))
+  {
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &LegacyBookkeeping::CheckRetxTimeout, this);
+  }
+
+  ~LegacyBookkeeping()
+  {
+    m_retxEvent.Cancel();
+  }
+
+  void
+  Send(uint32_t seq)
+  {
+    m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
+    m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
+
+    m_seqLastDelay.erase(seq);
+    m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
+
+    m_seqRetxCounts[seq]++;
+
+    m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  }
+
+  void
+  Ack(uint32_t seq)
+  {
+    SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
+    if (entry != m_seqLastDelay.end()) {
+      m_lastDelay(nullptr, seq, Simulator::Now() - entry->time, 0);
+    }
+
+    entry = m_seqFullDelay.find(seq);
+    if (entry != m_seqFullDelay.end()) {
+      m_firstDelay(nullptr, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], 0);
+    }
+
+    m_seqRetxCounts.erase(seq);
+    m_seqFullDelay.erase(seq);
+    m_seqLastDelay.erase(seq);
+
+    m_seqTimeouts.erase(seq);
+    m_retxSeqs.erase(seq);
+
+    m_rtt->AckSeq(SequenceNumber32(seq));
+  }
+
+private:
+  void
+  CheckRetxTimeout()
+  {
+    Time now = Simulator::Now();
+    Time rto = m_rtt->RetransmitTimeout();
+
+    while (!m_seqTimeouts.empty()) {
+      auto entry = m_seqTimeouts.get<i_timestamp>().begin();
+      if (entry->time + rto <= now) {
+        uint32_t seqNo = entry->seq;
+        m_seqTimeouts.get<i_timestamp>().erase(entry);
+        m_rtt->IncreaseMultiplier();
+        m_rtt->SentSeq(SequenceNumber32(seqNo), 1);
+        m_retxSeqs.insert(seqNo);
+      }
+      else
+        break;
+    }
+
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &LegacyBookkeeping::CheckRetxTimeout, this);
+  }
+
+private:
+  struct SeqTimeout {
+    SeqTimeout(uint32_t _seq, Time _time)
+      : seq(_seq)
+      , time(_time)
+    {
+    }
+
+    uint32_t seq;
+    Time time;
+  };
+
+  class i_seq {
+  };
+  class i_timestamp {
+  };
+
+  typedef boost::multi_index::multi_index_container<
+    SeqTimeout,
+    boost::multi_index::indexed_by<
+      boost::multi_index::ordered_unique<
+        boost::multi_index::tag<i_seq>,
+        boost::multi_index::member<SeqTimeout, uint32_t, &SeqTimeout::seq>>,
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<i_timestamp>,
+        boost::multi_index::member<SeqTimeout, Time, &SeqTimeout::time>>>> SeqTimeoutsContainer;
+
+  Ptr<RttEstimator> m_rtt;
+  Time m_retxTimer;
+  EventId m_retxEvent;
+
+  std::set<uint32_t> m_retxSeqs;
+  SeqTimeoutsContainer m_seqTimeouts;
+  SeqTimeoutsContainer m_seqLastDelay;
+  SeqTimeoutsContainer m_seqFullDelay;
+  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+
+  TracedCallback<Ptr<App>, uint32_t, Time, int32_t> m_lastDelay;
+  TracedCallback<Ptr<App>, uint32_t, Time, uint32_t, int32_t> m_firstDelay;
+};
+
+/**
+ * @brief Sends and acknowledges Interests, keeping @p window of them outstanding
+ */
+template<class Bookkeeping>
+class WindowDriver {
+public:
+  WindowDriver(Bookkeeping& bookkeeping, uint32_t window, uint32_t nInterests, uint32_t batch)
+    : m_bookkeeping(bookkeeping)
+    , m_window(window)
+    , m_nInterests(nInterests)
+    , m_batch(batch)
+    , m_seq(0)
+  {
+  }
+
+  void
+  Step()
+  {
+    for (uint32_t i = 0; i < m_batch && m_seq < m_nInterests; i++, m_seq++) {
+      m_bookkeeping.Send(m_seq);
+      if (m_seq >= m_window) {
+        m_bookkeeping.Ack(m_seq - m_window);
+      }
+    }
+
+    if (m_seq < m_nInterests) {
+      Simulator::Schedule(MilliSeconds(1), &WindowDriver::Step, this);
+    }
+    else {
+      for (uint32_t seq = m_seq > m_window ? m_seq - m_window : 0; seq < m_seq; seq++) {
+        m_bookkeeping.Ack(seq);
+      }
+      Simulator::Stop();
+    }
+  }
+
+private:
+  Bookkeeping& m_bookkeeping;
+  uint32_t m_window;
+  uint32_t m_nInterests;
+  uint32_t m_batch;
+  uint32_t m_seq;
+};
+
+template<class Bookkeeping>
+static double
+run(Bookkeeping& bookkeeping, uint32_t window, uint32_t nInterests, uint32_t batch)
+{
+  WindowDriver<Bookkeeping> driver(bookkeeping, window, nInterests, batch);
+  Simulator::ScheduleNow(&WindowDriver<Bookkeeping>::Step, &driver);
+
+  double start = getRealTime();
+  Simulator::Run();
+  double time = getRealTime() - start;
+
+  Simulator::Destroy();
+  return time;
+}
+
+} // namespace ndn
+
+int
+main(int argc, char* argv[])
+{
+  std::string windows = "10,1000,100000";
+  uint32_t nInterests = 1000000;
+  uint32_t batch = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue("windows", "Comma-separated list of window sizes", windows);
+  cmd.AddValue("interests", "Number of Interests per window size", nInterests);
+  cmd.AddValue("batch", "Number of Interests sent per millisecond", batch);
+  cmd.Parse(argc, argv);
+
+  std::cout << "window\tconsumer(ns/Interest)\tlegacy(ns/Interest)\n";
+
+  std::istringstream is(windows);
+  std::string window;
+  while (std::getline(is, window, ',')) {
+    uint32_t size = boost::lexical_cast<uint32_t>(window);
+
+    double consumerTime = 0;
+    {
+      Ptr<ndn::BenchmarkConsumer> consumer = CreateObject<ndn::BenchmarkConsumer>();
+      consumerTime = ndn::run(*consumer, size, nInterests, batch);
+    }
+
+    double legacyTime = 0;
+    {
+      ndn::LegacyBookkeeping legacy;
+      legacyTime = ndn::run(legacy, size, nInterests, batch);
+    }
+
+    std::cout << size << "\t" << consumerTime * 1e9 / nInterests << "\t"
+              << legacyTime * 1e9 / nInterests << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Throughput and memory of the old-style content store implementations.
+ *
+ * Fills a content store (--cs, e.g., ns3::ndn::cs::Lru or ns3::ndn::cs::Hashed::Lru) with
+ * --entries Data packets named /prefix/<producer>/<segment>, then looks up every name (hits),
+ * names that are not in the store (misses) and producer prefixes (prefix hits), and finally
+ * inserts the same number of new names into the full store (insertions with eviction).  Reports
+ * operations per second for every phase and resident memory added per entry by the store (Data
+ * packets are created before the measurement).
+ *
+ *     ./waf --run "ndn-cs-benchmark --cs=ns3::ndn::cs::Lru --entries=1000000"
+ *     ./waf --run "ndn-cs-benchmark --cs=ns3::ndn::cs::Hashed::Lru --entries=1000000"
+ */
+
+static ndn::Name
+makeName(uint32_t producer, uint64_t segment)
+{
+  return ndn::Name("/prefix").append(std::to_string(producer)).appendSegment(segment);
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string csType = "ns3::ndn::cs::Hashed::Lru";
+  uint32_t nEntries = 100000;
+  uint32_t nProducers = 100;
+
+  CommandLine cmd;
+  cmd.AddValue("cs", "Content store type", csType);
+  cmd.AddValue("entries", "Number of entries in the content store", nEntries);
+  cmd.AddValue("producers", "Number of distinct name prefixes", nProducers);
+  cmd.Parse(argc, argv);
+
+  std::vector<shared_ptr<ndn::Data>> data;
+  std::vector<shared_ptr<ndn::Interest>> hits;
+  std::vector<shared_ptr<ndn::Interest>> misses;
+  data.reserve(2 * nEntries);
+  for (uint64_t i = 0; i < 2 * nEntries; i++) {
+    data.push_back(make_shared<ndn::Data>(makeName(i % nProducers, i)));
+  }
+  for (uint64_t i = 0; i < nEntries; i++) {
+    hits.push_back(make_shared<ndn::Interest>(data[i]->getName()));
+    misses.push_back(make_shared<ndn::Interest>(makeName(i % nProducers, 2 * nEntries + i)));
+    misses.back()->setCanBePrefix(false);
+  }
+
+  ObjectFactory factory(csType);
+  factory.Set("MaxSize", UintegerValue(nEntries));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+  int64_t beforeInsert = MemUsage::Get();
+  double start = getRealTime();
+  for (uint32_t i = 0; i < nEntries; i++) {
+    cs->Add(data[i]);
+  }
+  double insertTime = getRealTime() - start;
+  int64_t afterInsert = MemUsage::Get();
+
+  uint32_t nHits = 0;
+  start = getRealTime();
+  for (const auto& interest : hits) {
+    nHits += cs->Lookup(interest) != nullptr;
+  }
+  double hitTime = getRealTime() - start;
+
+  uint32_t nMisses = 0;
+  start = getRealTime();
+  for (const auto& interest : misses) {
+    nMisses += cs->Lookup(interest) == nullptr;
+  }
+  double missTime = getRealTime() - start;
+
+  uint32_t nPrefixHits = 0;
+  start = getRealTime();
+  for (uint32_t i = 0; i < nEntries; i++) {
+    ndn::Name prefix = ndn::Name("/prefix").append(std::to_string(i % nProducers));
+    auto interest = make_shared<ndn::Interest>(prefix);
+    nPrefixHits += cs->Lookup(interest) != nullptr;
+  }
+  double prefixTime = getRealTime() - start;
+
+  start = getRealTime();
+  for (uint32_t i = nEntries; i < 2 * nEntries; i++) {
+    cs->Add(data[i]);
+  }
+  double evictTime = getRealTime() - start;
+
+  std::cout << csType << " with " << nEntries << " entries:\n"
+            << "  insert:         " << nEntries / insertTime << " ops/s\n"
+            << "  lookup hit:     " << nEntries / hitTime << " ops/s (" << nHits << " hits)\n"
+            << "  lookup miss:    " << nEntries / missTime << " ops/s (" << nMisses << " misses)\n"
+            << "  prefix lookup:  " << nEntries / prefixTime << " ops/s (" << nPrefixHits
+            << " hits)\n"
+            << "  insert + evict: " << nEntries / evictTime << " ops/s (" << cs->GetSize()
+            << " entries)\n"
+            << "  memory:         " << double(afterInsert - beforeInsert) / nEntries
+            << " bytes per entry\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-policy-eval.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * Trace-driven comparison of content store replacement policies.
+ *
+ * Replays a request trace against every content store of --policies: each request is looked
+ * up in the store and, on a miss, the Data is added to the store.  Reports the object hit
+ * ratio and the byte hit ratio (bytes served from the cache / bytes requested) of every store.
+ *
+ * The trace (--trace) has one request per line: Data name and content size in bytes, e.g.,
+ * "/video/1/%00%05 8192".  Without a trace, --requests requests for --objects objects with
+ * Zipf (--alpha) popularity and log-uniform content sizes between --min-size and --max-size are
+ * generated.
+ *
+ * Stores with the MaxBytes attribute (ns3::ndn::cs::Sized::*) are limited to --cache-bytes
+ * bytes; other stores are limited to the same number of bytes divided by the mean Data size.
+ *
+ *     ./waf --run "ndn-cs-policy-eval --cache-bytes=4000000 --alpha=0.8"
+ *     ./waf --run "ndn-cs-policy-eval --trace=requests.txt --policies=ns3::ndn::cs::Sized::Gdsf"
+ */
+
+static shared_ptr<ndn::Data>
+makeData(const ndn::Name& name, size_t contentSize)
+{
+  auto data = make_shared<ndn::Data>(name);
+  data->setContent(make_shared< ::ndn::Buffer>(contentSize));
+
+  ndn::Signature signature;
+  ndn::SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+  data->wireEncode();
+  return data;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string traceFile;
+  std::string policies = "ns3::ndn::cs::Lru,ns3::ndn::cs::Lfu,ns3::ndn::cs::Fifo,"
+                         "ns3::ndn::cs::Random,ns3::ndn::cs::Sized::Gdsf,ns3::ndn::cs::Sized::Arc,"
+                         "ns3::ndn::cs::Sized::TinyLfu,ns3::ndn::cs::Sized::S3Fifo";
+  uint64_t cacheBytes = 4000000;
+  uint32_t nRequests = 200000;
+  uint32_t nObjects = 10000;
+  double alpha = 0.8;
+  uint32_t minSize = 100;
+  uint32_t maxSize = 10000;
+  uint32_t seed = 1;
+
+  CommandLine cmd;
+  cmd.AddValue("trace", "Request trace (name and content size per line)", traceFile);
+  cmd.AddValue("policies", "Comma-separated content store types", policies);
+  cmd.AddValue("cache-bytes", "Capacity of the content stores in bytes", cacheBytes);
+  cmd.AddValue("requests", "Number of generated requests", nRequests);
+  cmd.AddValue("objects", "Number of generated objects", nObjects);
+  cmd.AddValue("alpha", "Zipf exponent of generated popularity", alpha);
+  cmd.AddValue("min-size", "Minimum generated content size", minSize);
+  cmd.AddValue("max-size", "Maximum generated content size", maxSize);
+  cmd.AddValue("seed", "Seed of the generated trace", seed);
+  cmd.Parse(argc, argv);
+
+  std::vector<shared_ptr<ndn::Data>> objects;
+  std::vector<uint32_t> requests;
+
+  if (!traceFile.empty()) {
+    std::ifstream is(traceFile);
+    if (!is) {
+      std::cerr << "Cannot open " << traceFile << std::endl;
+      return 1;
+    }
+
+    std::unordered_map<std::string, uint32_t> index;
+    std::string name;
+    size_t size;
+    while (is >> name >> size) {
+      auto object = index.insert(std::make_pair(name, objects.size()));
+      if (object.second) {
+        objects.push_back(makeData(ndn::Name(name), size));
+      }
+      requests.push_back(object.first->second);
+    }
+  }
+  else {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<double> cdf(nObjects);
+    double sum = 0;
+    for (uint32_t i = 0; i < nObjects; i++) {
+      sum += 1.0 / std::pow(i + 1, alpha);
+      cdf[i] = sum;
+    }
+
+    for (uint32_t i = 0; i < nObjects; i++) {
+      double size = minSize * std::pow(static_cast<double>(maxSize) / minSize, uniform(random));
+      objects.push_back(makeData(ndn::Name("/object").appendNumber(i), size));
+    }
+
+    for (uint32_t i = 0; i < nRequests; i++) {
+      double point = uniform(random) * sum;
+      requests.push_back(std::lower_bound(cdf.begin(), cdf.end(), point) - cdf.begin());
+    }
+  }
+
+  if (requests.empty()) {
+    std::cerr << "No requests" << std::endl;
+    return 1;
+  }
+
+  std::vector<shared_ptr<ndn::Interest>> interests;
+  uint64_t totalBytes = 0;
+  for (const auto& data : objects) {
+    interests.push_back(make_shared<ndn::Interest>(data->getName()));
+    interests.back()->setCanBePrefix(false);
+    totalBytes += data->wireEncode().size();
+  }
+  uint64_t meanSize = std::max<uint64_t>(totalBytes / objects.size(), 1);
+
+  std::cout << requests.size() << " requests for " << objects.size() << " objects ("
+            << totalBytes << " bytes), cache of " << cacheBytes << " bytes\n\n"
+            << std::left << std::setw(34) << "Policy" << std::setw(12) << "Hit ratio"
+            << std::setw(12) << "Byte hit" << std::setw(12) << "Entries" << "Bytes\n";
+
+  std::vector<std::string> csTypes;
+  boost::split(csTypes, policies, boost::is_any_of(","));
+  for (const std::string& csType : csTypes) {
+    TypeId::AttributeInformation info;
+    ObjectFactory factory(csType);
+    if (factory.GetTypeId().LookupAttributeByName("MaxBytes", &info)) {
+      factory.Set("MaxSize", UintegerValue(0));
+      factory.Set("MaxBytes", UintegerValue(cacheBytes));
+    }
+    else {
+      factory.Set("MaxSize", UintegerValue(cacheBytes / meanSize));
+    }
+    Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+    uint64_t hits = 0;
+    uint64_t requestedBytes = 0;
+    uint64_t hitBytes = 0;
+    for (uint32_t object : requests) {
+      size_t size = objects[object]->wireEncode().size();
+      requestedBytes += size;
+      if (cs->Lookup(interests[object]) != nullptr) {
+        hits++;
+        hitBytes += size;
+      }
+      else {
+        cs->Add(objects[object]);
+      }
+    }
+
+    uint64_t cachedBytes = 0;
+    for (Ptr<ndn::cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+      cachedBytes += entry->GetData()->wireEncode().size();
+    }
+
+    std::cout << std::left << std::setw(34) << csType << std::setw(12)
+              << static_cast<double>(hits) / requests.size() << std::setw(12)
+              << static_cast<double>(hitBytes) / requestedBytes << std::setw(12) << cs->GetSize()
+              << cachedBytes << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fib-load-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Cost of installing precomputed routes into FIB at startup.
+ *
+ * Installs --prefixes routes on every node of a grid (32x32 = 1024 nodes by default, use
+ * --grid=100 for 10000 nodes), spreading the prefixes over the faces of the node, either one by
+ * one with FibHelper::AddRoute (--method=command; on regular stacks every route is a FIB
+ * management command) or per node with FibHelper::AddRoutes (--method=bulk), and reports
+ * wall-clock installation time in total and per route.
+ *
+ *     ./waf --run "ndn-fib-load-benchmark --grid=32 --prefixes=100 --method=bulk"
+ *     ./waf --run "ndn-fib-load-benchmark --grid=100 --prefixes=100 --method=bulk --lightweight=1"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t gridSize = 32;
+  uint32_t nPrefixes = 100;
+  std::string method = "bulk";
+  bool isLightweight = false;
+
+  CommandLine cmd;
+  cmd.AddValue("grid", "Grid size (grid x grid nodes)", gridSize);
+  cmd.AddValue("prefixes", "Number of prefixes installed on every node", nPrefixes);
+  cmd.AddValue("method", "Route installation method: command or bulk", method);
+  cmd.AddValue("lightweight", "Install lightweight NDN stacks", isLightweight);
+  cmd.Parse(argc, argv);
+
+  if (method != "command" && method != "bulk") {
+    std::cerr << "Unknown method " << method << ", expected command or bulk\n";
+    return 1;
+  }
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+  uint32_t nNodes = gridSize * gridSize;
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setLightweight(isLightweight);
+  ndnHelper.InstallAll();
+
+  std::vector<ndn::Name> prefixes;
+  for (uint32_t i = 0; i < nPrefixes; i++) {
+    prefixes.push_back(ndn::Name("/benchmark/site" + std::to_string(i % 100) + "/prefix" + std::to_string(i)));
+  }
+
+  // faces to p2p neighbors, collected before timing
+  std::vector<std::vector<shared_ptr<ndn::Face>>> faces(nNodes);
+  for (uint32_t i = 0; i < nNodes; i++) {
+    Ptr<ndn::L3Protocol> ndn = NodeList::GetNode(i)->GetObject<ndn::L3Protocol>();
+    for (uint32_t deviceId = 0; deviceId < NodeList::GetNode(i)->GetNDevices(); deviceId++) {
+      shared_ptr<ndn::Face> face = ndn->getFaceByNetDevice(NodeList::GetNode(i)->GetDevice(deviceId));
+      if (face != nullptr) {
+        faces[i].push_back(face);
+      }
+    }
+  }
+
+  double start = getRealTime();
+  std::vector<ndn::FibHelper::Route> routes;
+  for (uint32_t i = 0; i < nNodes; i++) {
+    Ptr<Node> node = NodeList::GetNode(i);
+    if (method == "command") {
+      for (uint32_t j = 0; j < nPrefixes; j++) {
+        ndn::FibHelper::AddRoute(node, prefixes[j], faces[i][j % faces[i].size()], 1);
+      }
+    }
+    else {
+      routes.clear();
+      for (uint32_t j = 0; j < nPrefixes; j++) {
+        routes.push_back({&prefixes[j], faces[i][j % faces[i].size()].get(), 1});
+      }
+      ndn::FibHelper::AddRoutes(node, routes);
+    }
+  }
+  // let management process the queued commands
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  double installTime = getRealTime() - start;
+
+  uint64_t nEntries = 0;
+  for (uint32_t i = 0; i < nNodes; i++) {
+    nEntries += NodeList::GetNode(i)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib().size();
+  }
+
+  uint64_t nRoutes = static_cast<uint64_t>(nNodes) * nPrefixes;
+  std::cout << (isLightweight ? "Lightweight" : "Regular") << " stack on " << nNodes << " nodes, "
+            << nRoutes << " routes with " << method << ": " << installTime << " s, "
+            << installTime / nRoutes * 1e6 << " us per route (" << nEntries << " FIB entries)\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-node-memory.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Per-node memory of the NDN stack, with and without StackHelper::setLightweight.
+ *
+ * Installs the stack on a grid (100x100 = 10000 nodes by default), computes global routes for
+ * a few prefixes, and reports resident memory (MemUsage) added per node by the NDN stack and by
+ * the routes.  A short ConsumerCbr/Producer run checks that the lightweight nodes forward.
+ *
+ *     ./waf --run "ndn-node-memory --grid=100 --lightweight=1"
+ */
+
+static uint64_t g_received = 0;
+
+static void
+countReceived(shared_ptr<const ::ndn::Data>, Ptr<ndn::App>, shared_ptr<nfd::Face>)
+{
+  g_received++;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t gridSize = 100;
+  uint32_t nPairs = 4;
+  bool isLightweight = false;
+  double simulationTime = 1;
+
+  CommandLine cmd;
+  cmd.AddValue("grid", "Grid size (grid x grid nodes)", gridSize);
+  cmd.AddValue("pairs", "Number of consumer/producer pairs", nPairs);
+  cmd.AddValue("lightweight", "Install lightweight NDN stacks", isLightweight);
+  cmd.AddValue("sim-time", "Simulated time in seconds", simulationTime);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+  uint32_t nNodes = gridSize * gridSize;
+
+  int64_t beforeStack = MemUsage::Get();
+  double start = getRealTime();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setLightweight(isLightweight);
+  ndnHelper.InstallAll();
+
+  double installTime = getRealTime() - start;
+  int64_t afterStack = MemUsage::Get();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  for (uint32_t i = 0; i < nPairs; i++) {
+    std::string prefix = "/prefix" + std::to_string(i);
+    Ptr<Node> consumer = grid.GetNode(rand->GetInteger(0, gridSize - 1), rand->GetInteger(0, gridSize - 1));
+    Ptr<Node> producer = grid.GetNode(rand->GetInteger(0, gridSize - 1), rand->GetInteger(0, gridSize - 1));
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", DoubleValue(10));
+    consumerHelper.Install(consumer);
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.Install(producer);
+
+    ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  }
+
+  start = getRealTime();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  double routingTime = getRealTime() - start;
+  int64_t afterRoutes = MemUsage::Get();
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerCbr/ReceivedDatas",
+                                MakeCallback(&countReceived));
+
+  Simulator::Stop(Seconds(simulationTime));
+  Simulator::Run();
+
+  std::cout << (isLightweight ? "Lightweight" : "Regular") << " stack on " << nNodes << " nodes:\n"
+            << "  stack:  " << (afterStack - beforeStack) / nNodes << " bytes per node, installed in "
+            << installTime << " s\n"
+            << "  routes: " << (afterRoutes - afterStack) / nNodes << " bytes per node, computed in "
+            << routingTime << " s\n"
+            << "  total:  " << afterRoutes / 1024.0 / 1024.0 << " MiB resident\n"
+            << "  Data received by consumers: " << g_received << "\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
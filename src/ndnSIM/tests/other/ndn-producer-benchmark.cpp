@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-producer-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+#include "ns3/ndnSIM/utils/ndn-virtual-payload.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Data packets per second that a producer creates on one core.
+ *
+ * Part 1 creates Data with a fake signature for different names, once encoding all fields
+ * (as Producer did before DataTemplate) and once from a DataTemplate.
+ *
+ * Part 2 runs a ConsumerZipfMandelbrot and a producer application on a single node with a
+ * one-packet Content Store, so every Interest reaches the producer, and reports Data per
+ * second of wall-clock time for Producer and ProducerHighRate.
+ *
+ *     ./waf --run "ndn-producer-benchmark --packets=1000000 --payload=1024"
+ */
+
+static void
+benchmarkEncoding(uint32_t payloadSize, uint32_t nPackets)
+{
+  ::ndn::ConstBufferPtr content = ndn::VirtualPayload::GetBuffer(payloadSize);
+  ndn::Name keyLocator("/producer/key");
+
+  std::vector<ndn::Name> names;
+  for (uint32_t i = 0; i < 1024; i++) {
+    names.push_back(ndn::Name("/benchmark/prefix").appendSequenceNumber(i));
+  }
+
+  size_t checksum = 0;
+  double start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    auto data = ndn::DataTemplate::Encode(names[i % names.size()], ::ndn::time::seconds(1),
+                                          content, 0, keyLocator);
+    checksum += data->wireEncode().size();
+  }
+  double encode = (getRealTime() - start) / nPackets;
+
+  ndn::DataTemplate dataTemplate(::ndn::time::seconds(1), content, 0, keyLocator);
+  start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    auto data = dataTemplate.Make(names[i % names.size()]);
+    checksum += data->wireEncode().size();
+  }
+  double make = (getRealTime() - start) / nPackets;
+
+  std::cout << "Payload " << payloadSize << " bytes: encode " << encode * 1e9 << " ns ("
+            << 1 / encode << " Data/s), template " << make * 1e9 << " ns (" << 1 / make
+            << " Data/s), checksum " << checksum << "\n";
+}
+
+static uint64_t g_transmitted = 0;
+
+static void
+countData(shared_ptr<const ndn::Data>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+{
+  g_transmitted++;
+}
+
+static void
+benchmarkApp(const std::string& producerApp, uint32_t payloadSize, uint32_t nContents,
+             double frequency, double simulationTime)
+{
+  NodeContainer nodes;
+  nodes.Create(1);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(1);
+  ndnHelper.Install(nodes);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.SetAttribute("NumberOfContents", UintegerValue(nContents));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper(producerApp);
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(payloadSize));
+  producerHelper.Install(nodes.Get(0));
+
+  g_transmitted = 0;
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::App/TransmittedDatas",
+                                MakeCallback(&countData));
+
+  Simulator::Stop(Seconds(simulationTime));
+
+  double start = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - start;
+
+  std::cout << producerApp << ": " << g_transmitted << " Data in " << realTime << " s, "
+            << g_transmitted / realTime << " Data/s\n";
+
+  Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nPackets = 1000000;
+  uint32_t payloadSize = 1024;
+  uint32_t nContents = 1000;
+  double frequency = 100000;
+  double simulationTime = 2;
+
+  CommandLine cmd;
+  cmd.AddValue("packets", "Number of Data created in the encoding benchmark", nPackets);
+  cmd.AddValue("payload", "Payload size of Data", payloadSize);
+  cmd.AddValue("contents", "Number of different names requested by the consumer", nContents);
+  cmd.AddValue("frequency", "Interests per second sent by the consumer", frequency);
+  cmd.AddValue("sim-time", "Simulated time of the application benchmark in seconds",
+               simulationTime);
+  cmd.Parse(argc, argv);
+
+  // Part 1
+  benchmarkEncoding(0, nPackets);
+  benchmarkEncoding(payloadSize, nPackets);
+
+  // Part 2
+  benchmarkApp("ns3::ndn::Producer", payloadSize, nContents, frequency, simulationTime);
+  benchmarkApp("ns3::ndn::ProducerHighRate", payloadSize, nContents, frequency, simulationTime);
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-transport-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/transport.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Per-packet cost of moving NDN packets between NFD and ns-3 NetDevices.
+ *
+ * Part 1 encodes Interests and 1024-byte Data packets into ns3::Packet with ndn::BlockHeader and
+ * decodes them again, once with the current BlockHeader path and once with the previous one
+ * (packet copy + byte-by-byte boost::iostreams decoding), which is kept here as reference.
+ * It also encodes them with BlockHeader::CreatePacket, which keeps the zero-filled payload of
+ * Data in the zero area of the ns-3 packet, and decodes the result.
+ *
+ * Part 2 runs ConsumerCbr/Producer pairs on a grid (32x32 = 1024 nodes by default) and reports
+ * wall-clock time per link-level packet reception.
+ *
+ *     ./waf --run "ndn-transport-benchmark --grid=32 --packets=100000"
+ */
+
+namespace io = boost::iostreams;
+
+class LegacyIteratorSource : public io::source {
+public:
+  LegacyIteratorSource(Buffer::Iterator& is)
+    : m_is(is)
+  {
+  }
+
+  std::streamsize
+  read(char* buf, std::streamsize nMaxRead)
+  {
+    std::streamsize i = 0;
+    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
+      buf[i] = m_is.ReadU8();
+    }
+    return i == 0 ? -1 : i;
+  }
+
+private:
+  Buffer::Iterator& m_is;
+};
+
+class LegacyBlockHeader : public Header {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::LegacyBlockHeader").SetParent<Header>();
+    return tid;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const
+  {
+    return m_block.size();
+  }
+
+  virtual void
+  Serialize(Buffer::Iterator start) const
+  {
+    start.Write(m_block.wire(), m_block.size());
+  }
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start)
+  {
+    io::stream<LegacyIteratorSource> is(start);
+    m_block = ::ndn::Block::fromStream(is);
+    return m_block.size();
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+  }
+
+  ::ndn::Block m_block;
+};
+
+static void
+benchmarkBlockHeader(const std::string& name, const ::ndn::Block& wire, uint32_t nPackets)
+{
+  ndn::BlockHeader header{nfd::face::Transport::Packet(::ndn::Block(wire))};
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(header);
+  Ptr<const Packet> received = packet;
+
+  size_t checksum = 0;
+  double start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    ndn::BlockHeader decoded;
+    received->PeekHeader(decoded);
+    checksum += decoded.getBlock().size();
+  }
+  double current = (getRealTime() - start) / nPackets;
+
+  start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    Ptr<Packet> copy = received->Copy();
+    LegacyBlockHeader decoded;
+    copy->RemoveHeader(decoded);
+    checksum += decoded.m_block.size();
+  }
+  double legacy = (getRealTime() - start) / nPackets;
+
+  start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    ndn::BlockHeader encoded{nfd::face::Transport::Packet(::ndn::Block(wire))};
+    Ptr<Packet> p = Create<Packet>();
+    p->AddHeader(encoded);
+    checksum += p->GetSize();
+  }
+  double encode = (getRealTime() - start) / nPackets;
+
+  start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    Ptr<Packet> p =
+      ndn::BlockHeader::CreatePacket(nfd::face::Transport::Packet(::ndn::Block(wire)));
+    checksum += p->GetSize();
+  }
+  double encodeVirtual = (getRealTime() - start) / nPackets;
+
+  Ptr<const Packet> receivedVirtual =
+    ndn::BlockHeader::CreatePacket(nfd::face::Transport::Packet(::ndn::Block(wire)));
+  start = getRealTime();
+  for (uint32_t i = 0; i < nPackets; i++) {
+    ndn::BlockHeader decoded;
+    receivedVirtual->PeekHeader(decoded);
+    checksum += decoded.getBlock().size();
+  }
+  double decodeVirtual = (getRealTime() - start) / nPackets;
+
+  std::cout << name << " (" << wire.size() << " bytes): decode " << current * 1e9 << " ns, legacy decode "
+            << legacy * 1e9 << " ns, encode " << encode * 1e9 << " ns (checksum " << checksum
+            << ")\n"
+            << "  CreatePacket: encode " << encodeVirtual * 1e9 << " ns, decode "
+            << decodeVirtual * 1e9 << " ns, " << receivedVirtual->GetSerializedSize()
+            << " bytes serialized ns-3 packet\n";
+}
+
+static uint64_t g_received = 0;
+
+static void
+countRx(Ptr<const Packet>)
+{
+  g_received++;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t gridSize = 32;
+  uint32_t nPackets = 100000;
+  uint32_t nPairs = 20;
+  double frequency = 100;
+  double simulationTime = 10;
+
+  CommandLine cmd;
+  cmd.AddValue("grid", "Grid size (grid x grid nodes)", gridSize);
+  cmd.AddValue("packets", "Number of packets for the BlockHeader micro benchmark", nPackets);
+  cmd.AddValue("pairs", "Number of consumer/producer pairs in the grid scenario", nPairs);
+  cmd.AddValue("frequency", "Interests per second sent by each consumer", frequency);
+  cmd.AddValue("sim-time", "Simulated time of the grid scenario in seconds", simulationTime);
+  cmd.Parse(argc, argv);
+
+  // Part 1
+  ::ndn::Interest interest("/benchmark/prefix/interest");
+  interest.setNonce(1);
+  benchmarkBlockHeader("Interest", ::ndn::lp::Packet(interest.wireEncode()).wireEncode(), nPackets);
+
+  ::ndn::Data data("/benchmark/prefix/data");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  benchmarkBlockHeader("Data", ::ndn::lp::Packet(data.wireEncode()).wireEncode(), nPackets);
+
+  // Part 2
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+  for (uint32_t i = 0; i < nPairs; i++) {
+    std::string prefix = "/prefix" + std::to_string(i);
+    Ptr<Node> consumer = grid.GetNode(rand->GetInteger(0, gridSize - 1), rand->GetInteger(0, gridSize - 1));
+    Ptr<Node> producer = grid.GetNode(rand->GetInteger(0, gridSize - 1), rand->GetInteger(0, gridSize - 1));
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+    consumerHelper.Install(consumer);
+
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix);
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producer);
+
+    ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  }
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/MacRx",
+                                MakeCallback(&countRx));
+
+  Simulator::Stop(Seconds(simulationTime));
+
+  double start = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - start;
+
+  std::cout << "Grid " << gridSize << "x" << gridSize << ": " << g_received << " packets received in "
+            << realTime << " s, " << (g_received ? realTime / g_received * 1e6 : 0) << " us per packet\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-zipf-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-table.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include "ndn-benchmark-common.hpp"
+
+namespace ns3 {
+
+/**
+ * Speed and memory of Zipf-Mandelbrot content selection of ConsumerZipfMandelbrot.
+ *
+ * Builds the alias table for --contents contents and draws --samples ranks from it, draws
+ * --scan-samples ranks with a linear scan of the cumulative distribution (the previous
+ * implementation) for comparison, and checks the frequencies of the most popular ranks.  Then
+ * creates --consumers ConsumerZipfMandelbrot applications with the same parameters and reports
+ * memory per application (the table is shared).
+ *
+ *     ./waf --run "ndn-zipf-benchmark --contents=1000000 --consumers=1000"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nContents = 1000000;
+  uint32_t nSamples = 10000000;
+  uint32_t nScanSamples = 1000;
+  uint32_t nConsumers = 1000;
+  double q = 0.7;
+  double s = 0.7;
+
+  CommandLine cmd;
+  cmd.AddValue("contents", "Number of contents", nContents);
+  cmd.AddValue("samples", "Number of ranks drawn from the alias table", nSamples);
+  cmd.AddValue("scan-samples", "Number of ranks drawn by linear scan", nScanSamples);
+  cmd.AddValue("consumers", "Number of consumer applications", nConsumers);
+  cmd.AddValue("q", "Parameter q of the distribution", q);
+  cmd.AddValue("s", "Parameter s of the distribution", s);
+  cmd.Parse(argc, argv);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+
+  double start = getRealTime();
+  auto table = ndn::ZipfMandelbrotTable::Get(nContents, q, s);
+  double buildTime = getRealTime() - start;
+
+  const uint32_t nTop = 10;
+  std::vector<uint64_t> topCounts(nTop + 1);
+  uint64_t checksum = 0;
+  start = getRealTime();
+  for (uint32_t i = 0; i < nSamples; i++) {
+    uint32_t rank = table->Sample(random->GetValue());
+    checksum += rank;
+    if (rank <= nTop) {
+      topCounts[rank]++;
+    }
+  }
+  double sampleTime = getRealTime() - start;
+
+  double maxError = 0;
+  for (uint32_t rank = 1; rank <= nTop; rank++) {
+    double expected = table->GetProbability(rank);
+    double error = std::abs(static_cast<double>(topCounts[rank]) / nSamples - expected) / expected;
+    maxError = std::max(maxError, error);
+  }
+
+  // previous implementation: cumulative distribution, linear scan for every sample
+  std::vector<double> cdf(nContents + 1);
+  for (uint32_t i = 1; i <= nContents; i++) {
+    cdf[i] = cdf[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+  for (uint32_t i = 1; i <= nContents; i++) {
+    cdf[i] /= cdf[nContents];
+  }
+  start = getRealTime();
+  for (uint32_t i = 0; i < nScanSamples; i++) {
+    double p = random->GetValue();
+    for (uint32_t rank = 1; rank <= nContents; rank++) {
+      if (p <= cdf[rank]) {
+        checksum += rank;
+        break;
+      }
+    }
+  }
+  double scanTime = getRealTime() - start;
+  cdf = std::vector<double>();
+
+  std::vector<Ptr<ndn::ConsumerZipfMandelbrot>> consumers;
+  int64_t beforeConsumers = MemUsage::Get();
+  start = getRealTime();
+  for (uint32_t i = 0; i < nConsumers; i++) {
+    Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot>();
+    consumer->SetAttribute("NumberOfContents", UintegerValue(nContents));
+    consumer->SetAttribute("q", DoubleValue(q));
+    consumer->SetAttribute("s", DoubleValue(s));
+    checksum += consumer->GetNextSeq();
+    consumers.push_back(consumer);
+  }
+  double consumersTime = getRealTime() - start;
+  int64_t afterConsumers = MemUsage::Get();
+
+  std::cout << nContents << " contents (q=" << q << ", s=" << s << "):\n"
+            << "  table build:   " << buildTime << " s\n"
+            << "  alias sample:  " << nSamples / sampleTime << " samples/s\n"
+            << "  linear scan:   " << nScanSamples / scanTime << " samples/s\n"
+            << "  top-" << nTop << " error: " << maxError * 100 << "% (max relative)\n"
+            << "  " << nConsumers << " consumers: " << consumersTime << " s, "
+            << double(afterConsumers - beforeConsumers) / nConsumers << " bytes per consumer\n"
+            << "  (checksum " << checksum << ")\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
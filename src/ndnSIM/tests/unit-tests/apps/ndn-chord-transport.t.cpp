@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-chord-transport.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ChordNdnTransportFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ChordNdnTransportFixture()
+    : nReceived(0)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", ChordNdnTransport::GetLocatorPrefix("/chord", Ipv4Address("10.0.0.2")), 1},
+      });
+
+    sender = CreateObject<ChordNdnTransport>();
+    sender->Start(getNode("1"), Ipv4Address("10.0.0.1"), 2000);
+
+    receiver = CreateObject<ChordNdnTransport>();
+    receiver->SetRecvCallback(MakeCallback(&ChordNdnTransportFixture::onReceive, this));
+    receiver->Start(getNode("2"), Ipv4Address("10.0.0.2"), 2000);
+  }
+
+  void
+  onReceive(Ptr<Packet> packet, Ipv4Address fromIp, uint16_t fromPort)
+  {
+    BOOST_CHECK_EQUAL(fromIp, Ipv4Address("10.0.0.1"));
+    BOOST_CHECK_EQUAL(fromPort, 2000);
+    nReceived++;
+  }
+
+  void
+  send(uint8_t byte)
+  {
+    // distinct content, otherwise the Interest is answered from the PIT/CS
+    std::vector<uint8_t> buffer(10, byte);
+    sender->Send(Create<Packet>(buffer.data(), buffer.size()), Ipv4Address("10.0.0.2"), 2000);
+  }
+
+  bool
+  hasEndpointRoute()
+  {
+    Name prefix = ChordNdnTransport::GetLocatorPrefix("/chord", Ipv4Address("10.0.0.2"));
+    prefix.appendNumber(2000);
+    return getNode("2")->GetObject<L3Protocol>()->getForwarder()->getFib().findExactMatch(prefix)
+           != nullptr;
+  }
+
+public:
+  Ptr<ChordNdnTransport> sender;
+  Ptr<ChordNdnTransport> receiver;
+  size_t nReceived;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnChordTransport, ChordNdnTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Deliver)
+{
+  Simulator::Schedule(Seconds(1), &ChordNdnTransportFixture::send, this, 1);
+  Simulator::Schedule(Seconds(2), &ChordNdnTransportFixture::send, this, 2);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nReceived, 2);
+  BOOST_CHECK_EQUAL(receiver->GetStats().rxMessages, 2);
+  BOOST_CHECK(hasEndpointRoute());
+}
+
+BOOST_AUTO_TEST_CASE(NoDeliveryAfterStop)
+{
+  Simulator::Schedule(Seconds(1), &ChordNdnTransportFixture::send, this, 1);
+  Simulator::Schedule(Seconds(1.5), &ChordNdnTransport::Stop, receiver);
+  Simulator::Schedule(Seconds(2), &ChordNdnTransportFixture::send, this, 2);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nReceived, 1);
+  BOOST_CHECK_EQUAL(receiver->GetStats().rxMessages, 1);
+  BOOST_CHECK(!hasEndpointRoute());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProducerFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    payloadSizes.push_back(data->getContent().value_size());
+    freshnessPeriods.push_back(data->getFreshnessPeriod().count());
+  }
+
+  void
+  setAttributes(const std::string& producerType)
+  {
+    Config::Set("/NodeList/*/ApplicationList/*/$" + producerType + "/PayloadSize",
+                UintegerValue(200));
+    Config::Set("/NodeList/*/ApplicationList/*/$" + producerType + "/Freshness",
+                TimeValue(Seconds(2)));
+  }
+
+  void
+  run(const std::string& producerType)
+  {
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0.5s", "100s"},
+        {"2", producerType,
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}, {"Freshness", "1s"}},
+            "0s", "100s"},
+      });
+
+    getNode("1")->GetApplication(0)->TraceConnectWithoutContext("ReceivedDatas",
+      MakeCallback(&ProducerFixture::onData, this));
+
+    // attributes changed while the producer is running apply to the following Data
+    Simulator::Schedule(Seconds(2), &ProducerFixture::setAttributes, this, producerType);
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+  }
+
+public:
+  std::vector<size_t> payloadSizes;
+  std::vector<int64_t> freshnessPeriods;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(AttributeChange)
+{
+  run("ns3::ndn::Producer");
+
+  BOOST_REQUIRE_EQUAL(payloadSizes.size(), 4);
+  BOOST_CHECK_EQUAL(payloadSizes[0], 100);
+  BOOST_CHECK_EQUAL(payloadSizes[1], 100);
+  BOOST_CHECK_EQUAL(payloadSizes[2], 200);
+  BOOST_CHECK_EQUAL(payloadSizes[3], 200);
+  BOOST_CHECK_EQUAL(freshnessPeriods[0], 1000);
+  BOOST_CHECK_EQUAL(freshnessPeriods[3], 2000);
+}
+
+BOOST_AUTO_TEST_CASE(HighRateAttributeChange)
+{
+  run("ns3::ndn::ProducerHighRate");
+
+  BOOST_REQUIRE_EQUAL(payloadSizes.size(), 4);
+  BOOST_CHECK_EQUAL(payloadSizes[0], 100);
+  BOOST_CHECK_EQUAL(payloadSizes[1], 100);
+  BOOST_CHECK_EQUAL(payloadSizes[2], 200);
+  BOOST_CHECK_EQUAL(payloadSizes[3], 200);
+  BOOST_CHECK_EQUAL(freshnessPeriods[0], 1000);
+  BOOST_CHECK_EQUAL(freshnessPeriods[3], 2000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,10 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +101,48 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  shared_ptr<Face> nullFace = nfd::face::makeNullFace();
+  getNode("1")->GetObject<L3Protocol>()->addFace(nullFace);
+  nfd::Fib& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  size_t nEntries = fib.size();
+
+  Name prefix("/prefix");
+  Name other("/other");
+  Name deep("/deep");
+  while (deep.size() <= nfd::Fib::getMaxDepth()) {
+    deep.append("component");
+  }
+  FibHelper::AddRoutes(getNode("1"), {{&prefix, getFace("1", "2").get(), 1},
+                                      {&prefix, nullFace.get(), 3},
+                                      {&deep, getFace("1", "2").get(), 1},
+                                      {&deep, nullFace.get(), 1},
+                                      {&other, getFace("1", "2").get(), 2}});
+
+  BOOST_CHECK_EQUAL(fib.size(), nEntries + 2);
+
+  nfd::fib::Entry* entry = fib.findExactMatch(prefix);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  // next hops are sorted by cost
+  BOOST_CHECK_EQUAL(&entry->getNextHops()[0].getFace(), getFace("1", "2").get());
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 1);
+  BOOST_CHECK_EQUAL(&entry->getNextHops()[1].getFace(), nullFace.get());
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 3);
+
+  entry = fib.findExactMatch(other);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(&entry->getNextHops().front().getFace(), getFace("1", "2").get());
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 2);
+
+  // prefixes deeper than Fib::getMaxDepth are skipped
+  BOOST_CHECK(fib.findExactMatch(deep) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
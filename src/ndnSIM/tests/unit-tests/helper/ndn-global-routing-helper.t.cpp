@@ -19,6 +19,7 @@
 
 #include "helper/ndn-global-routing-helper.hpp"
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -190,6 +191,126 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+static std::set<std::string>
+getNextHopNodes(const std::string& nodeName, const Name& prefix)
+{
+  std::set<std::string> nextHops;
+  auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+  auto entry = ndn->getForwarder()->getFib().findExactMatch(prefix);
+  if (entry == nullptr)
+    return nextHops;
+
+  for (auto& nextHop : entry->getNextHops()) {
+    auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+    if (transport == nullptr)
+      continue;
+    auto channel = transport->GetNetDevice()->GetChannel();
+    auto otherNode = channel->GetDevice(0)->GetNode() == Names::Find<Node>(nodeName) ?
+                       channel->GetDevice(1)->GetNode() : channel->GetDevice(0)->GetNode();
+    nextHops.insert(Names::FindName(otherNode));
+  }
+  return nextHops;
+}
+
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    100 1ms 100\n"
+        << "A4      C4  10Mbps    500  1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndn::GlobalRoutingHelper::SetNumberOfThreads(2);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  ndn::GlobalRoutingHelper::SetNumberOfThreads(0);
+
+  BOOST_CHECK((getNextHopNodes("A4", "/prefix") == std::set<std::string>{"B4", "C4"}));
+
+  auto entry = Names::Find<Node>("A4")->GetObject<ndn::L3Protocol>()->getForwarder()
+                 ->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), 101);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].getCost(), 500);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalUpdates)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A5  NA  1 1 1\n"
+        << "B5  NA  80  -40 1\n"
+        << "C5  NA  80  40  1\n"
+        << "D5  NA  80  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A5      B5  10Mbps    100 1ms 100\n"
+        << "A5      C5  10Mbps    500  1ms 100\n"
+        << "B5      C5  10Mbps    1 1ms 100\n"
+        << "C5      D5  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C5"));
+  ndnGlobalRoutingHelper.AddOrigins("/other", Names::Find<Node>("D5"));
+
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  BOOST_CHECK((getNextHopNodes("A5", "/prefix") == std::set<std::string>{"B5"}));
+  BOOST_CHECK((getNextHopNodes("B5", "/prefix") == std::set<std::string>{"C5"}));
+  BOOST_CHECK((getNextHopNodes("D5", "/prefix") == std::set<std::string>{"C5"}));
+
+  LinkControlHelper::FailLinkByName("A5", "B5");
+  BOOST_CHECK((getNextHopNodes("A5", "/prefix") == std::set<std::string>{"C5"}));
+  BOOST_CHECK((getNextHopNodes("A5", "/other") == std::set<std::string>{"C5"}));
+  BOOST_CHECK((getNextHopNodes("B5", "/prefix") == std::set<std::string>{"C5"}));
+
+  LinkControlHelper::FailLinkByName("B5", "C5");
+  BOOST_CHECK(getNextHopNodes("B5", "/prefix").empty());
+  BOOST_CHECK(getNextHopNodes("B5", "/other").empty());
+
+  LinkControlHelper::UpLinkByName("A5", "B5");
+  LinkControlHelper::UpLinkByName("B5", "C5");
+  BOOST_CHECK((getNextHopNodes("A5", "/prefix") == std::set<std::string>{"B5"}));
+  BOOST_CHECK((getNextHopNodes("A5", "/other") == std::set<std::string>{"B5"}));
+  BOOST_CHECK((getNextHopNodes("B5", "/prefix") == std::set<std::string>{"C5"}));
+
+  ndn::GlobalRoutingHelper::EnableIncrementalUpdates(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
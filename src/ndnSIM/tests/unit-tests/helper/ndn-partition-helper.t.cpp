@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-partition-helper.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnPartitionHelper, CleanupFixture)
+
+static void
+addCluster(PartitionHelper& partitioner, const std::string& prefix)
+{
+  for (int i = 0; i < 4; i++) {
+    partitioner.AddNode(prefix + std::to_string(i));
+  }
+  for (int i = 1; i < 4; i++) {
+    partitioner.AddLink(prefix + "0", prefix + std::to_string(i), MilliSeconds(1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Clusters)
+{
+  PartitionHelper partitioner;
+  addCluster(partitioner, "a");
+  addCluster(partitioner, "b");
+  partitioner.AddLink("a1", "b1", MilliSeconds(50));
+  partitioner.AddLink("a2", "b2", MilliSeconds(20));
+
+  partitioner.Partition(2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(20));
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 2);
+  for (int i = 1; i < 4; i++) {
+    BOOST_CHECK_EQUAL(partitioner.GetPartition("a" + std::to_string(i)),
+                      partitioner.GetPartition("a0"));
+    BOOST_CHECK_EQUAL(partitioner.GetPartition("b" + std::to_string(i)),
+                      partitioner.GetPartition("b0"));
+  }
+  BOOST_CHECK_NE(partitioner.GetPartition("a0"), partitioner.GetPartition("b0"));
+
+  // clusters cannot be split without cutting 1ms links
+  partitioner.Partition(4);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(1));
+  std::vector<double> weights = partitioner.GetWeights();
+  std::vector<double> expected(4, 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(weights.begin(), weights.end(), expected.begin(), expected.end());
+
+  partitioner.Partition(1);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), Time::Max());
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Balance)
+{
+  // chain of 8 nodes, one slow link in the middle of the first half
+  PartitionHelper partitioner;
+  for (int i = 0; i < 8; i++) {
+    partitioner.AddNode(std::to_string(i));
+  }
+  for (int i = 1; i < 8; i++) {
+    partitioner.AddLink(std::to_string(i - 1), std::to_string(i),
+                        i == 2 ? MilliSeconds(100) : MilliSeconds(10));
+  }
+
+  // 2 + 6 nodes is too unbalanced
+  partitioner.Partition(2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(10));
+  std::vector<double> weights = partitioner.GetWeights();
+  BOOST_CHECK_EQUAL(weights[0], 4);
+  BOOST_CHECK_EQUAL(weights[1], 4);
+
+  partitioner.SetImbalance(0.5);
+  partitioner.Partition(2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(100));
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 1);
+
+  // more partitions than nodes
+  PartitionHelper small;
+  small.AddNode("a");
+  small.AddNode("b");
+  small.AddLink("a", "b", MilliSeconds(1));
+  small.Partition(4);
+  BOOST_CHECK_NE(small.GetPartition("a"), small.GetPartition("b"));
+  BOOST_CHECK_LT(small.GetPartition("a"), 4);
+  BOOST_CHECK_LT(small.GetPartition("b"), 4);
+}
+
+BOOST_AUTO_TEST_CASE(TopologyReader)
+{
+  boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  boost::filesystem::path topology = boost::filesystem::path(TEST_CONFIG_PATH)
+                                     / "partitioned-topology.txt";
+  std::ofstream(topology.string().c_str())
+    << "router\n"
+    << "a0 NA 0 0 0\n" << "a1 NA 0 0 0\n" << "b0 NA 0 0 0\n" << "b1 NA 0 0 0\n"
+    << "link\n"
+    << "a0 a1 10Mbps 1 1ms 20\n"
+    << "b0 b1 10Mbps 1 1ms 20\n"
+    << "a1 b1 10Mbps 1 30ms 20\n"
+    << "a0 b0 10Mbps 1 40ms 20\n";
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(topology.string());
+  reader.SetPartitions(2);
+  reader.Read();
+  boost::filesystem::remove(topology);
+
+  BOOST_REQUIRE_EQUAL(reader.GetNodes().GetN(), 4);
+  BOOST_CHECK_EQUAL(Names::Find<Node>("a0")->GetSystemId(),
+                    Names::Find<Node>("a1")->GetSystemId());
+  BOOST_CHECK_EQUAL(Names::Find<Node>("b0")->GetSystemId(),
+                    Names::Find<Node>("b1")->GetSystemId());
+  BOOST_CHECK_NE(Names::Find<Node>("a0")->GetSystemId(), Names::Find<Node>("b0")->GetSystemId());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
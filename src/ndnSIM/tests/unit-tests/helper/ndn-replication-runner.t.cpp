@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-replication-runner.hpp"
+#include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-columnar-trace.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <map>
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const std::string DELAY_TRACE = (boost::filesystem::path(TEST_CONFIG_PATH) / "delay.txt").string();
+const std::string RATE_TRACE = (boost::filesystem::path(TEST_CONFIG_PATH) / "rate.bin").string();
+
+class ReplicationRunnerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ReplicationRunnerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    Simulator::Stop(Seconds(2));
+
+    runner.SetRuns(1, 3);
+    runner.SetJobs(2);
+    runner.AddTrace(DELAY_TRACE);
+  }
+
+  ~ReplicationRunnerFixture()
+  {
+    boost::filesystem::remove(DELAY_TRACE);
+    boost::filesystem::remove(RATE_TRACE);
+  }
+
+  void
+  setup(uint32_t run)
+  {
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"Randomize", "uniform"}},
+            "0s", "1s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+            "0s", "2s"}
+      });
+    AppDelayTracer::InstallAll(runner.GetTraceFile(DELAY_TRACE));
+  }
+
+  /**
+   * @brief Read send times of Interests in the merged delay trace, by run
+   */
+  std::map<uint32_t, std::vector<std::string>>
+  readDelayTrace()
+  {
+    std::map<uint32_t, std::vector<std::string>> times;
+    std::ifstream is(DELAY_TRACE.c_str());
+    std::string line;
+    std::getline(is, line);
+    BOOST_CHECK_EQUAL(line.substr(0, 14), "Run\tTime\tNode\t");
+    while (std::getline(is, line)) {
+      std::istringstream row(line);
+      uint32_t run;
+      std::string time;
+      row >> run >> time;
+      times[run].push_back(time);
+    }
+    return times;
+  }
+
+public:
+  ReplicationRunner runner;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnReplicationRunner, ReplicationRunnerFixture)
+
+BOOST_AUTO_TEST_CASE(TextTrace)
+{
+  BOOST_CHECK_EQUAL(runner.GetTraceFile(DELAY_TRACE), DELAY_TRACE);
+  BOOST_CHECK_EQUAL(runner.Run([this] (uint32_t run) { setup(run); }), 0);
+
+  auto times = readDelayTrace();
+  BOOST_REQUIRE_EQUAL(times.size(), 3);
+  BOOST_CHECK_EQUAL(times.begin()->first, 1);
+  for (const auto& run : times) {
+    BOOST_CHECK_GT(run.second.size(), 0);
+    BOOST_CHECK(!boost::filesystem::exists(boost::filesystem::path(TEST_CONFIG_PATH)
+                                           / ("delay.run-" + std::to_string(run.first) + ".txt")));
+  }
+  // every run has its own random Interest times
+  BOOST_CHECK(times[1] != times[2]);
+  BOOST_CHECK(times[2] != times[3]);
+
+  // replications of the same run are identical
+  runner.SetRuns(2, 1);
+  BOOST_CHECK_EQUAL(runner.Run([this] (uint32_t run) { setup(run); }), 0);
+  BOOST_CHECK(readDelayTrace()[2] == times[2]);
+}
+
+BOOST_AUTO_TEST_CASE(ColumnarTrace)
+{
+  runner.AddTrace(RATE_TRACE);
+  BOOST_CHECK_EQUAL(runner.Run([this] (uint32_t run) {
+        setup(run);
+        L3RateTracer::InstallAll(runner.GetTraceFile(RATE_TRACE), Seconds(0.5));
+      }), 0);
+
+  ColumnarTraceReader reader;
+  BOOST_REQUIRE(reader.Open(RATE_TRACE));
+  BOOST_CHECK_EQUAL(reader.GetTracer(), "L3RateTracer");
+  BOOST_CHECK_EQUAL(reader.GetColumns().at(0).name, "Run");
+  BOOST_CHECK_EQUAL(reader.GetColumns().at(1).name, "Time");
+
+  std::map<int64_t, size_t> rows;
+  while (reader.ReadBlock()) {
+    for (size_t row = 0; row < reader.GetRowCount(); row++) {
+      rows[reader.GetInt(0, row)]++;
+    }
+  }
+  BOOST_REQUIRE_EQUAL(rows.size(), 3);
+  BOOST_CHECK_EQUAL(rows[1], rows[2]);
+  BOOST_CHECK_EQUAL(rows[1], rows[3]);
+}
+
+BOOST_AUTO_TEST_CASE(FailedReplication)
+{
+  BOOST_CHECK_EQUAL(runner.Run([this] (uint32_t run) {
+        if (run == 2) {
+          throw std::runtime_error("replication failure");
+        }
+        setup(run);
+      }), 1);
+
+  std::set<uint32_t> runs;
+  for (const auto& run : readDelayTrace()) {
+    runs.insert(run.first);
+  }
+  std::set<uint32_t> expected{1, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(runs.begin(), runs.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
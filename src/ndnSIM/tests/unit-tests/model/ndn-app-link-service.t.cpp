@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-link-service.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-fib-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+// Replies to the first Interest from OnInterest and closes its face before the reply is passed
+// to NFD
+class StoppingProducer : public App
+{
+public:
+  StoppingProducer()
+    : nInterests(0)
+  {
+  }
+
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest) override
+  {
+    App::OnInterest(interest);
+    if (!m_active)
+      return;
+
+    nInterests++;
+
+    auto data = make_shared<Data>(interest->getName());
+    Signature signature;
+    signature.setInfo(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+
+    m_transmittedDatas(data, this, m_face);
+    m_appLink->onReceiveData(*data); // queued, NFD is delivering the Interest
+    StopApplication();
+  }
+
+protected:
+  virtual void
+  StartApplication() override
+  {
+    App::StartApplication();
+    FibHelper::AddRoute(GetNode(), "/stop", m_face, 0);
+  }
+
+public:
+  size_t nInterests;
+};
+
+class AppLinkServiceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  onData(shared_ptr<const Data>, Ptr<App> app, shared_ptr<Face>)
+  {
+    nReceivedDatas[app->GetNode()->GetId()][app->GetId()]++;
+  }
+
+  void
+  run(const std::string& directDispatch)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/remote", 1},
+      });
+
+    addApps({
+        // producer on the same node
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/local"}, {"Frequency", "10"}, {"DirectDispatch", directDispatch}},
+            "0s", "100s"},
+        {"1", "ns3::ndn::Producer",
+            {{"Prefix", "/local"}, {"DirectDispatch", directDispatch}},
+            "0s", "100s"},
+        // consumers sending Interests from OnData and requesting the same Data
+        {"1", "ns3::ndn::ConsumerWindow",
+            {{"Prefix", "/remote"}, {"Window", "4"}, {"MaxSeq", "200"},
+             {"DirectDispatch", directDispatch}},
+            "0s", "100s"},
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/remote"}, {"Frequency", "10"}, {"DirectDispatch", directDispatch}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/remote"}, {"DirectDispatch", directDispatch}},
+            "0s", "100s"},
+      });
+
+    for (uint32_t i = 0; i < getNode("1")->GetNApplications(); i++) {
+      getNode("1")->GetApplication(i)->TraceConnectWithoutContext("ReceivedDatas",
+        MakeCallback(&AppLinkServiceFixture::onData, this));
+    }
+
+    Simulator::Stop(Seconds(2.05));
+    Simulator::Run();
+  }
+
+public:
+  std::map<uint32_t, std::map<uint32_t, uint32_t>> nReceivedDatas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppLinkService, AppLinkServiceFixture)
+
+BOOST_AUTO_TEST_CASE(Scheduled)
+{
+  run("false");
+
+  // the first Interest of /local is sent before the producer starts
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][0], 20);
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][2], 142);
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][3], 21);
+}
+
+BOOST_AUTO_TEST_CASE(DirectDispatch)
+{
+  run("true");
+
+  // same as with scheduled delivery
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][0], 20);
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][2], 142);
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][3], 21);
+}
+
+BOOST_AUTO_TEST_CASE(ClosedFace)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  Ptr<StoppingProducer> producer = CreateObject<StoppingProducer>();
+  producer->SetAttribute("DirectDispatch", BooleanValue(true));
+  getNode("1")->AddApplication(producer);
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/stop"}, {"Frequency", "10"}, {"DirectDispatch", "true"}},
+          "0.1s", "100s"},
+    });
+  getNode("1")->GetApplication(1)->TraceConnectWithoutContext("ReceivedDatas",
+    MakeCallback(&AppLinkServiceFixture::onData, this));
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // Data queued before the face was closed is dropped
+  BOOST_CHECK_EQUAL(producer->nInterests, 1);
+  BOOST_CHECK_EQUAL(nReceivedDatas[0][1], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
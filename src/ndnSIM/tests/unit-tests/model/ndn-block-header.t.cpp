@@ -19,6 +19,7 @@
 
 #include "model/ndn-block-header.hpp"
 #include "helper/ndn-stack-helper.hpp"
+#include "utils/ndn-virtual-payload.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 
@@ -87,6 +88,61 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DecodeFromPacket)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  BlockHeader header(nfd::face::Transport::Packet(lpPacket.wireEncode()));
+
+  // trailing bytes (e.g., link layer padding) must not be consumed
+  Ptr<Packet> packet = Create<Packet>(20);
+  packet->AddHeader(header);
+
+  BlockHeader decoded;
+  BOOST_CHECK_EQUAL(packet->PeekHeader(decoded), header.GetSerializedSize());
+  BOOST_CHECK(decoded.getBlock() == header.getBlock());
+  BOOST_CHECK_EQUAL(packet->GetSize(), header.GetSerializedSize() + 20);
+
+  Ptr<Packet> truncated = packet->CreateFragment(0, header.GetSerializedSize() - 1);
+  BOOST_CHECK_THROW(truncated->PeekHeader(decoded), ::ndn::tlv::Error);
+
+  Ptr<Packet> tooShort = packet->CreateFragment(0, 2);
+  BOOST_CHECK_THROW(tooShort->PeekHeader(decoded), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(CreatePacketWithVirtualPayload)
+{
+  Data data("/other/prefix");
+  data.setContent(VirtualPayload::GetBuffer(4096));
+  ndn::StackHelper::getKeyChain().sign(data);
+  Block wire = lp::Packet(data.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = BlockHeader::CreatePacket(nfd::face::Transport::Packet(Block(wire)));
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+  BOOST_CHECK_LT(packet->GetSerializedSize(), 1024); // payload is not stored
+
+  {
+    boost::test_tools::output_test_stream output;
+    packet->Print(output);
+    BOOST_CHECK(output.is_equal("ns3::ndn::Packet (Data: /other/prefix) "
+                                "Payload (size=4096) ns3::ndn::PacketTrailer (end of block)"));
+  }
+
+  BlockHeader decoded;
+  BOOST_CHECK_EQUAL(packet->PeekHeader(decoded), wire.size());
+  BOOST_CHECK(decoded.getBlock() == wire);
+
+  // other packets are carried by a single BlockHeader
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  packet = BlockHeader::CreatePacket(nfd::face::Transport::Packet(Block(interest.wireEncode())));
+  BOOST_CHECK_EQUAL(packet->GetSize(), interest.wireEncode().size());
+  packet->PeekHeader(decoded);
+  BOOST_CHECK(decoded.getBlock() == interest.wireEncode());
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
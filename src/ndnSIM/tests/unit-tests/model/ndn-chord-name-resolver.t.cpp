@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-chord-name-resolver.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "apps/ndn-chord-transport.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-chord-resolver-helper.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+
+#include "ns3/chord-ipv4.h"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ChordNameResolverFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ChordNameResolverFixture()
+    : nResolved(0)
+    , nFailed(0)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+      });
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+
+    // router virtual nodes at 0x00.., 0x40.. and 0xc0..; "/prefix" (0xb3..) is registered on
+    // node 3, "/nothing" (0x1a..) is not registered and its successor lives on node 2
+    const char* nodes[] = {"1", "2", "3"};
+    uint8_t routerKeys[] = {0x00, 0x40, 0xc0};
+    for (int i = 0; i < 3; i++) {
+      Ipv4Address localIp(0x0a010001 + i);
+
+      AppHelper chordHelper("ns3::ChordIpv4");
+      chordHelper.SetAttribute("BootStrapIp", Ipv4AddressValue(Ipv4Address(0x0a010001)));
+      chordHelper.SetAttribute("BootStrapPort", UintegerValue(2000));
+      chordHelper.SetAttribute("LocalIpAddress", Ipv4AddressValue(localIp));
+      chordHelper.SetAttribute("ListeningPort", UintegerValue(2000));
+      chordHelper.SetAttribute("ApplicationPort", UintegerValue(2001));
+      chordHelper.SetAttribute("Transport", TypeIdValue(ChordNdnTransport::GetTypeId()));
+      chordHelper.Install(getNode(nodes[i]));
+
+      routingHelper.AddOrigin(ChordNdnTransport::GetLocatorPrefix("/chord", localIp).toUri(),
+                              getNode(nodes[i]));
+
+      Simulator::ScheduleWithContext(getNode(nodes[i])->GetId(), Seconds(1.0 + i),
+                                     &ChordNameResolverFixture::insertRouter, this,
+                                     getNode(nodes[i]), routerKeys[i]);
+    }
+
+    ChordResolverHelper resolverHelper;
+    resolverHelper.InstallAll();
+    ChordResolverHelper::RegisterPrefix(getNode("3"), "/prefix", Seconds(5.0));
+
+    GlobalRoutingHelper::CalculateRoutes();
+  }
+
+  void
+  insertRouter(Ptr<Node> node, uint8_t firstByte)
+  {
+    uint8_t key[20] = {0};
+    key[0] = firstByte;
+    node->GetApplication(0)->GetObject<ChordIpv4>()->InsertVNode("router", key, sizeof(key));
+  }
+
+  void
+  resolve(const Name& name)
+  {
+    getNode("1")->GetObject<ChordNameResolver>()->Resolve(name,
+      [this] (const Name& prefix, bool isResolved) {
+        if (isResolved)
+          nResolved++;
+        else
+          nFailed++;
+      });
+  }
+
+  bool
+  hasFibEntry(const Name& prefix)
+  {
+    return getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib().findExactMatch(prefix)
+           != nullptr;
+  }
+
+public:
+  size_t nResolved;
+  size_t nFailed;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnChordNameResolver, ChordNameResolverFixture)
+
+BOOST_AUTO_TEST_CASE(Registered)
+{
+  Simulator::Schedule(Seconds(20), &ChordNameResolverFixture::resolve, this, "/prefix/1");
+
+  Simulator::Stop(Seconds(25));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nResolved, 1);
+  BOOST_CHECK_EQUAL(nFailed, 0);
+  BOOST_CHECK(hasFibEntry("/prefix"));
+
+  auto resolver = getNode("1")->GetObject<ChordNameResolver>();
+  BOOST_CHECK(resolver->IsResolved("/prefix/2"));
+  BOOST_CHECK_EQUAL(resolver->GetStats().lookups, 1);
+  BOOST_CHECK_EQUAL(resolver->GetStats().resolved, 1);
+  BOOST_CHECK_EQUAL(resolver->GetStats().failures, 0);
+}
+
+BOOST_AUTO_TEST_CASE(NotRegistered)
+{
+  Simulator::Schedule(Seconds(20), &ChordNameResolverFixture::resolve, this, "/nothing/1");
+
+  Simulator::Stop(Seconds(25));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nResolved, 0);
+  BOOST_CHECK_EQUAL(nFailed, 1);
+  BOOST_CHECK(!hasFibEntry("/nothing"));
+
+  auto resolver = getNode("1")->GetObject<ChordNameResolver>();
+  BOOST_CHECK(!resolver->IsResolved("/nothing/2"));
+  BOOST_CHECK_EQUAL(resolver->GetStats().lookups, 1);
+  BOOST_CHECK_EQUAL(resolver->GetStats().resolved, 0);
+  BOOST_CHECK_EQUAL(resolver->GetStats().failures, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
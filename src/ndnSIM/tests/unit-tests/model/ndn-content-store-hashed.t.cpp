@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/content-store-hashed.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ContentStoreHashedFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  static Ptr<ContentStore>
+  createStore(const std::string& policy, uint32_t maxSize)
+  {
+    ObjectFactory factory("ns3::ndn::cs::Hashed::" + policy);
+    factory.Set("MaxSize", UintegerValue(maxSize));
+    return factory.Create<ContentStore>();
+  }
+
+  static shared_ptr<Interest>
+  makeInterest(const Name& name, bool canBePrefix = true)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setCanBePrefix(canBePrefix);
+    return interest;
+  }
+
+  static Name
+  lookupName(Ptr<ContentStore> cs, shared_ptr<const Interest> interest)
+  {
+    shared_ptr<Data> data = cs->Lookup(interest);
+    return data == nullptr ? Name("/miss") : data->getName();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnContentStoreHashed, ContentStoreHashedFixture)
+
+BOOST_AUTO_TEST_CASE(TableFind)
+{
+  // one node stored with two hashes that start probing at the same slot
+  int node = 0;
+  cs::HashedCsTable<int> table;
+  table.insert(1, &node);
+  table.insert(table.capacity() + 1, &node);
+
+  size_t position = table.find(table.capacity() + 1, &node);
+  BOOST_CHECK_EQUAL(table[position].hash, table.capacity() + 1);
+  table.erase(position);
+  BOOST_CHECK_EQUAL(table[table.find(1, &node)].hash, 1);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ExactAndPrefixLookup)
+{
+  Ptr<ContentStore> cs = createStore("Lru", 100);
+  BOOST_CHECK(cs->Add(make_shared<Data>("/a/b/1")));
+  BOOST_CHECK(cs->Add(make_shared<Data>("/a/b/2")));
+  BOOST_CHECK(cs->Add(make_shared<Data>("/a/c/1")));
+  BOOST_CHECK(!cs->Add(make_shared<Data>("/a/b/1")));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 3);
+
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/b/1")), Name("/a/b/1"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/b/1", false)), Name("/a/b/1"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/b/3")), Name("/miss"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/b", false)), Name("/miss"));
+  BOOST_CHECK(Name("/a/b").isPrefixOf(lookupName(cs, makeInterest("/a/b"))));
+  BOOST_CHECK(Name("/a").isPrefixOf(lookupName(cs, makeInterest("/"))));
+
+  auto excludeB = makeInterest("/a");
+  excludeB->setExclude(Exclude().excludeOne(name::Component("b")));
+  BOOST_CHECK_EQUAL(lookupName(cs, excludeB), Name("/a/c/1"));
+
+  // with Exclude, only Data with longer names match (as in the trie-based store)
+  auto excludeOther = makeInterest("/a/c/1");
+  excludeOther->setExclude(Exclude().excludeOne(name::Component("x")));
+  BOOST_CHECK_EQUAL(lookupName(cs, excludeOther), Name("/miss"));
+
+  size_t nEntries = 0;
+  for (Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+    nEntries++;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 3);
+}
+
+BOOST_AUTO_TEST_CASE(LruEviction)
+{
+  Ptr<ContentStore> cs = createStore("Lru", 2);
+  cs->Add(make_shared<Data>("/a/1"));
+  cs->Add(make_shared<Data>("/a/2"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/1")), Name("/a/1"));
+  cs->Add(make_shared<Data>("/a/3"));
+
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/2")), Name("/miss"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/1")), Name("/a/1"));
+  BOOST_CHECK_EQUAL(lookupName(cs, makeInterest("/a/3")), Name("/a/3"));
+
+  auto excludeFirst = makeInterest("/a");
+  excludeFirst->setExclude(Exclude().excludeOne(name::Component("1")));
+  BOOST_CHECK_EQUAL(lookupName(cs, excludeFirst), Name("/a/3"));
+}
+
+BOOST_AUTO_TEST_CASE(FifoAgainstModel)
+{
+  const uint32_t maxSize = 1000;
+  Ptr<ContentStore> cs = createStore("Fifo", maxSize);
+
+  // FIFO store holds the last maxSize inserted names
+  for (int i = 0; i < 10000; i++) {
+    cs->Add(make_shared<Data>(Name("/prefix").append(std::to_string(i % 50)).appendSegment(i)));
+  }
+  BOOST_CHECK_EQUAL(cs->GetSize(), maxSize);
+
+  int nHits = 0;
+  for (int i = 0; i < 10000; i++) {
+    Name name = Name("/prefix").append(std::to_string(i % 50)).appendSegment(i);
+    bool isHit = lookupName(cs, makeInterest(name, false)) == name;
+    BOOST_CHECK_EQUAL(isHit, i >= 10000 - static_cast<int>(maxSize));
+    nHits += isHit;
+  }
+  BOOST_CHECK_EQUAL(nHits, maxSize);
+
+  // every prefix still has entries under it
+  for (int i = 0; i < 50; i++) {
+    Name prefix = Name("/prefix").append(std::to_string(i));
+    BOOST_CHECK(prefix.isPrefixOf(lookupName(cs, makeInterest(prefix))));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RandomAndLfuEvictListHeads)
+{
+  std::vector<Name> prefixes = {"/", "/p"};
+  for (int a = 0; a < 7; a++) {
+    prefixes.push_back(Name("/p").append(std::to_string(a)));
+    for (int b = 0; b < 3; b++) {
+      prefixes.push_back(Name("/p").append(std::to_string(a)).append(std::to_string(b)));
+    }
+  }
+
+  // newest entry heads the lists of all its prefixes, so both policies often evict list heads
+  for (const std::string& policy : {"Random", "Lfu"}) {
+    Ptr<ContentStore> cs = createStore(policy, 20);
+
+    for (int i = 0; i < 2000; i++) {
+      cs->Add(make_shared<Data>(Name("/p")
+                                  .append(std::to_string(i % 7))
+                                  .append(std::to_string(i % 3))
+                                  .appendSegment(i)));
+
+      std::set<Name> names;
+      for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+        names.insert(it->GetName());
+      }
+      BOOST_REQUIRE_EQUAL(names.size(), std::min(i + 1, 20));
+
+      for (const Name& prefix : prefixes) {
+        bool isCached = std::any_of(names.begin(), names.end(), [&prefix](const Name& name) {
+          return prefix.isPrefixOf(name);
+        });
+
+        Name found = lookupName(cs, makeInterest(prefix));
+        if (isCached) {
+          BOOST_CHECK_MESSAGE(names.count(found) > 0 && prefix.isPrefixOf(found),
+                              policy << ": " << prefix << " -> " << found);
+        }
+        else {
+          BOOST_CHECK_MESSAGE(found == Name("/miss"), policy << ": " << prefix << " -> " << found);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InStack)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Hashed::Lru", "MaxSize", "10");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  for (const std::string& node : {"1", "2"}) {
+    auto cs = getNode(node)->GetObject<ContentStore>();
+    BOOST_CHECK_EQUAL(cs->GetSize(), 10);
+
+    std::set<Name> names;
+    for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+      names.insert(it->GetName());
+      BOOST_CHECK(cs->Lookup(make_shared<Interest>(it->GetName())) != nullptr);
+    }
+    BOOST_CHECK_EQUAL(names.size(), 10);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/content-store-sized.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ContentStoreSizedFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  static Ptr<ContentStore>
+  createStore(const std::string& policy, uint32_t maxSize, uint64_t maxBytes)
+  {
+    ObjectFactory factory("ns3::ndn::cs::Sized::" + policy);
+    factory.Set("MaxSize", UintegerValue(maxSize));
+    factory.Set("MaxBytes", UintegerValue(maxBytes));
+    return factory.Create<ContentStore>();
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, size_t contentSize)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(make_shared< ::ndn::Buffer>(contentSize));
+    return data;
+  }
+
+  static bool
+  isCached(Ptr<ContentStore> cs, const Name& name)
+  {
+    shared_ptr<Data> data = cs->Lookup(make_shared<Interest>(name));
+    return data != nullptr && data->getName() == name;
+  }
+
+  static size_t
+  getCachedBytes(Ptr<ContentStore> cs)
+  {
+    size_t bytes = 0;
+    for (Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+      const Data& data = *entry->GetData();
+      bytes += data.hasWire() ? data.wireEncode().size() : data.getContent().value_size();
+    }
+    return bytes;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnContentStoreSized, ContentStoreSizedFixture)
+
+BOOST_AUTO_TEST_CASE(ByteLimit)
+{
+  for (const std::string& policy : {"Gdsf", "Arc", "TinyLfu", "S3Fifo"}) {
+    BOOST_TEST_MESSAGE(policy);
+    Ptr<ContentStore> cs = createStore(policy, 0, 10000);
+
+    for (int i = 0; i < 50; i++) {
+      cs->Add(makeData(Name("/a").appendNumber(i), 1000));
+      BOOST_CHECK_LE(getCachedBytes(cs), 10000);
+    }
+    BOOST_CHECK_EQUAL(cs->GetSize(), 10);
+
+    BOOST_CHECK(!cs->Add(makeData("/too-large", 10001)));
+    BOOST_CHECK_EQUAL(cs->GetSize(), 10);
+    BOOST_CHECK(!isCached(cs, "/too-large"));
+
+    // both limits are enforced
+    Ptr<ContentStore> small = createStore(policy, 3, 10000);
+    for (int i = 0; i < 50; i++) {
+      small->Add(makeData(Name("/a").appendNumber(i), 100));
+    }
+    BOOST_CHECK_EQUAL(small->GetSize(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GdsfPrefersSmallData)
+{
+  Ptr<ContentStore> cs = createStore("Gdsf", 0, 10000);
+  cs->Add(makeData("/large", 6000));
+  for (int i = 0; i < 4; i++) {
+    cs->Add(makeData(Name("/small").appendNumber(i), 1000));
+  }
+  BOOST_CHECK_EQUAL(cs->GetSize(), 5);
+
+  // large Data has the lowest frequency / size, even though it is not the oldest entry
+  BOOST_CHECK(isCached(cs, "/large"));
+  cs->Add(makeData("/small/new", 1000));
+
+  BOOST_CHECK(!isCached(cs, "/large"));
+  BOOST_CHECK(isCached(cs, "/small/new"));
+  for (int i = 0; i < 4; i++) {
+    BOOST_CHECK(isCached(cs, Name("/small").appendNumber(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TinyLfuAdmission)
+{
+  Ptr<ContentStore> cs = createStore("TinyLfu", 2, 0);
+  BOOST_CHECK(cs->Add(makeData("/a", 100)));
+  BOOST_CHECK(cs->Add(makeData("/b", 100)));
+  for (int i = 0; i < 3; i++) {
+    BOOST_CHECK(isCached(cs, "/a"));
+    BOOST_CHECK(isCached(cs, "/b"));
+  }
+
+  // /c was requested less often than the LRU entry
+  BOOST_CHECK(!cs->Add(makeData("/c", 100)));
+  BOOST_CHECK(!isCached(cs, "/c"));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+
+  // once requested more often, /c replaces the LRU entry
+  for (int i = 0; i < 4; i++) {
+    cs->Add(makeData("/c", 100));
+  }
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  for (const std::string& policy : {"Arc", "TinyLfu", "S3Fifo"}) {
+    BOOST_TEST_MESSAGE(policy);
+    Ptr<ContentStore> cs = createStore(policy, 10, 0);
+
+    for (int i = 0; i < 5; i++) {
+      cs->Add(makeData(Name("/hot").appendNumber(i), 100));
+    }
+    for (int i = 0; i < 5; i++) {
+      BOOST_CHECK(isCached(cs, Name("/hot").appendNumber(i)));
+      BOOST_CHECK(isCached(cs, Name("/hot").appendNumber(i)));
+    }
+
+    // Data requested only once does not push out Data requested several times
+    for (int i = 0; i < 100; i++) {
+      cs->Add(makeData(Name("/scan").appendNumber(i), 100));
+    }
+    BOOST_CHECK_LE(cs->GetSize(), 10);
+    for (int i = 0; i < 5; i++) {
+      BOOST_CHECK(isCached(cs, Name("/hot").appendNumber(i)));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(S3FifoGhostReadmission)
+{
+  Ptr<ContentStore> cs = createStore("S3Fifo", 10, 0);
+  for (int i = 0; i < 15; i++) {
+    cs->Add(makeData(Name("/a").appendNumber(i), 100));
+  }
+  BOOST_CHECK(!isCached(cs, Name("/a").appendNumber(0)));
+
+  // /a/0 is remembered in the ghost queue and enters the main queue, where it survives a scan
+  // that passes through the small queue
+  cs->Add(makeData(Name("/a").appendNumber(0), 100));
+  BOOST_CHECK(isCached(cs, Name("/a").appendNumber(0)));
+  for (int i = 0; i < 5; i++) {
+    cs->Add(makeData(Name("/scan").appendNumber(i), 100));
+  }
+  BOOST_CHECK(isCached(cs, Name("/a").appendNumber(0)));
+}
+
+BOOST_AUTO_TEST_CASE(InStack)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Sized::S3Fifo", "MaxSize", "0",
+                                      "MaxBytes", "5000");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  for (const std::string& node : {"1", "2"}) {
+    auto cs = getNode(node)->GetObject<ContentStore>();
+    BOOST_CHECK_LE(getCachedBytes(cs), 5000);
+
+    // only four ~1060-byte Data packets fit, besides small local management Data
+    size_t nPrefixEntries = 0;
+    for (Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+      nPrefixEntries += Name("/prefix").isPrefixOf(entry->GetName());
+    }
+    BOOST_CHECK_EQUAL(nPrefixEntries, 4);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -19,6 +19,10 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "NFD/daemon/fw/strategy.hpp"
 
 #include <ndn-cxx/face.hpp>
 
@@ -149,8 +153,51 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
                                 receivedDatasets.begin(), receivedDatasets.end());
 }
 
+BOOST_AUTO_TEST_CASE(Lightweight)
+{
+  getStackHelper().setLightweight();
+
+  setupAndRun();
+
+  // no management plane, no /localhost/nfd FIB entry, no dataset can be received
+  BOOST_CHECK_EQUAL(receivedDatasets.size(), 0);
+  BOOST_CHECK(!getNode("1")->GetObject<L3Protocol>()->hasManagement());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+BOOST_AUTO_TEST_CASE(LightweightTables)
+{
+  getStackHelper().setLightweight();
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  StrategyChoiceHelper::Install(getNode("1"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  Ptr<L3Protocol> ndn = getNode("1")->GetObject<L3Protocol>();
+  BOOST_CHECK(!ndn->hasManagement());
+
+  auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK(Name("/localhost/nfd/strategy/multicast")
+                .isPrefixOf(ndn->getForwarder()->getStrategyChoice()
+                            .findEffectiveStrategy("/prefix").getInstanceName()));
+
+  FibHelper::RemoveRoute(getNode("1"), "/prefix", entry->getNextHops().front().getFace().getId());
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/prefix") == nullptr);
+
+  // management plane is created on demand
+  BOOST_CHECK(ndn->getFibManager() != nullptr);
+  BOOST_CHECK(ndn->hasManagement());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
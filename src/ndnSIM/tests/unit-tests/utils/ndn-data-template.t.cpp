@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+#include "utils/ndn-virtual-payload.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnDataTemplate)
+
+BOOST_AUTO_TEST_CASE(FakeSignature)
+{
+  ::ndn::ConstBufferPtr content = VirtualPayload::GetBuffer(1024);
+
+  for (const Name& keyLocator : {Name(), Name("/key/locator")}) {
+    DataTemplate dataTemplate(time::milliseconds(2000), content, 42, keyLocator);
+
+    for (const Name& name : {Name("/"), Name("/prefix/%FE%01"), Name("/a/long/name/of/data")}) {
+      shared_ptr<Data> data = dataTemplate.Make(name);
+      BOOST_REQUIRE(data->hasWire());
+      BOOST_CHECK_EQUAL(data->getName(), name);
+      BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), time::milliseconds(2000));
+      BOOST_CHECK_EQUAL(data->getContent().value_size(), 1024);
+      BOOST_CHECK_EQUAL(data->getSignature().getType(), 255);
+
+      shared_ptr<Data> expected = DataTemplate::Encode(name, time::milliseconds(2000), content,
+                                                       42, keyLocator);
+      BOOST_CHECK_EQUAL_COLLECTIONS(data->wireEncode().begin(), data->wireEncode().end(),
+                                    expected->wireEncode().begin(), expected->wireEncode().end());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Prototype)
+{
+  Data prototype("/prototype");
+  prototype.setContent(reinterpret_cast<const uint8_t*>("content"), 7);
+  StackHelper::getKeyChain().sign(prototype);
+
+  DataTemplate dataTemplate(prototype);
+  shared_ptr<Data> data = dataTemplate.Make("/other/name");
+  BOOST_CHECK_EQUAL(data->getName(), Name("/other/name"));
+  BOOST_CHECK(data->getContent() == prototype.getContent());
+  BOOST_CHECK(data->getSignature() == prototype.getSignature());
+  BOOST_CHECK_EQUAL(data->wireEncode().size() - data->getName().wireEncode().size(),
+                    prototype.wireEncode().size() - prototype.getName().wireEncode().size());
+  BOOST_CHECK_EQUAL(dataTemplate.GetSuffixSize(),
+                    prototype.wireEncode().value_size() - prototype.getName().wireEncode().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
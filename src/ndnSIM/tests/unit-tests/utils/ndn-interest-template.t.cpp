@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-interest-template.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnInterestTemplate)
+
+static void
+checkWireEqual(const Interest& interest, const Interest& expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(interest.wireEncode().begin(), interest.wireEncode().end(),
+                                expected.wireEncode().begin(), expected.wireEncode().end());
+}
+
+BOOST_AUTO_TEST_CASE(SequenceNumbers)
+{
+  Name prefix("/prefix/of/interests");
+  // 4s is the default lifetime, which is not encoded
+  for (int lifetime : {2000, 4000}) {
+    InterestTemplate interestTemplate(prefix, time::milliseconds(lifetime));
+
+    for (uint32_t seq : {0u, 255u, 256u, 65535u, 65536u, 4294967295u}) {
+      shared_ptr<Interest> interest = interestTemplate.Make(seq, 0x12345678);
+      BOOST_REQUIRE(interest->hasWire());
+      BOOST_CHECK_EQUAL(interest->getName(), Name(prefix).appendSequenceNumber(seq));
+      BOOST_CHECK_EQUAL(interest->getName().at(-1).toSequenceNumber(), seq);
+      BOOST_CHECK_EQUAL(interest->getNonce(), 0x12345678);
+      BOOST_CHECK_EQUAL(interest->getInterestLifetime(), time::milliseconds(lifetime));
+
+      checkWireEqual(*interest, *InterestTemplate::Encode(prefix, seq, 0x12345678,
+                                                          time::milliseconds(lifetime)));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Prototype)
+{
+  Interest prototype("/prototype");
+  prototype.setMustBeFresh(true);
+  prototype.setInterestLifetime(time::milliseconds(500));
+
+  InterestTemplate interestTemplate(prototype);
+  shared_ptr<Interest> interest = interestTemplate.Make(7, 42);
+
+  Interest expected(prototype);
+  expected.setName(Name("/prototype").appendSequenceNumber(7));
+  expected.setNonce(42);
+  checkWireEqual(*interest, expected);
+  BOOST_CHECK(interest->getMustBeFresh());
+}
+
+static void
+recordInterest(std::vector<shared_ptr<const Interest>>* interests,
+               shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+{
+  interests->push_back(interest);
+}
+
+static void
+setConsumerAttributes()
+{
+  Config::Set("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerCbr/Prefix",
+              StringValue("/other"));
+  Config::Set("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerCbr/LifeTime",
+              StringValue("1s"));
+}
+
+BOOST_FIXTURE_TEST_CASE(ConsumerAttributeChange, ScenarioHelperWithCleanupFixture)
+{
+  createTopology({
+      {"1", "2"}
+    });
+
+  addRoutes({
+      {"1", "2", "/", 1}
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"LifeTime", "2s"}, {"Frequency", "1"}},
+          "0.5s", "100s"},
+      {"2", "ns3::ndn::Producer", {{"Prefix", "/"}}, "0s", "100s"}
+    });
+
+  std::vector<shared_ptr<const Interest>> interests;
+  getNode("1")->GetApplication(0)->TraceConnectWithoutContext("TransmittedInterests",
+    MakeBoundCallback(&recordInterest, &interests));
+
+  // attributes changed while the consumer is running apply to the following Interests
+  Simulator::Schedule(Seconds(2), &setConsumerAttributes);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(interests.size(), 4);
+  for (size_t i = 0; i < interests.size(); i++) {
+    bool isChanged = i >= 2;
+    BOOST_CHECK_EQUAL(interests[i]->getName(),
+                      Name(isChanged ? "/other" : "/prefix").appendSequenceNumber(i));
+    BOOST_CHECK_EQUAL(interests[i]->getInterestLifetime(),
+                      time::milliseconds(isChanged ? 1000 : 2000));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+#include "apps/ndn-app.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_REQUEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH)
+                                                   / "requests.bin";
+
+class RequestTraceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RequestTraceFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~RequestTraceFixture()
+  {
+    boost::filesystem::remove(TEST_REQUEST_TRACE);
+  }
+
+  static bool
+  convert(const std::string& text)
+  {
+    std::istringstream is(text);
+    return RequestTrace::ConvertFromText(is, TEST_REQUEST_TRACE.string());
+  }
+
+  void
+  recordInterest(const std::string& node, shared_ptr<const Interest> interest, Ptr<App>,
+                 shared_ptr<Face>)
+  {
+    m_interests[node].push_back(std::make_pair(Simulator::Now(), interest->getName()));
+  }
+
+  void
+  recordData(const std::string& node, shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    m_data[node]++;
+  }
+
+protected:
+  std::map<std::string, std::vector<std::pair<Time, Name>>> m_interests;
+  std::map<std::string, int> m_data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRequestTrace, RequestTraceFixture)
+
+BOOST_AUTO_TEST_CASE(ConvertAndRead)
+{
+  BOOST_CHECK(convert("0.2 /a/1 100\n"
+                      "0.1 /a/2 200\n"
+                      "\n"
+                      "0.1 /a/1 300\n"
+                      "1.5 /b 400\n"));
+  {
+    shared_ptr<const RequestTrace> trace = RequestTrace::Open(TEST_REQUEST_TRACE.string());
+    BOOST_REQUIRE(trace != nullptr);
+    BOOST_CHECK(RequestTrace::Open(TEST_REQUEST_TRACE.string()) == trace);
+
+    BOOST_REQUIRE_EQUAL(trace->GetRecordCount(), 4);
+    BOOST_CHECK_EQUAL(trace->GetNameCount(), 3);
+
+    // sorted by time, records with the same time keep their order
+    const uint64_t times[] = {100000000, 100000000, 200000000, 1500000000};
+    const char* names[] = {"/a/2", "/a/1", "/a/1", "/b"};
+    const uint32_t sizes[] = {200, 300, 100, 400};
+    for (int i = 0; i < 4; i++) {
+      const RequestTrace::Record& record = trace->GetRecord(i);
+      BOOST_CHECK_EQUAL(record.time, times[i]);
+      BOOST_CHECK_EQUAL(trace->GetName(record.nameId), Name(names[i]));
+      BOOST_CHECK_EQUAL(record.size, sizes[i]);
+    }
+  }
+
+  BOOST_CHECK(!convert("0.1 /a/1\n"));
+  BOOST_CHECK(!convert("-1 /a/1 100\n"));
+
+  std::ofstream(TEST_REQUEST_TRACE.string().c_str()) << "0.1 /a/1 100\n";
+  BOOST_CHECK(RequestTrace::Open(TEST_REQUEST_TRACE.string()) == nullptr);
+  BOOST_CHECK(RequestTrace::Open((TEST_REQUEST_TRACE / "missing").string()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Corrupted)
+{
+  BOOST_REQUIRE(convert("0.1 /a/1 100\n"
+                        "0.2 /a/2 100\n"));
+
+  // name id of the first record, which follows the 40-byte header and its 8-byte time
+  uint32_t nameId = 2;
+  {
+    std::fstream file(TEST_REQUEST_TRACE.string().c_str(),
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(40 + 8);
+    file.write(reinterpret_cast<const char*>(&nameId), sizeof(nameId));
+  }
+  BOOST_CHECK(RequestTrace::Open(TEST_REQUEST_TRACE.string()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ShardedReplay)
+{
+  BOOST_REQUIRE(convert("0.1 /a/0 100\n"
+                        "0.2 /a/1 100\n"
+                        "0.3 /a/2 100\n"
+                        "0.4 /a/0 100\n"
+                        "0.4 /a/1 100\n"
+                        "0.6 /a/2 100\n"));
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+  createTopology({
+      {"1", "3"},
+      {"2", "3"},
+      {"4", "3"},
+    });
+
+  addRoutes({
+      {"1", "3", "/", 1},
+      {"2", "3", "/", 1},
+      {"4", "3", "/", 1},
+    });
+
+  std::string trace = TEST_REQUEST_TRACE.string();
+  addApps({
+      {"1", "ns3::ndn::ConsumerTrace",
+          {{"TraceFile", trace}, {"ShardIndex", "0"}, {"ShardCount", "2"}},
+          "1s", "100s"},
+      {"2", "ns3::ndn::ConsumerTrace",
+          {{"TraceFile", trace}, {"ShardIndex", "1"}, {"ShardCount", "2"}},
+          "1s", "100s"},
+      {"4", "ns3::ndn::ConsumerTrace",
+          {{"TraceFile", trace}, {"ShardIndex", "1"}, {"ShardCount", "2"},
+           {"ShardByName", "true"}},
+          "1s", "100s"},
+      {"3", "ns3::ndn::Producer", {{"Prefix", "/"}}, "0s", "100s"},
+    });
+
+  for (const std::string& node : {"1", "2", "4"}) {
+    Ptr<Application> app = getNode(node)->GetApplication(0);
+    app->TraceConnectWithoutContext("TransmittedInterests",
+                                    MakeCallback(&RequestTraceFixture::recordInterest, this)
+                                      .Bind(node));
+    app->TraceConnectWithoutContext("ReceivedDatas",
+                                    MakeCallback(&RequestTraceFixture::recordData, this)
+                                      .Bind(node));
+  }
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  typedef std::vector<std::pair<Time, Name>> Requests;
+  BOOST_CHECK(m_interests["1"] == (Requests{{MilliSeconds(1100), "/a/0"},
+                                            {MilliSeconds(1300), "/a/2"},
+                                            {MilliSeconds(1400), "/a/1"}}));
+  BOOST_CHECK(m_interests["2"] == (Requests{{MilliSeconds(1200), "/a/1"},
+                                            {MilliSeconds(1400), "/a/0"},
+                                            {MilliSeconds(1600), "/a/2"}}));
+  // name ids are assigned in order of first request, /a/1 has id 1
+  BOOST_CHECK(m_interests["4"] == (Requests{{MilliSeconds(1200), "/a/1"},
+                                            {MilliSeconds(1400), "/a/1"}}));
+
+  BOOST_CHECK_EQUAL(m_data["1"], 3);
+  BOOST_CHECK_EQUAL(m_data["2"], 3);
+  BOOST_CHECK_EQUAL(m_data["4"], 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
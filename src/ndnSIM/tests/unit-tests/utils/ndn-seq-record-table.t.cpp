@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-record-table.hpp"
+
+#include "../tests-common.hpp"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnSeqRecordTable)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  SeqRecordTable table;
+  BOOST_CHECK(table.Find(1) == nullptr);
+
+  SeqRecord& record = table.Insert(1);
+  BOOST_CHECK_EQUAL(record.seq, 1);
+  BOOST_CHECK_EQUAL(record.retxCount, 0);
+  BOOST_CHECK_EQUAL(record.isTimerArmed, false);
+  record.retxCount = 3;
+
+  BOOST_CHECK_EQUAL(table.Insert(1).retxCount, 3);
+  BOOST_REQUIRE(table.Find(1) != nullptr);
+  BOOST_CHECK_EQUAL(table.Find(1)->retxCount, 3);
+  BOOST_CHECK_EQUAL(table.GetSize(), 1);
+
+  table.Erase(1);
+  table.Erase(2);
+  BOOST_CHECK(table.Find(1) == nullptr);
+  BOOST_CHECK_EQUAL(table.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SlidingWindow)
+{
+  SeqRecordTable table;
+  const uint32_t window = 100;
+  for (uint32_t seq = 0; seq < 10000; seq++) {
+    table.Insert(seq).retxCount = seq;
+    if (seq >= window) {
+      BOOST_REQUIRE(table.Find(seq - window) != nullptr);
+      table.Erase(seq - window);
+    }
+  }
+  BOOST_CHECK_EQUAL(table.GetSize(), window);
+  BOOST_CHECK_EQUAL(table.GetCapacity(), 256);
+  for (uint32_t seq = 10000 - window; seq < 10000; seq++) {
+    BOOST_REQUIRE(table.Find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(table.Find(seq)->retxCount, seq);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Collisions)
+{
+  // sequence numbers sharing slots, erased in arbitrary order
+  SeqRecordTable table;
+  std::map<uint32_t, uint32_t> expected;
+  uint32_t state = 1;
+  for (int i = 0; i < 20000; i++) {
+    state = state * 1103515245 + 12345;
+    uint32_t seq = (state >> 8) % 512 * 1024;
+    if (state % 3 == 0) {
+      table.Erase(seq);
+      expected.erase(seq);
+    }
+    else {
+      table.Insert(seq).retxCount = i;
+      expected[seq] = i;
+    }
+    BOOST_REQUIRE_EQUAL(table.GetSize(), expected.size());
+  }
+
+  for (const auto& entry : expected) {
+    BOOST_REQUIRE(table.Find(entry.first) != nullptr);
+    BOOST_CHECK_EQUAL(table.Find(entry.first)->retxCount, entry.second);
+  }
+  for (uint32_t seq = 0; seq < 512 * 1024; seq += 512) {
+    BOOST_CHECK_EQUAL(table.Find(seq) != nullptr, expected.count(seq) > 0);
+  }
+
+  table.Clear();
+  BOOST_CHECK_EQUAL(table.GetSize(), 0);
+  BOOST_CHECK(table.Find(expected.begin()->first) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
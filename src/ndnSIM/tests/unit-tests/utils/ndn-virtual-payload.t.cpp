@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-virtual-payload.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnVirtualPayload)
+
+static Block
+makeData(::ndn::ConstBufferPtr content)
+{
+  Data data("/prefix/data");
+  data.setContent(content);
+  StackHelper::getKeyChain().sign(data);
+  return data.wireEncode();
+}
+
+BOOST_AUTO_TEST_CASE(SharedBuffer)
+{
+  ::ndn::ConstBufferPtr buffer = VirtualPayload::GetBuffer(1024);
+  BOOST_CHECK_EQUAL(buffer->size(), 1024);
+  BOOST_CHECK(std::all_of(buffer->begin(), buffer->end(), [] (uint8_t b) { return b == 0; }));
+  BOOST_CHECK(VirtualPayload::GetBuffer(1024) == buffer);
+  BOOST_CHECK(VirtualPayload::GetBuffer(1000) != buffer);
+}
+
+BOOST_AUTO_TEST_CASE(Find)
+{
+  size_t offset = 0;
+  size_t length = 0;
+
+  Block data = makeData(VirtualPayload::GetBuffer(1024));
+  BOOST_REQUIRE(VirtualPayload::Find(data, offset, length));
+  BOOST_CHECK_EQUAL(length, 1024);
+  Data decoded(data);
+  BOOST_CHECK(decoded.getContent().value() == data.wire() + offset);
+  size_t dataOffset = offset;
+
+  // Data is at the end of the NDNLP packet
+  lp::Packet lp(data);
+  lp.add<lp::SequenceField>(0); // to make sure that the NDNLP header is added
+  Block lpPacket = lp.wireEncode();
+  BOOST_CHECK_EQUAL(lpPacket.type(), lp::tlv::LpPacket);
+  BOOST_REQUIRE(VirtualPayload::Find(lpPacket, offset, length));
+  BOOST_CHECK_EQUAL(length, 1024);
+  BOOST_CHECK_EQUAL(lpPacket.size() - offset, data.size() - dataOffset);
+
+  auto content = make_shared< ::ndn::Buffer>(1024);
+  (*content)[1000] = 1;
+  BOOST_CHECK(!VirtualPayload::Find(makeData(content), offset, length));
+  BOOST_CHECK(!VirtualPayload::Find(makeData(VirtualPayload::GetBuffer(10)), offset, length));
+
+  Interest interest("/prefix/interest");
+  interest.setNonce(1);
+  BOOST_CHECK(!VirtualPayload::Find(interest.wireEncode(), offset, length));
+  Block lpInterest = lp::Packet(interest.wireEncode()).wireEncode();
+  BOOST_CHECK(!VirtualPayload::Find(lpInterest, offset, length));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
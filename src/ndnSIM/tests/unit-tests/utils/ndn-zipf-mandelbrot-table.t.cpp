@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-mandelbrot-table.hpp"
+#include "apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnZipfMandelbrotTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Distribution)
+{
+  const uint32_t n = 100;
+  ZipfMandelbrotTable table(n, 0.7, 0.7);
+  BOOST_CHECK_EQUAL(table.GetN(), n);
+
+  double sum = 0;
+  for (uint32_t rank = 1; rank <= n; rank++) {
+    sum += table.GetProbability(rank);
+  }
+  BOOST_CHECK_CLOSE(sum, 1.0, 1e-9);
+  BOOST_CHECK_GT(table.GetProbability(1), table.GetProbability(2));
+
+  // uniform grid of inputs yields the exact distribution (up to the grid resolution)
+  const uint32_t nPoints = 1000 * n;
+  std::vector<uint32_t> counts(n + 1);
+  for (uint32_t i = 0; i < nPoints; i++) {
+    uint32_t rank = table.Sample((i + 0.5) / nPoints);
+    BOOST_REQUIRE(rank >= 1 && rank <= n);
+    counts[rank]++;
+  }
+  for (uint32_t rank = 1; rank <= n; rank++) {
+    BOOST_CHECK_SMALL(static_cast<double>(counts[rank]) / nPoints - table.GetProbability(rank),
+                      2.0 / nPoints);
+  }
+
+  BOOST_CHECK_EQUAL(ZipfMandelbrotTable(1, 0.7, 0.7).Sample(0.99), 1);
+  BOOST_CHECK_EQUAL(ZipfMandelbrotTable(0, 0.7, 0.7).Sample(0.5), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SharedTables)
+{
+  shared_ptr<const ZipfMandelbrotTable> table = ZipfMandelbrotTable::Get(1000, 0.7, 0.7);
+  BOOST_CHECK(ZipfMandelbrotTable::Get(1000, 0.7, 0.7) == table);
+  BOOST_CHECK(ZipfMandelbrotTable::Get(1000, 0.7, 0.8) != table);
+  BOOST_CHECK(ZipfMandelbrotTable::Get(1001, 0.7, 0.7) != table);
+
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(1000));
+  for (int i = 0; i < 1000; i++) {
+    uint32_t seq = consumer->GetNextSeq();
+    BOOST_CHECK(seq >= 1 && seq <= 1000);
+  }
+  BOOST_CHECK_GT(table.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
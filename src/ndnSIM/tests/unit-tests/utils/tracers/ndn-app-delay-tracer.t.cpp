@@ -161,6 +161,29 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 )STR"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllAggregated)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  // the second Data of node 2 is received after the last full period
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Prefix	Type	Count	MeanUS	MinUS	P50US	P90US	P99US	P999US	MaxUS
+1	1	0	/prefix	LastDelay	1	41788.8	41788.8	41788.8	41788.8	41788.8	41788.8	41788.8
+1	1	0	/prefix	FullDelay	1	41788.8	41788.8	41788.8	41788.8	41788.8	41788.8	41788.8
+3	2	0	/prefix	LastDelay	1	0	0	0	0	0	0	0
+3	2	0	/prefix	FullDelay	1	0	0	0	0	0	0	0
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-delay-histogram.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnDelayHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  DelayHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), Time(0));
+  BOOST_CHECK_EQUAL(histogram.GetMax(), Time(0));
+  BOOST_CHECK_EQUAL(histogram.GetMean(), Time(0));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), Time(0));
+}
+
+BOOST_AUTO_TEST_CASE(Quantiles)
+{
+  DelayHistogram histogram;
+  // 1 ms .. 1000 ms
+  for (int i = 1; i <= 1000; i++) {
+    histogram.Add(MilliSeconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 1000);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), MilliSeconds(1));
+  BOOST_CHECK_EQUAL(histogram.GetMax(), MilliSeconds(1000));
+  BOOST_CHECK_EQUAL(histogram.GetMean(), MicroSeconds(500500));
+
+  BOOST_CHECK_CLOSE(histogram.GetQuantile(0.5).ToDouble(Time::MS), 500, 1);
+  BOOST_CHECK_CLOSE(histogram.GetQuantile(0.9).ToDouble(Time::MS), 900, 1);
+  BOOST_CHECK_CLOSE(histogram.GetQuantile(0.99).ToDouble(Time::MS), 990, 1);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(1), MilliSeconds(1000));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0), MilliSeconds(1));
+
+  // small delays are exact
+  DelayHistogram small;
+  small.Add(MicroSeconds(5));
+  small.Add(MicroSeconds(7));
+  small.Add(MicroSeconds(100));
+  BOOST_CHECK_CLOSE(small.GetQuantile(0.5).ToDouble(Time::US), 7.5, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(MergeAndReset)
+{
+  DelayHistogram first;
+  DelayHistogram second;
+  for (int i = 1; i <= 500; i++) {
+    first.Add(MilliSeconds(i));
+    second.Add(MilliSeconds(500 + i));
+  }
+
+  first.Merge(second);
+  BOOST_CHECK_EQUAL(first.GetCount(), 1000);
+  BOOST_CHECK_EQUAL(first.GetMin(), MilliSeconds(1));
+  BOOST_CHECK_EQUAL(first.GetMax(), MilliSeconds(1000));
+  BOOST_CHECK_CLOSE(first.GetQuantile(0.9).ToDouble(Time::MS), 900, 1);
+
+  first.Reset();
+  BOOST_CHECK_EQUAL(first.GetCount(), 0);
+  first.Add(MilliSeconds(42));
+  BOOST_CHECK_EQUAL(first.GetQuantile(0.5), MilliSeconds(42));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "utils/tracers/ndn-columnar-trace.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
@@ -28,6 +29,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin.gz";
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,6 +57,7 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     L3RateTracer::Destroy(); // additional cleanup
   }
 };
@@ -102,12 +105,13 @@ BOOST_AUTO_TEST_CASE(NackTracing)
      << "1	1	256	internal://	OutTimedOutInterests	0	0	0	0\n";
   BOOST_CHECK(os.match_pattern());
 
-  os << "1	1	257	appFace://	InInterests	0.8	0	1	0\n"
+  // Interests of consumers are encoded from InterestTemplate, so their size is counted
+  os << "1	1	257	appFace://	InInterests	0.8	0.0203125	1	0.0253906\n"
      << "1	1	257	appFace://	OutInterests	0	0	0	0\n"
      << "1	1	257	appFace://	InData	0	0	0	0\n"
      << "1	1	257	appFace://	OutData	0	0	0	0\n"
      << "1	1	257	appFace://	InNacks	0	0	0	0\n"
-     << "1	1	257	appFace://	OutNacks	0.8	0	1	0\n"
+     << "1	1	257	appFace://	OutNacks	0.8	0.0203125	1	0.0253906\n"
      << "1	1	257	appFace://	InSatisfiedInterests	0	0	0	0\n"
      << "1	1	257	appFace://	InTimedOutInterests	0	0	0	0\n"
      << "1	1	257	appFace://	OutSatisfiedInterests	0	0	0	0\n"
@@ -119,6 +123,57 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(ColumnarOutput)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::Install(nodes, TEST_BINARY_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  ColumnarTraceReader reader;
+  BOOST_REQUIRE(reader.Open(TEST_BINARY_TRACE.string()));
+  BOOST_CHECK_EQUAL(reader.GetTracer(), "L3RateTracer");
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 9);
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].name, "FaceId");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].type, ColumnarTraceWriter::INT64);
+
+  BOOST_REQUIRE(reader.ReadBlock());
+  BOOST_REQUIRE_EQUAL(reader.GetRowCount(), 32);
+  BOOST_CHECK_EQUAL(reader.GetDouble(0, 31), 1.0);
+  BOOST_CHECK_EQUAL(reader.GetString(1, 31), "1");
+  BOOST_CHECK_EQUAL(reader.GetInt(2, 31), -1);
+  BOOST_CHECK_EQUAL(reader.GetString(4, 31), "TimedOutInterests");
+  BOOST_CHECK_EQUAL(reader.GetDouble(7, 31), 1.0);
+  BOOST_CHECK(!reader.ReadBlock());
+
+  // converted trace is the same as text output
+  {
+    std::ofstream text(TEST_TRACE.string().c_str());
+    BOOST_REQUIRE(ColumnarTraceReader::ConvertToText(TEST_BINARY_TRACE.string(), text));
+  }
+  boost::test_tools::output_test_stream os(TEST_TRACE.string().c_str(), true);
+
+  os << "Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	KilobytesRaw\n";
+  BOOST_CHECK(os.match_pattern());
+
+  os << "1	1	1	internal://	InInterests	0	0	0	0\n"
+     << "1	1	1	internal://	OutInterests	0	0	0	0\n"
+     << "1	1	1	internal://	InData	0	0	0	0\n"
+     << "1	1	1	internal://	OutData	0	0	0	0\n"
+     << "1	1	1	internal://	InNacks	0	0	0	0\n"
+     << "1	1	1	internal://	OutNacks	0	0	0	0\n"
+     << "1	1	1	internal://	InSatisfiedInterests	0	0	0	0\n"
+     << "1	1	1	internal://	InTimedOutInterests	0	0	0	0\n"
+     << "1	1	1	internal://	OutSatisfiedInterests	2.4	0	3	0\n"
+     << "1	1	1	internal://	OutTimedOutInterests	0	0	0	0\n";
+  BOOST_CHECK(os.match_pattern());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
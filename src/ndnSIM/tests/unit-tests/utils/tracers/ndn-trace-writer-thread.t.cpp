@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-writer-thread.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TraceWriterThreadFixture
+{
+public:
+  ~TraceWriterThreadFixture()
+  {
+    TraceWriterThread::Disable();
+  }
+
+  static std::string
+  writeRecords(std::ostream& os, int nRecords)
+  {
+    std::ostringstream expected;
+    for (int i = 0; i < nRecords; i++) {
+      os << i << "\t" << "record" << "\n";
+      expected << i << "\t" << "record" << "\n";
+    }
+    return expected.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceWriterThread, TraceWriterThreadFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  auto os = make_shared<std::ostringstream>();
+  BOOST_CHECK(TraceWriterThread::Wrap(os) == os);
+}
+
+BOOST_AUTO_TEST_CASE(BlockOnOverflow)
+{
+  TraceWriterThread::Enable(256, TraceWriterThread::BLOCK_ON_OVERFLOW);
+  TraceWriterThread::Stats before = TraceWriterThread::GetStats();
+
+  auto output = make_shared<std::ostringstream>();
+  std::string expected;
+  {
+    shared_ptr<std::ostream> os = TraceWriterThread::Wrap(output);
+    BOOST_CHECK(os != output);
+    expected = writeRecords(*os, 100000);
+  }
+
+  BOOST_CHECK(output->str() == expected);
+
+  TraceWriterThread::Stats after = TraceWriterThread::GetStats();
+  BOOST_CHECK_EQUAL(after.writtenBytes - before.writtenBytes, expected.size());
+  BOOST_CHECK_EQUAL(after.droppedBytes - before.droppedBytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DropOnOverflow)
+{
+  TraceWriterThread::Enable(4096, TraceWriterThread::DROP_ON_OVERFLOW);
+  TraceWriterThread::Stats before = TraceWriterThread::GetStats();
+
+  auto output = make_shared<std::ostringstream>();
+  std::string expected;
+  {
+    shared_ptr<std::ostream> os = TraceWriterThread::Wrap(output);
+    expected = writeRecords(*os, 100000);
+  }
+  TraceWriterThread::Stats after = TraceWriterThread::GetStats();
+
+  // only whole records are dropped, and the remaining ones are in order
+  std::istringstream written(output->str());
+  std::string line;
+  int lastRecord = -1;
+  uint64_t nRecords = 0;
+  while (std::getline(written, line)) {
+    int record = std::stoi(line);
+    BOOST_REQUIRE_GT(record, lastRecord);
+    BOOST_REQUIRE_EQUAL(line, std::to_string(record) + "\trecord");
+    lastRecord = record;
+    nRecords++;
+  }
+
+  BOOST_CHECK_EQUAL(after.writtenBytes - before.writtenBytes, output->str().size());
+  BOOST_CHECK_EQUAL(output->str().size() + after.droppedBytes - before.droppedBytes,
+                    expected.size());
+  BOOST_CHECK_EQUAL(nRecords + after.droppedRecords - before.droppedRecords, 100000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-template.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+DataTemplate::DataTemplate(const Data& prototype)
+{
+  Init(prototype);
+}
+
+DataTemplate::DataTemplate(const time::milliseconds& freshness, ::ndn::ConstBufferPtr content,
+                           uint32_t signature, const Name& keyLocator)
+{
+  Init(*Encode(Name(), freshness, content, signature, keyLocator));
+}
+
+void
+DataTemplate::Init(const Data& prototype)
+{
+  const Block& wire = prototype.wireEncode();
+  wire.parse();
+  const Block& name = wire.get(::ndn::tlv::Name);
+
+  m_suffix = make_shared<::ndn::Buffer>(name.end(), wire.value_end());
+}
+
+shared_ptr<Data>
+DataTemplate::Make(const Name& name) const
+{
+  const Block& nameWire = name.wireEncode();
+  size_t valueLength = nameWire.size() + m_suffix->size();
+  size_t totalLength = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Data)
+                       + ::ndn::tlv::sizeOfVarNumber(valueLength) + valueLength;
+
+  ::ndn::EncodingBuffer encoder(totalLength, 0);
+  encoder.prependByteArray(m_suffix->data(), m_suffix->size());
+  encoder.prependByteArray(nameWire.wire(), nameWire.size());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  return make_shared<Data>(encoder.block());
+}
+
+shared_ptr<Data>
+DataTemplate::Encode(const Name& name, const time::milliseconds& freshness,
+                     ::ndn::ConstBufferPtr content, uint32_t signature, const Name& keyLocator)
+{
+  auto data = make_shared<Data>();
+  data->setName(name);
+  data->setFreshnessPeriod(freshness);
+  data->setContent(content);
+
+  Signature fakeSignature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+
+  fakeSignature.setInfo(signatureInfo);
+  fakeSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                            signature));
+  data->setSignature(fakeSignature);
+
+  // to create real wire encoding
+  data->wireEncode();
+  return data;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DATA_TEMPLATE_H
+#define NDN_DATA_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Pre-encoded Data that differs only in the name
+ *
+ * Producers answer every Interest with Data that has the same MetaInfo, Content, and
+ * (fake) signature.  DataTemplate encodes these fields once; Make only writes the Data TLV
+ * header, copies the wire encoding of the name, and appends the pre-encoded fields, instead of
+ * building and encoding MetaInfo, SignatureInfo, and SignatureValue for every Data.
+ *
+ * Data created by Make is identical to the prototype with the name replaced.
+ */
+class DataTemplate {
+public:
+  /**
+   * @brief Create template from @p prototype, which must have a signature (its name is ignored)
+   */
+  explicit
+  DataTemplate(const Data& prototype);
+
+  /**
+   * @brief Create template of Data with a fake signature, as sent by Producer
+   *
+   * @param freshness   FreshnessPeriod of Data
+   * @param content     Content of Data
+   * @param signature   Value of the fake signature (of type 255)
+   * @param keyLocator  KeyLocator of the signature, not included if empty
+   */
+  DataTemplate(const time::milliseconds& freshness, ::ndn::ConstBufferPtr content,
+               uint32_t signature, const Name& keyLocator);
+
+  /**
+   * @brief Create Data with name @p name and the remaining fields of the template
+   *
+   * The returned Data has wire encoding.
+   */
+  shared_ptr<Data>
+  Make(const Name& name) const;
+
+  /**
+   * @brief Get size of the pre-encoded fields (everything after the name)
+   */
+  size_t
+  GetSuffixSize() const
+  {
+    return m_suffix->size();
+  }
+
+  /**
+   * @brief Create Data with a fake signature the way Producer did before templates
+   *
+   * Encodes all fields of Data; used to create template prototypes and as a reference.
+   */
+  static shared_ptr<Data>
+  Encode(const Name& name, const time::milliseconds& freshness, ::ndn::ConstBufferPtr content,
+         uint32_t signature, const Name& keyLocator);
+
+private:
+  void
+  Init(const Data& prototype);
+
+private:
+  ::ndn::ConstBufferPtr m_suffix; // encoded MetaInfo, Content, SignatureInfo, SignatureValue
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DATA_TEMPLATE_H
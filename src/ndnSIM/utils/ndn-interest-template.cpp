@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-interest-template.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t NONCE_SIZE = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Nonce)
+                                 + ::ndn::tlv::sizeOfVarNumber(sizeof(uint32_t)) + sizeof(uint32_t);
+
+InterestTemplate::InterestTemplate(const Interest& prototype)
+{
+  Init(prototype);
+}
+
+InterestTemplate::InterestTemplate(const Name& prefix, const time::milliseconds& lifetime)
+{
+  Interest prototype(prefix);
+  prototype.setNonce(0);
+  prototype.setInterestLifetime(lifetime);
+  Init(prototype);
+}
+
+void
+InterestTemplate::Init(const Interest& prototype)
+{
+  const Block& wire = prototype.wireEncode();
+  wire.parse();
+  const Block& name = wire.get(::ndn::tlv::Name);
+  const Block& nonce = wire.get(::ndn::tlv::Nonce);
+
+  m_prefix = make_shared<::ndn::Buffer>(name.value_begin(), name.value_end());
+  m_selectors = make_shared<::ndn::Buffer>(name.end(), nonce.begin());
+  m_suffix = make_shared<::ndn::Buffer>(nonce.end(), wire.value_end());
+}
+
+size_t
+InterestTemplate::GetNameLength(uint32_t seq) const
+{
+  size_t componentLength = 1 + ::ndn::tlv::sizeOfNonNegativeInteger(seq);
+  return m_prefix->size() + ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::GenericNameComponent)
+         + ::ndn::tlv::sizeOfVarNumber(componentLength) + componentLength;
+}
+
+size_t
+InterestTemplate::GetSize(uint32_t seq) const
+{
+  size_t nameLength = GetNameLength(seq);
+  size_t valueLength = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Name)
+                       + ::ndn::tlv::sizeOfVarNumber(nameLength) + nameLength
+                       + m_selectors->size() + NONCE_SIZE + m_suffix->size();
+  return ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Interest)
+         + ::ndn::tlv::sizeOfVarNumber(valueLength) + valueLength;
+}
+
+size_t
+InterestTemplate::Prepend(::ndn::EncodingBuffer& encoder, uint32_t seq, uint32_t nonce) const
+{
+  size_t valueLength = 0;
+  valueLength += encoder.prependByteArray(m_suffix->data(), m_suffix->size());
+
+  // same byte order as Interest::wireEncode
+  valueLength += encoder.prependByteArray(reinterpret_cast<const uint8_t*>(&nonce),
+                                          sizeof(nonce));
+  valueLength += encoder.prependVarNumber(sizeof(nonce));
+  valueLength += encoder.prependVarNumber(::ndn::tlv::Nonce);
+
+  valueLength += encoder.prependByteArray(m_selectors->data(), m_selectors->size());
+
+  // Name: prefix components and sequence number component (see Component::fromSequenceNumber)
+  size_t componentLength = encoder.prependNonNegativeInteger(seq);
+  componentLength += encoder.prependByte(::ndn::name::SEQUENCE_NUMBER_MARKER);
+  size_t nameLength = componentLength;
+  nameLength += encoder.prependVarNumber(componentLength);
+  nameLength += encoder.prependVarNumber(::ndn::tlv::GenericNameComponent);
+  nameLength += encoder.prependByteArray(m_prefix->data(), m_prefix->size());
+  valueLength += nameLength;
+  valueLength += encoder.prependVarNumber(nameLength);
+  valueLength += encoder.prependVarNumber(::ndn::tlv::Name);
+
+  size_t totalLength = valueLength;
+  totalLength += encoder.prependVarNumber(valueLength);
+  totalLength += encoder.prependVarNumber(::ndn::tlv::Interest);
+  return totalLength;
+}
+
+shared_ptr<Interest>
+InterestTemplate::Make(uint32_t seq, uint32_t nonce) const
+{
+  ::ndn::EncodingBuffer encoder(GetSize(seq), 0);
+  Prepend(encoder, seq, nonce);
+  return make_shared<Interest>(encoder.block());
+}
+
+shared_ptr<Interest>
+InterestTemplate::Encode(const Name& prefix, uint32_t seq, uint32_t nonce,
+                         const time::milliseconds& lifetime)
+{
+  shared_ptr<Name> nameWithSequence = make_shared<Name>(prefix);
+  nameWithSequence->appendSequenceNumber(seq);
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(nonce);
+  interest->setName(*nameWithSequence);
+  interest->setInterestLifetime(lifetime);
+
+  // to create real wire encoding
+  interest->wireEncode();
+  return interest;
+}
+
+} // namespace ndn
+} // namespace ns3
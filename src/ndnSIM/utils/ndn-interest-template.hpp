@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_INTEREST_TEMPLATE_H
+#define NDN_INTEREST_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer-fwd.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Pre-encoded Interest for names that differ only in the last (sequence number) component
+ *
+ * Consumers request names made of a fixed prefix and a sequence number, and all their
+ * Interests have the same lifetime and selectors.  InterestTemplate encodes the prefix and the
+ * other fields once; Make only writes the sequence number component, the Nonce, and the TLV
+ * headers, instead of copying the prefix Name, appending a component, and encoding all fields
+ * of every Interest.
+ *
+ * Interests created by Make are identical to the prototype with the sequence number appended
+ * to the name and the nonce replaced.
+ */
+class InterestTemplate {
+public:
+  /**
+   * @brief Create template from @p prototype, whose name is the prefix (its nonce is ignored)
+   */
+  explicit
+  InterestTemplate(const Interest& prototype);
+
+  /**
+   * @brief Create template of Interests for @p prefix, as sent by Consumer
+   */
+  InterestTemplate(const Name& prefix, const time::milliseconds& lifetime);
+
+  /**
+   * @brief Create Interest for the prefix with sequence number @p seq and nonce @p nonce
+   *
+   * The returned Interest has wire encoding.
+   */
+  shared_ptr<Interest>
+  Make(uint32_t seq, uint32_t nonce) const;
+
+  /**
+   * @brief Create Interest the way Consumer did before templates
+   *
+   * Encodes all fields of Interest; used to create template prototypes and as a reference.
+   */
+  static shared_ptr<Interest>
+  Encode(const Name& prefix, uint32_t seq, uint32_t nonce, const time::milliseconds& lifetime);
+
+private:
+  void
+  Init(const Interest& prototype);
+
+  /**
+   * @brief Get size of wire encoding of Interest with sequence number @p seq
+   */
+  size_t
+  GetSize(uint32_t seq) const;
+
+  /**
+   * @brief Get TLV-LENGTH of Name with sequence number @p seq
+   */
+  size_t
+  GetNameLength(uint32_t seq) const;
+
+  size_t
+  Prepend(::ndn::EncodingBuffer& encoder, uint32_t seq, uint32_t nonce) const;
+
+private:
+  ::ndn::ConstBufferPtr m_prefix;    // encoded components of the prefix
+  ::ndn::ConstBufferPtr m_selectors; // encoded fields between Name and Nonce
+  ::ndn::ConstBufferPtr m_suffix;    // encoded fields after Nonce
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_INTEREST_TEMPLATE_H
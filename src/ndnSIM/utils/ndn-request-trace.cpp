@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RequestTrace");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'R', 'E', 'Q', 'T', 'R'};
+const uint32_t VERSION = 1;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t nRecords;
+  uint64_t nNames;
+  uint64_t dictionaryOffset;
+};
+
+static_assert(sizeof(Header) == 40, "unexpected padding of request trace header");
+static_assert(sizeof(RequestTrace::Record) == 16, "unexpected padding of request trace record");
+
+} // namespace
+
+shared_ptr<const RequestTrace>
+RequestTrace::Open(const std::string& file)
+{
+  // consumers replaying the same trace (e.g., its shards) share the mapping
+  static std::map<std::string, std::weak_ptr<const RequestTrace>> s_traces;
+
+  shared_ptr<const RequestTrace> trace = s_traces[file].lock();
+  if (trace != nullptr) {
+    return trace;
+  }
+
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    NS_LOG_ERROR("Cannot open " << file);
+    return nullptr;
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    NS_LOG_ERROR(file << " is not a request trace");
+    ::close(fd);
+    return nullptr;
+  }
+
+  size_t size = info.st_size;
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    NS_LOG_ERROR("Cannot map " << file);
+    return nullptr;
+  }
+
+  const Header& header = *reinterpret_cast<const Header*>(mapping);
+  bool isValid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+                 && header.version == VERSION
+                 && header.nRecords <= (size - sizeof(Header)) / sizeof(Record)
+                 && header.dictionaryOffset >= sizeof(Header) + header.nRecords * sizeof(Record)
+                 && header.dictionaryOffset % sizeof(uint64_t) == 0
+                 && header.dictionaryOffset <= size
+                 && header.nNames < (size - header.dictionaryOffset) / sizeof(uint64_t);
+  if (isValid) {
+    const uint64_t* offsets =
+      reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(mapping)
+                                        + header.dictionaryOffset);
+    size_t namesOffset = header.dictionaryOffset + (header.nNames + 1) * sizeof(uint64_t);
+    isValid = offsets[header.nNames] <= size - namesOffset;
+  }
+
+  if (!isValid) {
+    NS_LOG_ERROR(file << " is not a request trace of a supported version");
+    ::munmap(mapping, size);
+    return nullptr;
+  }
+
+  // names and records are used without further checks, a corrupted dictionary must not be replayed
+  const uint8_t* base = static_cast<const uint8_t*>(mapping);
+  const uint64_t* offsets = reinterpret_cast<const uint64_t*>(base + header.dictionaryOffset);
+  for (uint64_t i = 0; i < header.nNames; i++) {
+    if (offsets[i] >= offsets[i + 1]) {
+      NS_LOG_ERROR(file << ": offsets of names do not increase at name " << i);
+      ::munmap(mapping, size);
+      return nullptr;
+    }
+  }
+  const Record* records = reinterpret_cast<const Record*>(base + sizeof(Header));
+  for (uint64_t i = 0; i < header.nRecords; i++) {
+    if (records[i].nameId >= header.nNames) {
+      NS_LOG_ERROR(file << ": record " << i << " refers to unknown name " << records[i].nameId);
+      ::munmap(mapping, size);
+      return nullptr;
+    }
+  }
+
+  trace.reset(new RequestTrace(static_cast<const uint8_t*>(mapping), size));
+  s_traces[file] = trace;
+  return trace;
+}
+
+RequestTrace::RequestTrace(const uint8_t* mapping, size_t size)
+  : m_mapping(mapping)
+  , m_size(size)
+{
+  const Header& header = *reinterpret_cast<const Header*>(m_mapping);
+
+  m_records = reinterpret_cast<const Record*>(m_mapping + sizeof(Header));
+  m_nRecords = header.nRecords;
+  m_nameOffsets = reinterpret_cast<const uint64_t*>(m_mapping + header.dictionaryOffset);
+  m_names = reinterpret_cast<const uint8_t*>(m_nameOffsets + header.nNames + 1);
+  m_nNames = header.nNames;
+}
+
+RequestTrace::~RequestTrace()
+{
+  ::munmap(const_cast<uint8_t*>(m_mapping), m_size);
+}
+
+Name
+RequestTrace::GetName(uint32_t nameId) const
+{
+  NS_ASSERT(nameId < m_nNames);
+  uint64_t offset = m_nameOffsets[nameId];
+  return Name(Block(m_names + offset, m_nameOffsets[nameId + 1] - offset));
+}
+
+bool
+RequestTrace::ConvertFromText(std::istream& is, const std::string& file)
+{
+  std::vector<Record> records;
+  std::vector<Name> names;
+  std::unordered_map<std::string, uint32_t> nameIds;
+
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream fields(line);
+    double time;
+    std::string uri;
+    uint32_t size;
+    if (!(fields >> time)) {
+      continue; // empty line
+    }
+    if (!(fields >> uri >> size) || time < 0) {
+      NS_LOG_ERROR("Malformed request: " << line);
+      return false;
+    }
+
+    auto nameId = nameIds.insert(std::make_pair(uri, names.size()));
+    if (nameId.second) {
+      try {
+        names.push_back(Name(uri));
+      }
+      catch (const std::exception& e) {
+        NS_LOG_ERROR("Malformed name " << uri << ": " << e.what());
+        return false;
+      }
+    }
+
+    records.push_back(Record{static_cast<uint64_t>(std::llround(time * 1e9)),
+                             nameId.first->second, size});
+  }
+
+  std::stable_sort(records.begin(), records.end(), [] (const Record& a, const Record& b) {
+      return a.time < b.time;
+    });
+
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::binary
+                                   | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("Cannot open " << file << " for writing");
+    return false;
+  }
+
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.reserved = 0;
+  header.nRecords = records.size();
+  header.nNames = names.size();
+  header.dictionaryOffset = sizeof(Header) + records.size() * sizeof(Record);
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(names.size() + 1);
+  offsets.push_back(0);
+  for (const Name& name : names) {
+    offsets.push_back(offsets.back() + name.wireEncode().size());
+  }
+
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+  os.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  for (const Name& name : names) {
+    os.write(reinterpret_cast<const char*>(name.wireEncode().wire()), name.wireEncode().size());
+  }
+
+  return static_cast<bool>(os.flush());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Memory-mapped binary trace of requests, replayed by ConsumerTrace
+ *
+ * The file consists of a header, fixed-size request records sorted by time, and a dictionary of
+ * names requested by the records.  All fields are stored in host byte order:
+ *
+ * - header (40 bytes): magic "NDNREQTR", version (uint32, 1), reserved (uint32), number of
+ *   records (uint64), number of names (uint64), offset of the dictionary (uint64)
+ * - records (16 bytes each): time since the start of the trace (uint64, nanoseconds), name id
+ *   (uint32), size of requested Data (uint32, bytes)
+ * - dictionary: number of names + 1 offsets (uint64) of TLV-encoded names relative to the end
+ *   of the offsets, followed by the encoded names
+ *
+ * The file is mapped into memory and records are read on demand, so traces larger than
+ * memory can be replayed.  All consumers replaying the same file share one mapping.
+ * ConvertFromText creates the file from a text trace.
+ */
+class RequestTrace : boost::noncopyable {
+public:
+  struct Record {
+    uint64_t time;   ///< @brief time since the start of the trace (nanoseconds)
+    uint32_t nameId; ///< @brief index of the name in the dictionary
+    uint32_t size;   ///< @brief size of requested Data (bytes)
+  };
+
+  /**
+   * @brief Map trace file into memory, or return mapping already opened by another consumer
+   * @returns nullptr if file cannot be mapped, is not a request trace of a supported version,
+   *          or is corrupted
+   *
+   * Name offsets and name ids of all records are validated once when the file is mapped.
+   */
+  static shared_ptr<const RequestTrace>
+  Open(const std::string& file);
+
+  ~RequestTrace();
+
+  uint64_t
+  GetRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+  const Record&
+  GetRecord(uint64_t index) const
+  {
+    return m_records[index];
+  }
+
+  uint64_t
+  GetNameCount() const
+  {
+    return m_nNames;
+  }
+
+  /**
+   * @brief Decode name from the dictionary
+   */
+  Name
+  GetName(uint32_t nameId) const;
+
+  /**
+   * @brief Convert text trace to binary request trace
+   *
+   * Every line of the text trace is one request: time since the start of the trace (seconds),
+   * name, and size of requested Data (bytes), separated by white space, e.g.,
+   * "0.0125 /video/1/%00%05 8192".  Records are sorted by time (stable).
+   *
+   * @returns false if the text trace is malformed or @p file cannot be written
+   */
+  static bool
+  ConvertFromText(std::istream& is, const std::string& file);
+
+private:
+  RequestTrace(const uint8_t* mapping, size_t size);
+
+private:
+  const uint8_t* m_mapping;
+  size_t m_size;
+
+  const Record* m_records;
+  uint64_t m_nRecords;
+  const uint64_t* m_nameOffsets;
+  const uint8_t* m_names;
+  uint64_t m_nNames;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
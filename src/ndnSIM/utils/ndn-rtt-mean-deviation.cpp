@@ -69,6 +69,7 @@ RttMeanDeviation::RttMeanDeviation(const RttMeanDeviation& c)
   , m_gain(c.m_gain)
   , m_gain2(c.m_gain2)
   , m_variance(c.m_variance)
+  , m_sent(c.m_sent)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -130,9 +131,18 @@ RttMeanDeviation::Reset()
   NS_LOG_FUNCTION(this);
   // Reset to initial state
   m_variance = Seconds(0);
+  m_sent.clear();
   RttEstimator::Reset();
 }
 
+void
+RttMeanDeviation::ClearSent()
+{
+  NS_LOG_FUNCTION(this);
+  m_sent.clear();
+  RttEstimator::ClearSent();
+}
+
 void
 RttMeanDeviation::Gain(double g)
 {
@@ -147,17 +157,14 @@ RttMeanDeviation::SentSeq(SequenceNumber32 seq, uint32_t size)
 {
   NS_LOG_FUNCTION(this << seq << size);
 
-  RttHistory_t::iterator i;
-  for (i = m_history.begin(); i != m_history.end(); ++i) {
-    if (seq == i->seq) { // Found it
-      i->retx = true;
-      break;
-    }
+  auto i = m_sent.find(seq.GetValue());
+  if (i != m_sent.end()) { // Found it
+    i->second.retx = true;
+  }
+  else {
+    // Note that a particular sequence has been sent
+    m_sent.insert(std::make_pair(seq.GetValue(), RttHistory(seq, size, Simulator::Now())));
   }
-
-  // Note that a particular sequence has been sent
-  if (i == m_history.end())
-    m_history.push_back(RttHistory(seq, size, Simulator::Now()));
 }
 
 Time
@@ -165,23 +172,17 @@ RttMeanDeviation::AckSeq(SequenceNumber32 ackSeq)
 {
   NS_LOG_FUNCTION(this << ackSeq);
   // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
   Time m = Seconds(0.0);
-  if (m_history.size() == 0)
+  auto i = m_sent.find(ackSeq.GetValue());
+  if (i == m_sent.end())
     return (m); // No pending history, just exit
 
-  for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
-    if (ackSeq == i->seq) { // Found it
-      if (!i->retx) {
-        m = Simulator::Now() - i->time; // Elapsed time
-        Measurement(m);                 // Log the measurement
-        ResetMultiplier();              // Reset multiplier on valid measurement
-      }
-      m_history.erase(i);
-      break;
-    }
+  if (!i->second.retx) {
+    m = Simulator::Now() - i->second.time; // Elapsed time
+    Measurement(m);                        // Log the measurement
+    ResetMultiplier();                     // Reset multiplier on valid measurement
   }
+  m_sent.erase(i);
 
   return m;
 }
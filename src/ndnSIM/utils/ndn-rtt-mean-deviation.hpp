@@ -30,6 +30,8 @@
 
 #include "ndn-rtt-estimator.hpp"
 
+#include <unordered_map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -43,6 +45,8 @@ namespace ndn {
  * by Van Jacobson and Michael J. Karels, in
  * "Congestion Avoidance and Control", SIGCOMM 88, Appendix A
  *
+ * Sent sequence numbers are kept in a hash table instead of the history list of the base class,
+ * since Data (and retransmissions) do not necessarily come in the order of sequence numbers.
  */
 class RttMeanDeviation : public RttEstimator {
 public:
@@ -68,12 +72,16 @@ public:
   void
   Reset();
   void
+  ClearSent();
+  void
   Gain(double g);
 
 private:
   double m_gain;   // Filter gain
   double m_gain2;  // Filter gain
   Time m_variance; // Current variance
+
+  std::unordered_map<uint32_t, RttHistory> m_sent; // Sent sequence numbers waiting for ack
 };
 
 } // namespace ndn
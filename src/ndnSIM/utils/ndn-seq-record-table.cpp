@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-record-table.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_CAPACITY = 16;
+
+SeqRecordTable::SeqRecordTable()
+  : m_slots(INITIAL_CAPACITY)
+  , m_isUsed(INITIAL_CAPACITY, false)
+  , m_mask(INITIAL_CAPACITY - 1)
+  , m_size(0)
+  , m_maxDisplacement(0)
+{
+}
+
+size_t
+SeqRecordTable::findSlot(uint32_t seq) const
+{
+  // no record is further than m_maxDisplacement from its home slot, so that looking up
+  // sequence numbers that are no longer in the table does not scan runs of other records
+  size_t slot = seq & m_mask;
+  for (size_t distance = 0; distance <= m_maxDisplacement && m_isUsed[slot]; distance++) {
+    if (m_slots[slot].seq == seq) {
+      return slot;
+    }
+    slot = (slot + 1) & m_mask;
+  }
+  return m_slots.size();
+}
+
+size_t
+SeqRecordTable::findFreeSlot(uint32_t seq) const
+{
+  size_t slot = seq & m_mask;
+  while (m_isUsed[slot]) {
+    slot = (slot + 1) & m_mask;
+  }
+  return slot;
+}
+
+SeqRecord*
+SeqRecordTable::Find(uint32_t seq)
+{
+  size_t slot = findSlot(seq);
+  return slot != m_slots.size() ? &m_slots[slot] : nullptr;
+}
+
+SeqRecord&
+SeqRecordTable::Insert(uint32_t seq)
+{
+  size_t slot = findSlot(seq);
+  if (slot != m_slots.size()) {
+    return m_slots[slot];
+  }
+
+  if (2 * (m_size + 1) > m_slots.size()) {
+    grow();
+  }
+  slot = findFreeSlot(seq);
+
+  m_maxDisplacement = std::max(m_maxDisplacement, (slot - seq) & m_mask);
+
+  SeqRecord& record = m_slots[slot];
+  record.seq = seq;
+  record.retxCount = 0;
+  record.firstSent = Time();
+  record.lastSent = Time();
+  record.timeoutBase = Time();
+  record.isTimerArmed = false;
+  m_isUsed[slot] = true;
+  m_size++;
+  return record;
+}
+
+void
+SeqRecordTable::Erase(uint32_t seq)
+{
+  size_t hole = findSlot(seq);
+  if (hole == m_slots.size()) {
+    return;
+  }
+  m_isUsed[hole] = false;
+  m_size--;
+
+  // Move back records that would no longer be found across the hole.  Only records within
+  // m_maxDisplacement slots after the hole can have their home before it, so erasing from a run
+  // of consecutive sequence numbers (all in their home slots) does not scan the run.
+  size_t slot = hole;
+  for (size_t distance = 1; distance <= m_maxDisplacement; distance++) {
+    slot = (slot + 1) & m_mask;
+    if (!m_isUsed[slot]) {
+      break;
+    }
+
+    size_t home = m_slots[slot].seq & m_mask;
+    // record stays if its home is cyclically within (hole, slot]
+    bool stays = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+    if (!stays) {
+      m_slots[hole] = m_slots[slot];
+      m_isUsed[hole] = true;
+      m_isUsed[slot] = false;
+      hole = slot;
+      distance = 0;
+    }
+  }
+}
+
+void
+SeqRecordTable::Clear()
+{
+  m_slots.assign(INITIAL_CAPACITY, SeqRecord());
+  m_isUsed.assign(INITIAL_CAPACITY, false);
+  m_mask = INITIAL_CAPACITY - 1;
+  m_size = 0;
+  m_maxDisplacement = 0;
+}
+
+void
+SeqRecordTable::grow()
+{
+  std::vector<SeqRecord> slots(m_slots.size() * 2);
+  std::vector<bool> isUsed(slots.size(), false);
+  m_slots.swap(slots);
+  m_isUsed.swap(isUsed);
+  m_mask = m_slots.size() - 1;
+  m_maxDisplacement = 0;
+
+  for (size_t i = 0; i < slots.size(); i++) {
+    if (isUsed[i]) {
+      size_t slot = findFreeSlot(slots[i].seq);
+      m_slots[slot] = slots[i];
+      m_isUsed[slot] = true;
+      m_maxDisplacement = std::max(m_maxDisplacement, (slot - slots[i].seq) & m_mask);
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
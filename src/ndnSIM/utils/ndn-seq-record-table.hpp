@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEQ_RECORD_TABLE_H
+#define NDN_SEQ_RECORD_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Per-sequence-number state of Interests sent by a consumer
+ */
+struct SeqRecord {
+  uint32_t seq;
+  uint32_t retxCount; ///< @brief number of Interests sent for the sequence number
+  Time firstSent;     ///< @brief time of the first Interest
+  Time lastSent;      ///< @brief time of the last Interest
+  Time timeoutBase;   ///< @brief time the retransmission timer is measured from
+  bool isTimerArmed;  ///< @brief whether the retransmission timer is running
+};
+
+/**
+ * @brief Flat table of SeqRecord, indexed by sequence number
+ *
+ * Records are stored in a power-of-two ring at position seq mod capacity, with linear probing
+ * on collisions.  Consumers that request consecutive sequence numbers keep their outstanding
+ * records in adjacent slots, so lookups take one probe as long as the spread of outstanding
+ * sequence numbers (about the window) is below the capacity, which doubles when the table
+ * becomes half full.  Arbitrary sequence numbers (e.g., ConsumerZipfMandelbrot) still take
+ * expected constant time.
+ *
+ * Pointers to records are invalidated by Insert and Erase.
+ */
+class SeqRecordTable {
+public:
+  SeqRecordTable();
+
+  /**
+   * @brief Find record of @p seq, or return nullptr
+   */
+  SeqRecord*
+  Find(uint32_t seq);
+
+  /**
+   * @brief Find record of @p seq, or create one with zero counter and times
+   */
+  SeqRecord&
+  Insert(uint32_t seq);
+
+  void
+  Erase(uint32_t seq);
+
+  void
+  Clear();
+
+  size_t
+  GetSize() const
+  {
+    return m_size;
+  }
+
+  size_t
+  GetCapacity() const
+  {
+    return m_slots.size();
+  }
+
+private:
+  /**
+   * @brief Get slot of record of @p seq, or capacity if there is none
+   */
+  size_t
+  findSlot(uint32_t seq) const;
+
+  size_t
+  findFreeSlot(uint32_t seq) const;
+
+  void
+  grow();
+
+private:
+  std::vector<SeqRecord> m_slots;
+  std::vector<bool> m_isUsed;
+  size_t m_mask;
+  size_t m_size;
+  size_t m_maxDisplacement; ///< @brief upper bound of distance of records from their home slot
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_RECORD_TABLE_H
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-virtual-payload.hpp"
+
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/lp/tlv.hpp>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace ns3 {
+namespace ndn {
+
+::ndn::ConstBufferPtr
+VirtualPayload::GetBuffer(size_t size)
+{
+  static std::map<size_t, ::ndn::ConstBufferPtr> buffers;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ::ndn::ConstBufferPtr& buffer = buffers[size];
+  if (buffer == nullptr) {
+    buffer = make_shared< ::ndn::Buffer>(size);
+  }
+  return buffer;
+}
+
+/**
+ * @brief Read TLV-TYPE and TLV-LENGTH at @p pos, check that the value fits before @p end
+ */
+static bool
+readTypeLength(const uint8_t*& pos, const uint8_t* end, uint64_t& type, uint64_t& length)
+{
+  return ::ndn::tlv::readVarNumber(pos, end, type) && ::ndn::tlv::readVarNumber(pos, end, length)
+         && length <= static_cast<uint64_t>(end - pos);
+}
+
+bool
+VirtualPayload::Find(const Block& packet, size_t& offset, size_t& length)
+{
+  if (!packet.hasWire()) {
+    return false;
+  }
+
+  const uint8_t* begin = packet.wire();
+  const uint8_t* pos = begin;
+  const uint8_t* end = begin + packet.size();
+  uint64_t type = 0;
+  uint64_t valueLength = 0;
+
+  if (!readTypeLength(pos, end, type, valueLength)) {
+    return false;
+  }
+  end = pos + valueLength;
+
+  if (type == ::ndn::lp::tlv::LpPacket) {
+    // Data is the value of the fragment field, which is the last field
+    while (pos < end) {
+      if (!readTypeLength(pos, end, type, valueLength)) {
+        return false;
+      }
+      if (type == ::ndn::lp::tlv::Fragment) {
+        end = pos + valueLength;
+        break;
+      }
+      pos += valueLength;
+    }
+
+    // a fragment of a larger Data fails the length check
+    if (pos >= end || !readTypeLength(pos, end, type, valueLength)) {
+      return false;
+    }
+    end = pos + valueLength;
+  }
+
+  if (type != ::ndn::tlv::Data) {
+    return false;
+  }
+
+  while (pos < end) {
+    if (!readTypeLength(pos, end, type, valueLength)) {
+      return false;
+    }
+    if (type == ::ndn::tlv::Content) {
+      // all bytes are equal to the first one, which is zero
+      if (valueLength < MIN_SIZE || pos[0] != 0
+          || std::memcmp(pos, pos + 1, valueLength - 1) != 0) {
+        return false;
+      }
+      offset = pos - begin;
+      length = valueLength;
+      return true;
+    }
+    pos += valueLength;
+  }
+  return false;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_VIRTUAL_PAYLOAD_H
+#define NDN_VIRTUAL_PAYLOAD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Zero-filled Data payloads that are not stored in ns-3 packets
+ *
+ * Applications that only need the size of the payload (e.g., Producer) set the Content of Data
+ * to a shared buffer of zeros returned by GetBuffer, instead of allocating and zeroing a buffer
+ * for every Data.
+ *
+ * When a Data (bare or in an NDNLP packet) with a zero-filled Content of at least MIN_SIZE bytes
+ * is sent to a NetDevice, the Content value becomes the zero area of the ns-3 packet
+ * (see BlockHeader::CreatePacket): it counts in the packet size, transmission time, and queue
+ * lengths, but is neither allocated nor copied by ns-3.  The bytes are materialized only when
+ * the packet is received and decoded by the next NFD.
+ */
+class VirtualPayload {
+public:
+  /**
+   * @brief Smallest zero-filled Content that is not stored in ns-3 packets
+   */
+  static const size_t MIN_SIZE = 64;
+
+  /**
+   * @brief Get buffer of @p size zeros, shared by all callers asking for the same size
+   */
+  static ::ndn::ConstBufferPtr
+  GetBuffer(size_t size);
+
+  /**
+   * @brief Locate zero-filled Content value of at least MIN_SIZE bytes in @p packet
+   *
+   * @param packet Data or NDNLP packet with a complete Data in its fragment
+   * @param[out] offset Offset of the Content value in the wire encoding of @p packet
+   * @param[out] length Length of the Content value
+   * @return whether such Content was found
+   */
+  static bool
+  Find(const Block& packet, size_t& offset, size_t& length);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_VIRTUAL_PAYLOAD_H
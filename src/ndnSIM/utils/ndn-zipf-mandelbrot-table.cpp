@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-mandelbrot-table.hpp"
+
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace ns3 {
+namespace ndn {
+
+shared_ptr<const ZipfMandelbrotTable>
+ZipfMandelbrotTable::Get(uint32_t n, double q, double s)
+{
+  static std::map<std::tuple<uint32_t, double, double>, std::weak_ptr<const ZipfMandelbrotTable>>
+    s_tables;
+
+  std::weak_ptr<const ZipfMandelbrotTable>& cached = s_tables[std::make_tuple(n, q, s)];
+  shared_ptr<const ZipfMandelbrotTable> table = cached.lock();
+  if (table == nullptr) {
+    table = make_shared<ZipfMandelbrotTable>(n, q, s);
+    cached = table;
+  }
+  return table;
+}
+
+ZipfMandelbrotTable::ZipfMandelbrotTable(uint32_t n, double q, double s)
+  : m_q(q)
+  , m_s(s)
+  , m_sum(0)
+  , m_threshold(n)
+  , m_alias(n)
+{
+  for (uint32_t k = 1; k <= n; k++) {
+    m_sum += 1.0 / std::pow(k + q, s);
+  }
+
+  // probabilities scaled by N: columns below 1 are filled up by aliases of columns above 1
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t i = 0; i < n; i++) {
+    m_threshold[i] = n * GetProbability(i + 1);
+    (m_threshold[i] < 1.0 ? small : large).push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    small.pop_back();
+    uint32_t more = large.back();
+
+    m_alias[less] = more;
+    m_threshold[more] -= 1.0 - m_threshold[less];
+    if (m_threshold[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // remaining columns are full (up to rounding errors)
+  for (uint32_t i : small) {
+    m_threshold[i] = 1.0;
+    m_alias[i] = i;
+  }
+  for (uint32_t i : large) {
+    m_threshold[i] = 1.0;
+    m_alias[i] = i;
+  }
+}
+
+double
+ZipfMandelbrotTable::GetProbability(uint32_t rank) const
+{
+  return 1.0 / std::pow(rank + m_q, m_s) / m_sum;
+}
+
+} // namespace ndn
+} // namespace ns3
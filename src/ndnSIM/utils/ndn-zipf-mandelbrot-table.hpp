@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ZIPF_MANDELBROT_TABLE_H
+#define NDN_ZIPF_MANDELBROT_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Alias table for sampling ranks from a Zipf-Mandelbrot distribution in constant time
+ *
+ * Rank k in [1, N] has probability proportional to 1 / (k + q)^s.  The table (Vose's alias
+ * method) has one column per rank: a uniform number selects a column, and its fractional part
+ * selects either the rank of the column or the alias of the column.  Building the table takes
+ * O(N) time and 12 bytes per rank; tables are immutable and shared by all users with identical
+ * parameters, see Get().
+ */
+class ZipfMandelbrotTable : boost::noncopyable {
+public:
+  /**
+   * @brief Get table for the parameters, shared with all other users of the same parameters
+   */
+  static shared_ptr<const ZipfMandelbrotTable>
+  Get(uint32_t n, double q, double s);
+
+  ZipfMandelbrotTable(uint32_t n, double q, double s);
+
+  uint32_t
+  GetN() const
+  {
+    return m_threshold.size();
+  }
+
+  /**
+   * @brief Map uniform random number in [0, 1) to a rank in [1, N]
+   */
+  uint32_t
+  Sample(double uniform) const
+  {
+    if (m_threshold.empty()) {
+      return 1;
+    }
+
+    double position = uniform * m_threshold.size();
+    uint32_t column = std::min(static_cast<uint32_t>(position), GetN() - 1);
+    if (position - column < m_threshold[column]) {
+      return column + 1;
+    }
+    return m_alias[column] + 1;
+  }
+
+  /**
+   * @brief Get probability of rank in [1, N]
+   */
+  double
+  GetProbability(uint32_t rank) const;
+
+private:
+  double m_q;
+  double m_s;
+  double m_sum; ///< @brief sum of 1 / (k + q)^s over all ranks
+
+  std::vector<double> m_threshold;
+  std::vector<uint32_t> m_alias;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ZIPF_MANDELBROT_TABLE_H
@@ -43,6 +43,7 @@
 #include "ns3/double.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-partition-helper.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -69,6 +70,8 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_isPartitioned(false)
+  , m_nPartitions(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -138,6 +141,13 @@ AnnotatedTopologyReader::CreateNode(const std::string name, double posX, double
   return node;
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions)
+{
+  m_isPartitioned = true;
+  m_nPartitions = nPartitions;
+}
+
 NodeContainer
 AnnotatedTopologyReader::GetNodes() const
 {
@@ -174,6 +184,14 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct NodeLine {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<NodeLine> nodeLines;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -191,33 +209,68 @@ AnnotatedTopologyReader::Read(void)
     if (name.empty())
       continue;
 
-    Ptr<Node> node;
+    nodeLines.push_back({name, latitude, longitude, systemId});
+  }
+
+  bool hasLinks = !topgen.eof();
+
+  vector<string> linkLines;
+  while (!topgen.eof()) {
+    string line;
+    getline(topgen, line);
+    if (line == "")
+      continue;
+    if (line[0] == '#')
+      continue; // comments
+
+    linkLines.push_back(line);
+  }
 
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
+  if (m_isPartitioned) {
+    // system IDs of the file are replaced by automatically computed partitions
+    ndn::PartitionHelper partitioner;
+    for (NodeLine& node : nodeLines) {
+      partitioner.AddNode(node.name);
+    }
+    for (const string& line : linkLines) {
+      istringstream lineBuffer(line);
+      string from, to, capacity, metric, delay;
+      lineBuffer >> from >> to >> capacity >> metric >> delay;
+      partitioner.AddLink(from, to, delay.empty() ? Time(0) : Time(delay));
+    }
+
+    uint32_t nPartitions = m_nPartitions;
+#ifdef NS3_MPI
+    if (nPartitions == 0 && MpiInterface::IsEnabled()) {
+      nPartitions = MpiInterface::GetSize();
+    }
+#endif
+    partitioner.Partition(nPartitions);
+    for (NodeLine& node : nodeLines) {
+      node.systemId = partitioner.GetPartition(node.name);
+    }
+    m_requiredPartitions = std::max<uint32_t>(nPartitions, 1);
+  }
+
+  for (const NodeLine& node : nodeLines) {
+    if (abs(node.latitude) > 0.001 && abs(node.latitude) > 0.001)
+      CreateNode(node.name, m_scale * node.longitude, -m_scale * node.latitude, node.systemId);
     else {
       Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
+      CreateNode(node.name, var->GetValue(0, 200), var->GetValue(0, 200), node.systemId);
       // node = CreateNode (name, systemId);
     }
   }
 
   map<string, set<string>> processedLinks; // to eliminate duplications
 
-  if (topgen.eof()) {
+  if (!hasLinks) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
     return m_nodes;
   }
 
   // SeekToSection ("link");
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line == "")
-      continue;
-    if (line[0] == '#')
-      continue; // comments
-
+  for (const string& line : linkLines) {
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
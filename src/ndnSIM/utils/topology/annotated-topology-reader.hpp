@@ -56,6 +56,18 @@ public:
   virtual NodeContainer
   Read();
 
+  /**
+   * \brief Assign nodes to partitions (system IDs) automatically when reading the topology
+   *
+   * System IDs in the file are ignored.  Nodes are assigned by ndn::PartitionHelper so that
+   * links between partitions have the largest possible delay, which is the lookahead of the
+   * distributed simulator.
+   *
+   * \param nPartitions Number of partitions, 0 for the number of MPI processes
+   */
+  void
+  SetPartitions(uint32_t nPartitions = 0);
+
   /**
    * \brief Get nodes read by the reader
    */
@@ -147,6 +159,8 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  bool m_isPartitioned;
+  uint32_t m_nPartitions;
 };
 }
 
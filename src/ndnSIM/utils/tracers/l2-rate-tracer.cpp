@@ -28,8 +28,12 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 
+#include "ndn-columnar-trace.hpp"
+#include "ndn-trace-writer-thread.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
@@ -49,7 +53,15 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 {
   std::list<Ptr<L2RateTracer>> tracers;
   std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  std::shared_ptr<ndn::ColumnarTraceWriter> writer;
+  if (ndn::ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ndn::ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     std::shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -58,7 +70,7 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
       return;
     }
 
-    outputStream = os;
+    outputStream = ndn::TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
@@ -69,13 +81,19 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 
     Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
     trace->SetAveragingPeriod(averagingPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -104,7 +122,12 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    PrintRecords(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
@@ -132,6 +155,20 @@ L2RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+void
+L2RateTracer::WriteSchema(ndn::ColumnarTraceWriter& writer) const
+{
+  using ndn::ColumnarTraceWriter;
+
+  std::ostringstream header;
+  PrintHeader(header);
+  writer.WriteSchema("L2RateTracer", header.str(),
+                     {ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::STRING, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::INT64, ColumnarTraceWriter::INT64,
+                      ColumnarTraceWriter::INT64, ColumnarTraceWriter::FLOAT64});
+}
+
 void
 L2RateTracer::Reset()
 {
@@ -150,12 +187,20 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  os << time.ToDouble(Time::S) << m_node << interface << printName << STATS(2).fieldName           \
+     << STATS(3).fieldName << STATS(0).fieldName << STATS(1).fieldName / 1024.0;                   \
+  os.EndRow();
 
 void
 L2RateTracer::Print(std::ostream& os) const
+{
+  ndn::TextTraceOutput output(os);
+  PrintRecords(output);
+}
+
+template<class Output>
+void
+L2RateTracer::PrintRecords(Output& os) const
 {
   Time time = Simulator::Now();
 
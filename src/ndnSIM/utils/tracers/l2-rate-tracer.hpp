@@ -30,6 +30,10 @@
 
 namespace ns3 {
 
+namespace ndn {
+class ColumnarTraceWriter;
+} // namespace ndn
+
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
@@ -47,7 +51,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written
+   * @param file File to which traces will be written.  If filename ends with .bin (or .bin.gz
+   *             for gzip), the trace is written in binary columnar format, see
+   *             ndn::ColumnarTraceWriter
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -85,11 +91,19 @@ private:
   void
   PeriodicPrinter();
 
+  template<class Output>
+  void
+  PrintRecords(Output& os) const;
+
+  void
+  WriteSchema(ndn::ColumnarTraceWriter& writer) const;
+
   void
   Reset();
 
 private:
   std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::ColumnarTraceWriter> m_writer;
   Time m_period;
   EventId m_printEvent;
 
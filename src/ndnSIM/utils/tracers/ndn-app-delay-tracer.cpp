@@ -29,10 +29,14 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ndn-columnar-trace.hpp"
+#include "ndn-trace-writer-thread.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
@@ -49,14 +53,22 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -65,35 +77,50 @@ AppDelayTracer::InstallAll(const std::string& file)
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, aggregationPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -102,35 +129,50 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, aggregationPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -139,30 +181,40 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = Install(node, outputStream, aggregationPeriod);
+  trace->m_writer = writer;
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 Ptr<AppDelayTracer>
-AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time aggregationPeriod /* = Seconds(0)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  if (!aggregationPeriod.IsZero()) {
+    trace->SetAggregationPeriod(aggregationPeriod);
+  }
 
   return trace;
 }
@@ -192,7 +244,10 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& n
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -206,9 +261,61 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+void
+AppDelayTracer::SetAggregationPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  if (m_writer != nullptr) {
+    PrintAggregates(*m_writer);
+  }
+  else {
+    TextTraceOutput output(*m_os);
+    PrintAggregates(output);
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (!m_period.IsZero()) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Prefix"
+       << "\t"
+
+       << "Type"
+       << "\t"
+       << "Count"
+       << "\t"
+       << "MeanUS"
+       << "\t"
+       << "MinUS"
+       << "\t"
+       << "P50US"
+       << "\t"
+       << "P90US"
+       << "\t"
+       << "P99US"
+       << "\t"
+       << "P999US"
+       << "\t"
+       << "MaxUS";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -230,26 +337,111 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+void
+AppDelayTracer::WriteSchema(ColumnarTraceWriter& writer) const
+{
+  std::ostringstream header;
+  PrintHeader(header);
+  if (!m_period.IsZero()) {
+    writer.WriteSchema("AppDelayTracer", header.str(),
+                       {ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::STRING,
+                        ColumnarTraceWriter::INT64, ColumnarTraceWriter::STRING,
+                        ColumnarTraceWriter::STRING, ColumnarTraceWriter::INT64,
+                        ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::FLOAT64,
+                        ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::FLOAT64,
+                        ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::FLOAT64,
+                        ColumnarTraceWriter::FLOAT64});
+    return;
+  }
+  writer.WriteSchema("AppDelayTracer", header.str(),
+                     {ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::INT64, ColumnarTraceWriter::INT64,
+                      ColumnarTraceWriter::STRING, ColumnarTraceWriter::FLOAT64,
+                      ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::INT64,
+                      ColumnarTraceWriter::INT64});
+}
+
+template<class Output>
+void
+AppDelayTracer::PrintRecord(Output& os, Ptr<App> app, uint32_t seqno, const char* type, Time delay,
+                            uint32_t retxCount, int32_t hopCount)
+{
+  os << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno << type
+     << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << retxCount << hopCount;
+  os.EndRow();
+}
+
+AppDelayTracer::AppDelays&
+AppDelayTracer::GetAppDelays(Ptr<App> app)
+{
+  auto i = m_appDelays.find(app->GetId());
+  if (i == m_appDelays.end()) {
+    NameValue prefix;
+    i = m_appDelays.insert(std::make_pair(app->GetId(), AppDelays())).first;
+    i->second.prefix = app->GetAttributeFailSafe("Prefix", prefix) ? prefix.Get().toUri() : "-";
+  }
+  return i->second;
+}
+
+#define PRINTER(printName, fieldName)                                                              \
+  if (delays.second.fieldName.GetCount() > 0) {                                                    \
+    const DelayHistogram& histogram = delays.second.fieldName;                                     \
+    os << time.ToDouble(Time::S) << m_node << delays.first << delays.second.prefix << printName    \
+       << histogram.GetCount() << histogram.GetMean().ToDouble(Time::US)                           \
+       << histogram.GetMin().ToDouble(Time::US) << histogram.GetQuantile(0.5).ToDouble(Time::US)   \
+       << histogram.GetQuantile(0.9).ToDouble(Time::US)                                            \
+       << histogram.GetQuantile(0.99).ToDouble(Time::US)                                           \
+       << histogram.GetQuantile(0.999).ToDouble(Time::US)                                          \
+       << histogram.GetMax().ToDouble(Time::US);                                                   \
+    os.EndRow();                                                                                   \
+    delays.second.fieldName.Reset();                                                               \
+  }
+
+template<class Output>
+void
+AppDelayTracer::PrintAggregates(Output& os)
+{
+  Time time = Simulator::Now();
+
+  for (auto& delays : m_appDelays) {
+    PRINTER("LastDelay", lastDelay);
+    PRINTER("FullDelay", fullDelay);
+  }
+}
+
+void
+AppDelayTracer::PrintRecord(Ptr<App> app, uint32_t seqno, const char* type, Time delay,
+                            uint32_t retxCount, int32_t hopCount)
+{
+  if (m_writer != nullptr) {
+    PrintRecord(*m_writer, app, seqno, type, delay, retxCount, hopCount);
+  }
+  else {
+    TextTraceOutput output(*m_os);
+    PrintRecord(output, app, seqno, type, delay, retxCount, hopCount);
+  }
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (!m_period.IsZero()) {
+    GetAppDelays(app).lastDelay.Add(delay);
+    return;
+  }
+  PrintRecord(app, seqno, "LastDelay", delay, 1, hopCount);
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (!m_period.IsZero()) {
+    GetAppDelays(app).fullDelay.Add(delay);
+    return;
+  }
+  PrintRecord(app, seqno, "FullDelay", delay, retxCount, hopCount);
 }
 
 } // namespace ndn
@@ -22,6 +22,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-delay-histogram.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +32,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -39,6 +42,7 @@ class Packet;
 namespace ndn {
 
 class App;
+class ColumnarTraceWriter;
 
 /**
  * @ingroup ndn-tracers
@@ -49,47 +53,61 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
+   * @param aggregationPeriod If not zero, delays are aggregated in a DelayHistogram per
+   *        application and type of delay, and their percentiles are written every period instead
+   *        of one record per received Data
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
+   * @param aggregationPeriod If not zero, delays are aggregated in a DelayHistogram per
+   *        application and type of delay, and their percentiles are written every period instead
+   *        of one record per received Data
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
+   * @param aggregationPeriod If not zero, delays are aggregated in a DelayHistogram per
+   *        application and type of delay, and their percentiles are written every period instead
+   *        of one record per received Data
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param outputStream Smart pointer to a stream
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param aggregationPeriod If not zero, delays are aggregated in a DelayHistogram per
+   *        application and type of delay, and their percentiles are written every period instead
+   *        of one record per received Data
    *
    * @returns a tuple of reference to output stream and list of tracers.
    *          !!! Attention !!! This tuple needs to be preserved for the lifetime of simulation,
    *          otherwise SEGFAULTs are inevitable
    */
   static Ptr<AppDelayTracer>
-  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+          Time aggregationPeriod = Seconds(0));
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -138,11 +156,49 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  template<class Output>
+  void
+  PrintRecord(Output& os, Ptr<App> app, uint32_t seqno, const char* type, Time delay,
+              uint32_t retxCount, int32_t hopCount);
+
+  void
+  PrintRecord(Ptr<App> app, uint32_t seqno, const char* type, Time delay, uint32_t retxCount,
+              int32_t hopCount);
+
+  void
+  WriteSchema(ColumnarTraceWriter& writer) const;
+
+  void
+  SetAggregationPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
+  template<class Output>
+  void
+  PrintAggregates(Output& os);
+
+  struct AppDelays;
+
+  AppDelays&
+  GetAppDelays(Ptr<App> app);
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<ColumnarTraceWriter> m_writer;
+
+  Time m_period;
+  EventId m_printEvent;
+
+  struct AppDelays {
+    std::string prefix;
+    DelayHistogram lastDelay;
+    DelayHistogram fullDelay;
+  };
+  std::map<uint32_t, AppDelays> m_appDelays;
 };
 
 } // namespace ndn
@@ -0,0 +1,374 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-columnar-trace.hpp"
+#include "ndn-trace-writer-thread.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ColumnarTrace");
+
+namespace ns3 {
+namespace ndn {
+
+namespace io = boost::iostreams;
+
+static const char COLUMNAR_TRACE_MAGIC[4] = {'N', 'D', 'N', 'T'};
+static const uint32_t COLUMNAR_TRACE_VERSION = 1;
+
+const size_t ColumnarTraceWriter::BLOCK_SIZE;
+
+template<typename T>
+static void
+writeValue(std::ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void
+writeString(std::ostream& os, const std::string& value)
+{
+  writeValue<uint32_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+template<typename T>
+static bool
+readValue(std::istream& is, T& value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+static bool
+readString(std::istream& is, std::string& value)
+{
+  uint32_t size;
+  if (!readValue(is, size)) {
+    return false;
+  }
+  value.resize(size);
+  return size == 0 || static_cast<bool>(is.read(&value[0], size));
+}
+
+bool
+ColumnarTraceWriter::IsColumnarFile(const std::string& file)
+{
+  return boost::algorithm::ends_with(file, ".bin") || boost::algorithm::ends_with(file, ".bin.gz");
+}
+
+shared_ptr<ColumnarTraceWriter>
+ColumnarTraceWriter::Open(const std::string& file)
+{
+  if (boost::algorithm::ends_with(file, ".gz")) {
+    io::file_sink sink(file, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!sink.is_open()) {
+      return nullptr;
+    }
+
+    auto os = make_shared<io::filtering_ostream>();
+    os->push(io::gzip_compressor());
+    os->push(sink);
+    return make_shared<ColumnarTraceWriter>(TraceWriterThread::Wrap(os, false));
+  }
+
+  auto os = make_shared<std::ofstream>(file.c_str(), std::ios_base::out | std::ios_base::trunc
+                                                       | std::ios_base::binary);
+  if (!os->is_open()) {
+    return nullptr;
+  }
+  return make_shared<ColumnarTraceWriter>(TraceWriterThread::Wrap(os, false));
+}
+
+ColumnarTraceWriter::ColumnarTraceWriter(shared_ptr<std::ostream> os)
+  : m_os(os)
+  , m_column(0)
+  , m_rows(0)
+{
+}
+
+ColumnarTraceWriter::~ColumnarTraceWriter()
+{
+  Flush();
+  m_os->flush();
+}
+
+void
+ColumnarTraceWriter::WriteSchema(const std::string& tracer, const std::string& textHeader,
+                                 const std::vector<ColumnType>& types)
+{
+  NS_ASSERT_MSG(m_columns.empty(), "Schema has already been written");
+
+  std::istringstream names(textHeader);
+  std::string name;
+  while (std::getline(names, name, '\t')) {
+    if (!name.empty()) {
+      m_columns.push_back({name, ColumnType(0)});
+    }
+  }
+  NS_ASSERT_MSG(m_columns.size() == types.size(), "Every column in " << tracer
+                << " text header needs a type");
+  for (size_t i = 0; i < types.size(); i++) {
+    m_columns[i].type = types[i];
+  }
+  m_values.resize(m_columns.size());
+  for (auto& values : m_values) {
+    values.reserve(BLOCK_SIZE);
+  }
+
+  m_os->write(COLUMNAR_TRACE_MAGIC, sizeof(COLUMNAR_TRACE_MAGIC));
+  writeValue(*m_os, COLUMNAR_TRACE_VERSION);
+  writeString(*m_os, tracer);
+  writeString(*m_os, textHeader);
+  writeValue<uint32_t>(*m_os, m_columns.size());
+  for (const auto& column : m_columns) {
+    writeValue<uint8_t>(*m_os, column.type);
+    writeString(*m_os, column.name);
+  }
+}
+
+void
+ColumnarTraceWriter::Append(ColumnType type, uint64_t value)
+{
+  NS_ASSERT_MSG(m_column < m_columns.size(), "Too many values in a row");
+  NS_ASSERT_MSG(m_columns[m_column].type == type, "Wrong type of column "
+                << m_columns[m_column].name);
+  m_values[m_column++].push_back(value);
+}
+
+ColumnarTraceWriter&
+ColumnarTraceWriter::operator<<(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  Append(FLOAT64, bits);
+  return *this;
+}
+
+ColumnarTraceWriter&
+ColumnarTraceWriter::operator<<(int64_t value)
+{
+  Append(INT64, static_cast<uint64_t>(value));
+  return *this;
+}
+
+ColumnarTraceWriter&
+ColumnarTraceWriter::operator<<(const std::string& value)
+{
+  auto string = m_strings.insert(std::make_pair(value, m_strings.size()));
+  if (string.second) {
+    m_newStrings.push_back(&string.first->first);
+  }
+  Append(STRING, string.first->second);
+  return *this;
+}
+
+void
+ColumnarTraceWriter::EndRow()
+{
+  NS_ASSERT_MSG(m_column == m_columns.size(), "Not all columns were written");
+  m_column = 0;
+  if (++m_rows == BLOCK_SIZE) {
+    Flush();
+  }
+}
+
+void
+ColumnarTraceWriter::Flush()
+{
+  if (m_rows == 0) {
+    return;
+  }
+
+  writeValue<uint32_t>(*m_os, m_rows);
+  writeValue<uint32_t>(*m_os, m_newStrings.size());
+  for (const std::string* string : m_newStrings) {
+    writeString(*m_os, *string);
+  }
+  m_newStrings.clear();
+
+  std::vector<uint32_t> indexes;
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    std::vector<uint64_t>& values = m_values[i];
+    if (m_columns[i].type == STRING) {
+      indexes.assign(values.begin(), values.end());
+      m_os->write(reinterpret_cast<const char*>(indexes.data()), indexes.size() * sizeof(uint32_t));
+    }
+    else {
+      m_os->write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(uint64_t));
+    }
+    values.clear();
+  }
+  m_rows = 0;
+}
+
+bool
+ColumnarTraceReader::Open(const std::string& file)
+{
+  if (boost::algorithm::ends_with(file, ".gz")) {
+    io::file_source source(file, std::ios_base::in | std::ios_base::binary);
+    if (!source.is_open()) {
+      return false;
+    }
+
+    auto is = make_shared<io::filtering_istream>();
+    is->push(io::gzip_decompressor());
+    is->push(source);
+    m_is = is;
+  }
+  else {
+    auto is = make_shared<std::ifstream>(file.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!is->is_open()) {
+      return false;
+    }
+    m_is = is;
+  }
+
+  char magic[sizeof(COLUMNAR_TRACE_MAGIC)];
+  uint32_t version;
+  uint32_t nColumns;
+  if (!m_is->read(magic, sizeof(magic)) || !readValue(*m_is, version)
+      || std::memcmp(magic, COLUMNAR_TRACE_MAGIC, sizeof(magic)) != 0
+      || version != COLUMNAR_TRACE_VERSION || !readString(*m_is, m_tracer)
+      || !readString(*m_is, m_textHeader) || !readValue(*m_is, nColumns)) {
+    return false;
+  }
+
+  m_columns.resize(nColumns);
+  for (auto& column : m_columns) {
+    uint8_t type;
+    if (!readValue(*m_is, type) || !readString(*m_is, column.name)) {
+      return false;
+    }
+    column.type = static_cast<ColumnarTraceWriter::ColumnType>(type);
+  }
+  m_values.resize(nColumns);
+  m_strings.clear();
+  m_rows = 0;
+  return true;
+}
+
+bool
+ColumnarTraceReader::ReadBlock()
+{
+  uint32_t nRows;
+  uint32_t nNewStrings;
+  m_rows = 0;
+  if (!readValue(*m_is, nRows) || !readValue(*m_is, nNewStrings)) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < nNewStrings; i++) {
+    m_strings.emplace_back();
+    if (!readString(*m_is, m_strings.back())) {
+      return false;
+    }
+  }
+
+  std::vector<uint32_t> indexes(nRows);
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    std::vector<uint64_t>& values = m_values[i];
+    values.resize(nRows);
+    if (m_columns[i].type == ColumnarTraceWriter::STRING) {
+      if (!m_is->read(reinterpret_cast<char*>(indexes.data()), nRows * sizeof(uint32_t))) {
+        return false;
+      }
+      values.assign(indexes.begin(), indexes.end());
+    }
+    else if (!m_is->read(reinterpret_cast<char*>(values.data()), nRows * sizeof(uint64_t))) {
+      return false;
+    }
+  }
+
+  m_rows = nRows;
+  return true;
+}
+
+double
+ColumnarTraceReader::GetDouble(size_t column, size_t row) const
+{
+  NS_ASSERT(m_columns[column].type == ColumnarTraceWriter::FLOAT64);
+  double value;
+  std::memcpy(&value, &m_values[column][row], sizeof(value));
+  return value;
+}
+
+int64_t
+ColumnarTraceReader::GetInt(size_t column, size_t row) const
+{
+  NS_ASSERT(m_columns[column].type == ColumnarTraceWriter::INT64);
+  return static_cast<int64_t>(m_values[column][row]);
+}
+
+const std::string&
+ColumnarTraceReader::GetString(size_t column, size_t row) const
+{
+  NS_ASSERT(m_columns[column].type == ColumnarTraceWriter::STRING);
+  return m_strings.at(m_values[column][row]);
+}
+
+void
+ColumnarTraceReader::PrintBlock(std::ostream& os) const
+{
+  TextTraceOutput output(os);
+  for (size_t row = 0; row < m_rows; row++) {
+    for (size_t column = 0; column < m_columns.size(); column++) {
+      switch (m_columns[column].type) {
+      case ColumnarTraceWriter::FLOAT64:
+        output << GetDouble(column, row);
+        break;
+      case ColumnarTraceWriter::INT64:
+        output << GetInt(column, row);
+        break;
+      case ColumnarTraceWriter::STRING:
+        output << GetString(column, row);
+        break;
+      }
+    }
+    output.EndRow();
+  }
+}
+
+bool
+ColumnarTraceReader::ConvertToText(const std::string& file, std::ostream& os)
+{
+  ColumnarTraceReader reader;
+  if (!reader.Open(file)) {
+    NS_LOG_ERROR(file << " is not a columnar trace of a supported version");
+    return false;
+  }
+
+  os << reader.GetTextHeader() << "\n";
+  while (reader.ReadBlock()) {
+    reader.PrintBlock(os);
+  }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_COLUMNAR_TRACE_H
+#define NDN_COLUMNAR_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writes tracer records as tab-separated text (the default tracer output)
+ *
+ * Has the same record interface as ColumnarTraceWriter, so that tracers format their records
+ * once for both outputs.
+ */
+class TextTraceOutput {
+public:
+  explicit TextTraceOutput(std::ostream& os)
+    : m_os(os)
+    , m_isFirst(true)
+  {
+  }
+
+  template<typename T>
+  TextTraceOutput&
+  operator<<(const T& value)
+  {
+    if (!m_isFirst) {
+      m_os << "\t";
+    }
+    m_os << value;
+    m_isFirst = false;
+    return *this;
+  }
+
+  void
+  EndRow()
+  {
+    m_os << "\n";
+    m_isFirst = true;
+  }
+
+private:
+  std::ostream& m_os;
+  bool m_isFirst;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writes tracer records in a binary columnar format
+ *
+ * Tracers use this writer instead of text output when the trace file name ends with ".bin"
+ * (or ".bin.gz" for a gzip-compressed trace).  The file starts with a schema header (magic
+ * "NDNT", format version, tracer name, text header line of the tracer and name and type of
+ * every column), followed by blocks of up to BLOCK_SIZE records.  Every block holds the number
+ * of records, strings first used in the block, and one array of fixed-width values per column:
+ * FLOAT64 and INT64 values take 8 bytes, STRING values are 4-byte indexes into the string
+ * dictionary of the file.  All fields are stored in host byte order.
+ *
+ * ColumnarTraceReader reads the files back, see examples/ndn-trace-to-text.cpp for a converter
+ * to the text format of the tracers.
+ */
+class ColumnarTraceWriter {
+public:
+  enum ColumnType : uint8_t {
+    FLOAT64 = 1,
+    INT64 = 2,
+    STRING = 3
+  };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  static const size_t BLOCK_SIZE = 4096;
+
+  /**
+   * @brief Check whether the tracer output file name selects columnar output
+   */
+  static bool
+  IsColumnarFile(const std::string& file);
+
+  /**
+   * @brief Create writer for the file, compressed if file name ends with ".gz"
+   * @returns nullptr if file cannot be opened for writing
+   */
+  static shared_ptr<ColumnarTraceWriter>
+  Open(const std::string& file);
+
+  explicit
+  ColumnarTraceWriter(shared_ptr<std::ostream> os);
+
+  /**
+   * @brief Write remaining records and close the stream
+   */
+  ~ColumnarTraceWriter();
+
+  /**
+   * @brief Write schema header, must be called once before the first record
+   *
+   * @param tracer     Name of the tracer
+   * @param textHeader Header line of the text output (tab-separated column names)
+   * @param types      Type of each column in the header line
+   */
+  void
+  WriteSchema(const std::string& tracer, const std::string& textHeader,
+              const std::vector<ColumnType>& types);
+
+  ColumnarTraceWriter&
+  operator<<(double value);
+
+  ColumnarTraceWriter&
+  operator<<(int64_t value);
+
+  ColumnarTraceWriter&
+  operator<<(const std::string& value);
+
+  ColumnarTraceWriter&
+  operator<<(const char* value)
+  {
+    return *this << std::string(value);
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value, ColumnarTraceWriter&>::type
+  operator<<(T value)
+  {
+    return *this << static_cast<int64_t>(value);
+  }
+
+  /**
+   * @brief Finish current record, all columns must have been written
+   */
+  void
+  EndRow();
+
+  /**
+   * @brief Write buffered records as a block
+   */
+  void
+  Flush();
+
+private:
+  void
+  Append(ColumnType type, uint64_t value);
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<Column> m_columns;
+  std::vector<std::vector<uint64_t>> m_values;
+  size_t m_column;
+  size_t m_rows;
+
+  std::unordered_map<std::string, uint32_t> m_strings;
+  std::vector<const std::string*> m_newStrings;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reads traces written by ColumnarTraceWriter block by block
+ */
+class ColumnarTraceReader {
+public:
+  /**
+   * @brief Open trace file (compressed if file name ends with ".gz") and read its schema
+   * @returns false if file cannot be opened or is not a columnar trace of a supported version
+   */
+  bool
+  Open(const std::string& file);
+
+  const std::string&
+  GetTracer() const
+  {
+    return m_tracer;
+  }
+
+  const std::string&
+  GetTextHeader() const
+  {
+    return m_textHeader;
+  }
+
+  const std::vector<ColumnarTraceWriter::Column>&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Read next block of records
+   * @returns false at the end of the trace
+   */
+  bool
+  ReadBlock();
+
+  size_t
+  GetRowCount() const
+  {
+    return m_rows;
+  }
+
+  double
+  GetDouble(size_t column, size_t row) const;
+
+  int64_t
+  GetInt(size_t column, size_t row) const;
+
+  const std::string&
+  GetString(size_t column, size_t row) const;
+
+  /**
+   * @brief Print records of the current block in the text format of the tracer
+   */
+  void
+  PrintBlock(std::ostream& os) const;
+
+  /**
+   * @brief Convert columnar trace to the text format of the tracer
+   * @returns false if file cannot be read
+   */
+  static bool
+  ConvertToText(const std::string& file, std::ostream& os);
+
+private:
+  shared_ptr<std::istream> m_is;
+  std::string m_tracer;
+  std::string m_textHeader;
+  std::vector<ColumnarTraceWriter::Column> m_columns;
+  std::vector<std::vector<uint64_t>> m_values;
+  std::vector<std::string> m_strings;
+  size_t m_rows = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_COLUMNAR_TRACE_H
@@ -30,9 +30,13 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ndn-columnar-trace.hpp"
+#include "ndn-trace-writer-thread.hpp"
+
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
@@ -55,7 +59,15 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -64,7 +76,7 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
@@ -72,13 +84,19 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -93,7 +111,15 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -102,7 +128,7 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
@@ -110,13 +136,19 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -131,7 +163,15 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
 
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -140,19 +180,25 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
   Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  trace->m_writer = writer;
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -218,7 +264,12 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    PrintRecords(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -239,6 +290,16 @@ CsTracer::PrintHeader(std::ostream& os) const
      << "\t";
 }
 
+void
+CsTracer::WriteSchema(ColumnarTraceWriter& writer) const
+{
+  std::ostringstream header;
+  PrintHeader(header);
+  writer.WriteSchema("CsTracer", header.str(),
+                     {ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::STRING, ColumnarTraceWriter::FLOAT64});
+}
+
 void
 CsTracer::Reset()
 {
@@ -246,11 +307,19 @@ CsTracer::Reset()
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  os << time.ToDouble(Time::S) << m_node << printName << m_stats.fieldName;                        \
+  os.EndRow();
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  TextTraceOutput output(os);
+  PrintRecords(output);
+}
+
+template<class Output>
+void
+CsTracer::PrintRecords(Output& os) const
 {
   Time time = Simulator::Now();
 
@@ -39,6 +39,8 @@ class Packet;
 
 namespace ndn {
 
+class ColumnarTraceWriter;
+
 namespace cs {
 
 /// @cond include_hidden
@@ -64,7 +66,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -80,7 +84,9 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -96,7 +102,9 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -188,11 +196,19 @@ private:
   void
   PeriodicPrinter();
 
+  template<class Output>
+  void
+  PrintRecords(Output& os) const;
+
+  void
+  WriteSchema(ColumnarTraceWriter& writer) const;
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<ColumnarTraceWriter> m_writer;
 
   Time m_period;
   EventId m_printEvent;
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-delay-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+const size_t DelayHistogram::SUB_BUCKET_BITS;
+
+static const uint64_t SUB_BUCKET_COUNT = uint64_t(1) << DelayHistogram::SUB_BUCKET_BITS;
+
+DelayHistogram::DelayHistogram()
+{
+  Reset();
+}
+
+size_t
+DelayHistogram::getIndex(uint64_t value)
+{
+  if (value < SUB_BUCKET_COUNT) {
+    return value;
+  }
+
+  // value = mantissa * 2^exponent with mantissa in [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT)
+  size_t exponent = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+  return exponent * SUB_BUCKET_COUNT + (value >> exponent);
+}
+
+uint64_t
+DelayHistogram::getLowerBound(size_t index)
+{
+  if (index < SUB_BUCKET_COUNT) {
+    return index;
+  }
+
+  size_t exponent = index / SUB_BUCKET_COUNT - 1;
+  uint64_t mantissa = index - exponent * SUB_BUCKET_COUNT;
+  return mantissa << exponent;
+}
+
+void
+DelayHistogram::Add(Time delay)
+{
+  int64_t ns = std::max<int64_t>(delay.GetNanoSeconds(), 0);
+  size_t index = getIndex((ns + 500) / 1000);
+  if (index >= m_buckets.size()) {
+    m_buckets.resize(index + 1, 0);
+  }
+  m_buckets[index]++;
+
+  m_count++;
+  m_min = std::min(m_min, ns);
+  m_max = std::max(m_max, ns);
+  m_sum += ns;
+}
+
+void
+DelayHistogram::Merge(const DelayHistogram& other)
+{
+  if (other.m_buckets.size() > m_buckets.size()) {
+    m_buckets.resize(other.m_buckets.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_buckets.size(); i++) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+
+  m_count += other.m_count;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+void
+DelayHistogram::Reset()
+{
+  // keep allocated buckets, next period will most likely need them again
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<int64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+Time
+DelayHistogram::GetMin() const
+{
+  return m_count > 0 ? NanoSeconds(m_min) : Time(0);
+}
+
+Time
+DelayHistogram::GetMax() const
+{
+  return NanoSeconds(m_max);
+}
+
+Time
+DelayHistogram::GetMean() const
+{
+  return m_count > 0 ? NanoSeconds(std::llround(m_sum / m_count)) : Time(0);
+}
+
+Time
+DelayHistogram::GetQuantile(double q) const
+{
+  if (m_count == 0) {
+    return Time(0);
+  }
+  if (q <= 0) {
+    return GetMin();
+  }
+  if (q >= 1) {
+    return GetMax();
+  }
+
+  uint64_t rank = std::max<uint64_t>(std::ceil(q * m_count), 1);
+  uint64_t seen = 0;
+  size_t index = 0;
+  for (; index < m_buckets.size(); index++) {
+    seen += m_buckets[index];
+    if (seen >= rank) {
+      break;
+    }
+  }
+
+  uint64_t lower = getLowerBound(index);
+  uint64_t upper = getLowerBound(index + 1);
+  int64_t middle = (lower + upper) * 1000 / 2; // ns
+  return NanoSeconds(std::min(std::max(middle, m_min), m_max));
+}
+
+} // namespace ndn
+} // namespace ns3
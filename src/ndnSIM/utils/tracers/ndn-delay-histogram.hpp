@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DELAY_HISTOGRAM_H
+#define NDN_DELAY_HISTOGRAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming histogram of delays for quantile estimation
+ *
+ * Log-linear (HDR-style) histogram with microsecond resolution: delays below 2^SUB_BUCKET_BITS us
+ * are counted exactly, larger delays in buckets whose width is at most 1/2^SUB_BUCKET_BITS
+ * (0.8%) of their value.  Memory grows with the logarithm of the largest delay (about 1800
+ * counters for delays up to one second), not with the number of delays.  Histograms with the
+ * same resolution can be merged, e.g., to get the distribution over several applications.
+ */
+class DelayHistogram {
+public:
+  static const size_t SUB_BUCKET_BITS = 7;
+
+  DelayHistogram();
+
+  void
+  Add(Time delay);
+
+  void
+  Merge(const DelayHistogram& other);
+
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  Time
+  GetMin() const;
+
+  Time
+  GetMax() const;
+
+  Time
+  GetMean() const;
+
+  /**
+   * @brief Estimate q-quantile of the delays
+   *
+   * Returns the middle of the bucket holding the quantile, clamped to the exact minimum and
+   * maximum (returned for q <= 0 and q >= 1), or zero if the histogram is empty.
+   */
+  Time
+  GetQuantile(double q) const;
+
+private:
+  static size_t
+  getIndex(uint64_t value);
+
+  static uint64_t
+  getLowerBound(size_t index);
+
+private:
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count;
+  int64_t m_min; // ns
+  int64_t m_max; // ns
+  double m_sum;  // ns
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DELAY_HISTOGRAM_H
@@ -26,10 +26,13 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ndn-columnar-trace.hpp"
+#include "ndn-trace-writer-thread.hpp"
 
 #include "daemon/table/pit-entry.hpp"
 
 #include <fstream>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -51,7 +54,15 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -60,7 +71,7 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
@@ -68,13 +79,19 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -89,7 +106,15 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -98,7 +123,7 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
@@ -106,13 +131,19 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    trace->m_writer = writer;
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -127,7 +158,15 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
 
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<ColumnarTraceWriter> writer;
+  if (ColumnarTraceWriter::IsColumnarFile(file)) {
+    writer = ColumnarTraceWriter::Open(file);
+    if (writer == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -136,19 +175,25 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
       return;
     }
 
-    outputStream = os;
+    outputStream = TraceWriterThread::Wrap(os);
   }
   else {
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
   Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  trace->m_writer = writer;
   tracers.push_back(trace);
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    if (writer != nullptr) {
+      tracers.front()->WriteSchema(*writer);
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      tracers.front()->PrintHeader(*outputStream);
+      *outputStream << "\n";
+    }
   }
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
@@ -196,7 +241,12 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    PrintRecords(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -226,6 +276,19 @@ L3RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+void
+L3RateTracer::WriteSchema(ColumnarTraceWriter& writer) const
+{
+  std::ostringstream header;
+  PrintHeader(header);
+  writer.WriteSchema("L3RateTracer", header.str(),
+                     {ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::INT64, ColumnarTraceWriter::STRING,
+                      ColumnarTraceWriter::STRING, ColumnarTraceWriter::FLOAT64,
+                      ColumnarTraceWriter::FLOAT64, ColumnarTraceWriter::FLOAT64,
+                      ColumnarTraceWriter::FLOAT64});
+}
+
 void
 L3RateTracer::Reset()
 {
@@ -246,20 +309,29 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
+  os << time.ToDouble(Time::S) << m_node;                                                          \
   if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
+    os << stats.first;                                                                             \
     NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
+    os << m_faceInfos.find(stats.first)->second;                                                   \
   }                                                                                                \
   else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
+    os << -1 << "all";                                                                             \
   }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  os << printName << STATS(2).fieldName << STATS(3).fieldName << STATS(0).fieldName                \
+     << STATS(1).fieldName / 1024.0;                                                               \
+  os.EndRow();
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  TextTraceOutput output(os);
+  PrintRecords(output);
+}
+
+template<class Output>
+void
+L3RateTracer::PrintRecords(Output& os) const
 {
   Time time = Simulator::Now();
 
@@ -35,6 +35,8 @@
 namespace ns3 {
 namespace ndn {
 
+class ColumnarTraceWriter;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
@@ -44,7 +46,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -56,7 +60,9 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -67,7 +73,9 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with .bin (or .bin.gz for gzip), the trace is written in
+   *             binary columnar format, see ColumnarTraceWriter
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -158,6 +166,13 @@ private:
   void
   PeriodicPrinter();
 
+  template<class Output>
+  void
+  PrintRecords(Output& os) const;
+
+  void
+  WriteSchema(ColumnarTraceWriter& writer) const;
+
   void
   Reset();
 
@@ -166,6 +181,7 @@ private:
 
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<ColumnarTraceWriter> m_writer;
   Time m_period;
   EventId m_printEvent;
 
@@ -0,0 +1,439 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-writer-thread.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceWriterThread");
+
+namespace ns3 {
+namespace ndn {
+
+const size_t TraceWriterThread::DEFAULT_BUFFER_SIZE;
+
+// records are formatted into the staging buffer and copied into the ring buffer in chunks
+static const size_t STAGING_SIZE = 64 * 1024;
+
+// the writer thread also checks ring buffers periodically, so that missed wake-ups only delay
+// writing and producers are not woken up for every chunk
+static const std::chrono::milliseconds POLL_INTERVAL(1);
+
+/**
+ * @brief State of the writer thread, shared by all streams
+ *
+ * Allocated once and never destroyed, as tracers may close their streams during destruction of
+ * static objects.
+ */
+struct WriterState {
+  std::mutex mutex;
+  std::condition_variable wakeWriter;
+  std::condition_variable drained;
+  std::list<AsyncTraceBuffer*> buffers;
+  std::thread thread;
+  bool isStopping = false;
+
+  bool isEnabled = false;
+  size_t bufferSize = TraceWriterThread::DEFAULT_BUFFER_SIZE;
+  TraceWriterThread::OverflowPolicy policy = TraceWriterThread::BLOCK_ON_OVERFLOW;
+  TraceWriterThread::Stats closedStats;
+};
+
+static WriterState&
+getWriterState()
+{
+  static WriterState* state = new WriterState;
+  return *state;
+}
+
+/**
+ * @brief Stream buffer filled by the simulation thread and drained by the writer thread
+ *
+ * The simulation thread is the only producer: it advances m_tail after copying data into the
+ * ring, the writer thread advances m_head after writing data out.  Positions grow monotonically
+ * and are mapped into the ring with m_mask.
+ */
+class AsyncTraceBuffer : public std::streambuf {
+public:
+  AsyncTraceBuffer(shared_ptr<std::ostream> os, size_t bufferSize,
+                   TraceWriterThread::OverflowPolicy policy, bool isText);
+
+  /**
+   * @brief Pass all data to the writer thread, wait until it is written and unregister
+   */
+  void
+  Close();
+
+  /**
+   * @brief Write available data to the wrapped stream, called from the writer thread
+   * @returns false if there was nothing to write
+   */
+  bool
+  Drain();
+
+  TraceWriterThread::Stats
+  GetStats() const;
+
+protected:
+  int_type
+  overflow(int_type ch) override;
+
+  int
+  sync() override;
+
+private:
+  /**
+   * @brief Copy staged data into the ring buffer
+   * @param isFinal if false, an incomplete last text record is kept in the staging buffer
+   */
+  void
+  Commit(bool isFinal);
+
+  void
+  Push(const char* data, size_t size);
+
+  bool
+  IsDrained() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+  }
+
+private:
+  shared_ptr<std::ostream> m_os;
+  TraceWriterThread::OverflowPolicy m_policy;
+  bool m_isText;
+  bool m_isClosed;
+
+  std::vector<char> m_staging;
+  std::vector<char> m_ring;
+  size_t m_mask;
+  std::atomic<uint64_t> m_head; // next position to write out, advanced by the writer thread
+  std::atomic<uint64_t> m_tail; // next position to fill, advanced by the simulation thread
+
+  std::atomic<uint64_t> m_writtenBytes;
+  uint64_t m_droppedBytes;
+  uint64_t m_droppedRecords;
+  uint64_t m_stalls;
+};
+
+static void
+runWriter()
+{
+  WriterState& state = getWriterState();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  while (true) {
+    bool hasWritten = false;
+    for (AsyncTraceBuffer* buffer : state.buffers) {
+      hasWritten = buffer->Drain() || hasWritten;
+    }
+    state.drained.notify_all();
+
+    if (!hasWritten) {
+      if (state.isStopping) {
+        break;
+      }
+      state.wakeWriter.wait_for(lock, POLL_INTERVAL);
+    }
+  }
+}
+
+AsyncTraceBuffer::AsyncTraceBuffer(shared_ptr<std::ostream> os, size_t bufferSize,
+                                   TraceWriterThread::OverflowPolicy policy, bool isText)
+  : m_os(os)
+  , m_policy(isText ? policy : TraceWriterThread::BLOCK_ON_OVERFLOW)
+  , m_isText(isText)
+  , m_isClosed(false)
+  , m_head(0)
+  , m_tail(0)
+  , m_writtenBytes(0)
+  , m_droppedBytes(0)
+  , m_droppedRecords(0)
+  , m_stalls(0)
+{
+  size_t capacity = 1;
+  while (capacity < bufferSize) {
+    capacity <<= 1;
+  }
+  m_ring.resize(capacity);
+  m_mask = capacity - 1;
+  // chunks must fit into the ring buffer, otherwise they would always be dropped
+  m_staging.resize(std::max<size_t>(std::min(STAGING_SIZE, capacity / 2), 1));
+  setp(m_staging.data(), m_staging.data() + m_staging.size());
+
+  WriterState& state = getWriterState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.buffers.empty()) {
+    if (state.thread.joinable()) {
+      state.thread.join(); // stopped after the last stream was closed
+    }
+    state.isStopping = false;
+    state.thread = std::thread(&runWriter);
+  }
+  state.buffers.push_back(this);
+}
+
+void
+AsyncTraceBuffer::Close()
+{
+  if (m_isClosed) {
+    return;
+  }
+  m_isClosed = true;
+
+  Commit(true);
+
+  WriterState& state = getWriterState();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  while (!IsDrained()) {
+    state.wakeWriter.notify_one();
+    state.drained.wait_for(lock, POLL_INTERVAL);
+  }
+  state.buffers.remove(this);
+
+  TraceWriterThread::Stats stats = GetStats();
+  state.closedStats.writtenBytes += stats.writtenBytes;
+  state.closedStats.droppedBytes += stats.droppedBytes;
+  state.closedStats.droppedRecords += stats.droppedRecords;
+  state.closedStats.stalls += stats.stalls;
+  if (m_droppedRecords > 0) {
+    NS_LOG_WARN(m_droppedRecords << " trace records were dropped because of full ring buffer");
+  }
+
+  std::thread thread;
+  if (state.buffers.empty()) {
+    state.isStopping = true;
+    state.wakeWriter.notify_one();
+    thread.swap(state.thread);
+  }
+  lock.unlock();
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+  m_os->flush();
+}
+
+bool
+AsyncTraceBuffer::Drain()
+{
+  uint64_t head = m_head.load(std::memory_order_relaxed);
+  uint64_t tail = m_tail.load(std::memory_order_acquire);
+  if (head == tail) {
+    return false;
+  }
+
+  m_writtenBytes.fetch_add(tail - head, std::memory_order_relaxed);
+  while (head != tail) {
+    size_t offset = head & m_mask;
+    size_t size = std::min<uint64_t>(tail - head, m_ring.size() - offset);
+    m_os->write(m_ring.data() + offset, size);
+    head += size;
+  }
+  m_head.store(head, std::memory_order_release);
+  return true;
+}
+
+TraceWriterThread::Stats
+AsyncTraceBuffer::GetStats() const
+{
+  TraceWriterThread::Stats stats;
+  stats.writtenBytes = m_writtenBytes.load(std::memory_order_relaxed);
+  stats.droppedBytes = m_droppedBytes;
+  stats.droppedRecords = m_droppedRecords;
+  stats.stalls = m_stalls;
+  return stats;
+}
+
+AsyncTraceBuffer::int_type
+AsyncTraceBuffer::overflow(int_type ch)
+{
+  Commit(false);
+  if (pptr() == epptr()) {
+    // single record longer than the staging buffer
+    Commit(true);
+  }
+
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int
+AsyncTraceBuffer::sync()
+{
+  Commit(false);
+  return 0;
+}
+
+void
+AsyncTraceBuffer::Commit(bool isFinal)
+{
+  char* begin = pbase();
+  size_t size = pptr() - begin;
+  size_t commitSize = size;
+  if (m_isText && !isFinal) {
+    // base() of the found position points just past the last newline, or at begin if none
+    auto lastNewline = std::find(std::reverse_iterator<char*>(pptr()),
+                                 std::reverse_iterator<char*>(begin), '\n');
+    commitSize = lastNewline.base() - begin;
+  }
+
+  if (commitSize > 0) {
+    Push(begin, commitSize);
+  }
+
+  std::memmove(begin, begin + commitSize, size - commitSize);
+  setp(begin, epptr());
+  pbump(size - commitSize);
+}
+
+void
+AsyncTraceBuffer::Push(const char* data, size_t size)
+{
+  WriterState& state = getWriterState();
+  uint64_t tail = m_tail.load(std::memory_order_relaxed);
+  uint64_t head = m_head.load(std::memory_order_acquire);
+
+  if (m_policy == TraceWriterThread::DROP_ON_OVERFLOW && m_ring.size() - (tail - head) < size) {
+    m_droppedBytes += size;
+    m_droppedRecords += std::count(data, data + size, '\n');
+    state.wakeWriter.notify_one();
+    return;
+  }
+
+  while (size > 0) {
+    size_t available = m_ring.size() - (tail - head);
+    if (available == 0) {
+      m_stalls++;
+      std::unique_lock<std::mutex> lock(state.mutex);
+      while (m_ring.size() - (tail - m_head.load(std::memory_order_acquire)) == 0) {
+        state.wakeWriter.notify_one();
+        state.drained.wait_for(lock, POLL_INTERVAL);
+      }
+      head = m_head.load(std::memory_order_acquire);
+      continue;
+    }
+
+    size_t offset = tail & m_mask;
+    size_t chunk = std::min({size, available, m_ring.size() - offset});
+    std::memcpy(m_ring.data() + offset, data, chunk);
+    data += chunk;
+    size -= chunk;
+    tail += chunk;
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+  if (tail - head > m_ring.size() / 2) {
+    state.wakeWriter.notify_one();
+  }
+}
+
+AsyncTraceStream::AsyncTraceStream(shared_ptr<std::ostream> os, size_t bufferSize,
+                                   TraceWriterThread::OverflowPolicy policy, bool isText)
+  : std::ostream(nullptr)
+  , m_buffer(new AsyncTraceBuffer(os, bufferSize, policy, isText))
+{
+  rdbuf(m_buffer.get());
+}
+
+AsyncTraceStream::~AsyncTraceStream()
+{
+  m_buffer->Close();
+}
+
+TraceWriterThread::Stats
+AsyncTraceStream::GetStats() const
+{
+  return m_buffer->GetStats();
+}
+
+void
+TraceWriterThread::Enable(size_t bufferSize, OverflowPolicy policy)
+{
+  WriterState& state = getWriterState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.isEnabled = true;
+  state.bufferSize = std::max<size_t>(bufferSize, 1);
+  state.policy = policy;
+}
+
+void
+TraceWriterThread::Disable()
+{
+  WriterState& state = getWriterState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.isEnabled = false;
+}
+
+bool
+TraceWriterThread::IsEnabled()
+{
+  WriterState& state = getWriterState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.isEnabled;
+}
+
+shared_ptr<std::ostream>
+TraceWriterThread::Wrap(shared_ptr<std::ostream> os, bool isText)
+{
+  WriterState& state = getWriterState();
+  size_t bufferSize;
+  OverflowPolicy policy;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.isEnabled) {
+      return os;
+    }
+    bufferSize = state.bufferSize;
+    policy = state.policy;
+  }
+  return make_shared<AsyncTraceStream>(os, bufferSize, policy, isText);
+}
+
+TraceWriterThread::Stats
+TraceWriterThread::GetStats()
+{
+  WriterState& state = getWriterState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  Stats stats = state.closedStats;
+  for (const AsyncTraceBuffer* buffer : state.buffers) {
+    Stats bufferStats = buffer->GetStats();
+    stats.writtenBytes += bufferStats.writtenBytes;
+    stats.droppedBytes += bufferStats.droppedBytes;
+    stats.droppedRecords += bufferStats.droppedRecords;
+    stats.stalls += bufferStats.stalls;
+  }
+  return stats;
+}
+
+} // namespace ndn
+} // namespace ns3
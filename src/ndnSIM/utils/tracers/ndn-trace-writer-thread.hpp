@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_WRITER_THREAD_H
+#define NDN_TRACE_WRITER_THREAD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iostream>
+#include <memory>
+
+namespace ns3 {
+namespace ndn {
+
+class AsyncTraceBuffer;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Background thread that writes trace files of all tracers
+ *
+ * When enabled, tracers wrap their output files with TraceWriterThread::Wrap.  Records are
+ * then formatted into a per-stream staging buffer and copied into a single-producer ring buffer,
+ * which the writer thread (one for all tracers) drains to the file, so that the simulation
+ * thread does not wait for disk I/O.
+ *
+ * If the writer cannot keep up and a ring buffer becomes full, the simulation thread either
+ * waits for free space (BLOCK_ON_OVERFLOW, the default) or drops whole records
+ * (DROP_ON_OVERFLOW, text traces only).  Both are counted, see GetStats().
+ *
+ * The writer thread must be enabled before tracers are installed:
+ *
+ *     ndn::TraceWriterThread::Enable();
+ *     ndn::L3RateTracer::InstallAll("rate-trace.txt", Seconds(1.0));
+ */
+class TraceWriterThread {
+public:
+  enum OverflowPolicy {
+    BLOCK_ON_OVERFLOW,
+    DROP_ON_OVERFLOW
+  };
+
+  struct Stats {
+    uint64_t writtenBytes = 0;   ///< @brief bytes written to the files
+    uint64_t droppedBytes = 0;   ///< @brief bytes dropped because of full ring buffers
+    uint64_t droppedRecords = 0; ///< @brief text records (lines) dropped
+    uint64_t stalls = 0;         ///< @brief times the simulation waited for a full ring buffer
+  };
+
+  static const size_t DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+  /**
+   * @brief Write trace files of subsequently installed tracers in the background
+   *
+   * @param bufferSize Size of the ring buffer of every trace file (rounded up to a power of 2)
+   * @param policy     What to do when the ring buffer is full
+   */
+  static void
+  Enable(size_t bufferSize = DEFAULT_BUFFER_SIZE, OverflowPolicy policy = BLOCK_ON_OVERFLOW);
+
+  /**
+   * @brief Write trace files of subsequently installed tracers synchronously
+   *
+   * Already wrapped streams are still written by the writer thread until they are destroyed.
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Return stream that writes into @p os from the writer thread
+   *
+   * Returns @p os if the writer thread is not enabled.  Data is passed to the writer thread
+   * when the staging buffer is full or the returned stream is flushed, and is completely
+   * written (and @p os flushed) when the returned stream is destroyed.  @p os must not be used
+   * directly while the returned stream exists.
+   *
+   * @param os     Stream to write into, e.g., std::ofstream of the trace file
+   * @param isText Whether the stream holds newline-terminated records; only text records are
+   *               dropped on overflow, binary streams always block
+   */
+  static shared_ptr<std::ostream>
+  Wrap(shared_ptr<std::ostream> os, bool isText = true);
+
+  /**
+   * @brief Get counters summed over all streams written by the writer thread so far
+   */
+  static Stats
+  GetStats();
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output stream returned by TraceWriterThread::Wrap
+ */
+class AsyncTraceStream : public std::ostream {
+public:
+  AsyncTraceStream(shared_ptr<std::ostream> os, size_t bufferSize,
+                   TraceWriterThread::OverflowPolicy policy, bool isText);
+
+  /**
+   * @brief Wait until the writer thread has written all data, then flush the wrapped stream
+   */
+  ~AsyncTraceStream();
+
+  TraceWriterThread::Stats
+  GetStats() const;
+
+private:
+  std::unique_ptr<AsyncTraceBuffer> m_buffer;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_WRITER_THREAD_H